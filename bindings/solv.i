@@ -1947,6 +1947,11 @@ returnself(matchsolvable)
   static const int POOL_FLAG_ADDFILEPROVIDESFILTERED = POOL_FLAG_ADDFILEPROVIDESFILTERED;
   static const int POOL_FLAG_NOWHATPROVIDESAUX = POOL_FLAG_NOWHATPROVIDESAUX;
   static const int POOL_FLAG_WHATPROVIDESWITHDISABLED = POOL_FLAG_WHATPROVIDESWITHDISABLED;
+  static const int POOL_FLAG_EVRCMPCACHE = POOL_FLAG_EVRCMPCACHE;
+  static const int POOL_FLAG_EVRTOKENS = POOL_FLAG_EVRTOKENS;
+  static const int POOL_FLAG_VERSIONINDEX = POOL_FLAG_VERSIONINDEX;
+  static const int POOL_FLAG_PAGECACHESIZE = POOL_FLAG_PAGECACHESIZE;
+  static const int POOL_FLAG_FORCETHREADS = POOL_FLAG_FORCETHREADS;
   static const int DISTTYPE_RPM = DISTTYPE_RPM;
   static const int DISTTYPE_DEB = DISTTYPE_DEB;
   static const int DISTTYPE_ARCH = DISTTYPE_ARCH;
@@ -2544,6 +2549,7 @@ returnself(matchsolvable)
   static const int REPO_USE_ROOTDIR = REPO_USE_ROOTDIR;
   static const int REPO_NO_LOCATION = REPO_NO_LOCATION;
   static const int SOLV_ADD_NO_STUBS = SOLV_ADD_NO_STUBS;       /* repo_solv */
+  static const int SOLV_ADD_MMAP = SOLV_ADD_MMAP;
 #ifdef ENABLE_SUSEREPO
   static const int SUSETAGS_RECORD_SHARES = SUSETAGS_RECORD_SHARES;     /* repo_susetags */
 #endif
@@ -2591,6 +2597,10 @@ returnself(matchsolvable)
     return new_XSolvable($self->pool, solvid);
   }
 
+  bool add_relprovidercache(int flags = 0) {
+    return repo_add_relprovidercache($self, flags) == 0;
+  }
+
 #ifdef ENABLE_RPMDB
   bool add_rpmdb(int flags = 0) {
     return repo_add_rpmdb($self, 0, flags) == 0;
@@ -3891,6 +3901,16 @@ returnself(matchsolvable)
   static const int SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED = SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED;
   static const int SOLVER_FLAG_STRICT_REPO_PRIORITY = SOLVER_FLAG_STRICT_REPO_PRIORITY;
   static const int SOLVER_FLAG_FOCUS_NEW = SOLVER_FLAG_FOCUS_NEW;
+  static const int SOLVER_FLAG_LOCAL_PROVIDERS = SOLVER_FLAG_LOCAL_PROVIDERS;
+  static const int SOLVER_FLAG_PROMOTE_PROVIDERS = SOLVER_FLAG_PROMOTE_PROVIDERS;
+  static const int SOLVER_FLAG_WATCH_VECTORS = SOLVER_FLAG_WATCH_VECTORS;
+  static const int SOLVER_FLAG_REDUCE_LEARNT = SOLVER_FLAG_REDUCE_LEARNT;
+  static const int SOLVER_FLAG_KEEP_LEARNT = SOLVER_FLAG_KEEP_LEARNT;
+
+  static const int SOLVER_BUDGET_TIME = SOLVER_BUDGET_TIME;
+  static const int SOLVER_BUDGET_CONFLICTS = SOLVER_BUDGET_CONFLICTS;
+  static const int SOLVER_BUDGET_DECISIONS = SOLVER_BUDGET_DECISIONS;
+  static const int SOLVER_BUDGET_PORTFOLIO = SOLVER_BUDGET_PORTFOLIO;
 
   static const int SOLVER_REASON_UNRELATED = SOLVER_REASON_UNRELATED;
   static const int SOLVER_REASON_UNIT_RULE = SOLVER_REASON_UNIT_RULE;
@@ -3919,6 +3939,24 @@ returnself(matchsolvable)
   int get_flag(int flag) {
     return solver_get_flag($self, flag);
   }
+  int set_budget(int budget, int value) {
+    return solver_set_budget($self, budget, value);
+  }
+  int get_budget(int budget) {
+    return solver_get_budget($self, budget);
+  }
+  int aborted() {
+    return solver_get_aborted($self);
+  }
+  int set_nthreads(int nthreads) {
+    return solver_set_nthreads($self, nthreads);
+  }
+  int get_nthreads() {
+    return solver_get_nthreads($self);
+  }
+  void set_portfolio(Queue strategies) {
+    solver_set_portfolio($self, &strategies);
+  }
 
   %typemap(out) Queue solve Queue2Array(Problem *, 1, new_Problem(arg1, id));
   %newobject solve;
@@ -135,10 +135,10 @@ usecachedrepo(struct repoinfo *cinfo, const char *repoext, int mark)
     }
   rewind(fp);
 
-  flags = 0;
+  flags = SOLV_ADD_MMAP;	/* share the cache file with other processes */
   if (repoext)
     {
-      flags = REPO_USE_LOADING|REPO_EXTEND_SOLVABLES;
+      flags |= REPO_USE_LOADING|REPO_EXTEND_SOLVABLES;
       if (strcmp(repoext, "DL") != 0)
         flags |= REPO_LOCALPOOL;	/* no local pool for DL so that we can compare IDs */
     }
@@ -103,6 +103,18 @@ static struct resultflags2str {
   { TESTCASE_RESULT_ORDER,		"order" },
   { TESTCASE_RESULT_ORDEREDGES,		"orderedges" },
   { TESTCASE_RESULT_PROOF,		"proof" },
+  { TESTCASE_RESULT_STATS,		"stats" },
+  { 0, 0 }
+};
+
+static struct budget2str {
+  Id budget;
+  const char *str;
+} budget2str[] = {
+  { SOLVER_BUDGET_TIME,		"time" },
+  { SOLVER_BUDGET_CONFLICTS,	"conflicts" },
+  { SOLVER_BUDGET_DECISIONS,	"decisions" },
+  { SOLVER_BUDGET_PORTFOLIO,	"portfolio" },
   { 0, 0 }
 };
 
@@ -140,6 +152,11 @@ static struct solverflags2str {
   { SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED, "onlynamespacerecommended", 0 },
   { SOLVER_FLAG_STRICT_REPO_PRIORITY,       "strictrepopriority", 0 },
   { SOLVER_FLAG_FOCUS_NEW,                  "focusnew", 0 },
+  { SOLVER_FLAG_LOCAL_PROVIDERS,            "localproviders", 0 },
+  { SOLVER_FLAG_PROMOTE_PROVIDERS,          "promoteproviders", 0 },
+  { SOLVER_FLAG_WATCH_VECTORS,              "watchvectors", 0 },
+  { SOLVER_FLAG_REDUCE_LEARNT,              "reducelearnt", 0 },
+  { SOLVER_FLAG_KEEP_LEARNT,                "keeplearnt", 0 },
   { 0, 0, 0 }
 };
 
@@ -160,6 +177,10 @@ static struct poolflags2str {
   { POOL_FLAG_ADDFILEPROVIDESFILTERED,      "addfileprovidesfiltered", 0 },
   { POOL_FLAG_NOWHATPROVIDESAUX,            "nowhatprovidesaux", 0 },
   { POOL_FLAG_WHATPROVIDESWITHDISABLED,     "whatprovideswithdisabled", 0 },
+  { POOL_FLAG_INCREMENTALWHATPROVIDES,      "incrementalwhatprovides", 0 },
+  { POOL_FLAG_EVRCMPCACHE,                  "evrcmpcache", 0 },
+  { POOL_FLAG_EVRTOKENS,                    "evrtokens", 0 },
+  { POOL_FLAG_VERSIONINDEX,                 "versionindex", 0 },
   { 0, 0, 0 }
 };
 
@@ -176,6 +197,17 @@ static struct disttype2str {
   { 0, 0 }
 };
 
+static struct evrcmpmode2str {
+  int mode;
+  const char *str;
+} evrcmpmode2str[] = {
+  { EVRCMP_COMPARE, "compare" },
+  { EVRCMP_MATCH_RELEASE, "matchrelease" },
+  { EVRCMP_MATCH, "match" },
+  { EVRCMP_COMPARE_EVONLY, "compareevonly" },
+  { 0, 0 }
+};
+
 static struct selflags2str {
   Id flag;
   const char *str;
@@ -1017,6 +1049,12 @@ testcase_getsolverflags(Solver *solv)
       if (v == solverflags2str[i].def)
 	continue;
       str = pool_tmpappend(pool, str, v ? " " : " !", solverflags2str[i].str);
+      if (v > 1)
+	{
+	  char buf[16];
+	  sprintf(buf, "=%d", v);
+	  str = pool_tmpappend(pool, str, buf, 0);
+	}
     }
   return str ? str + 1 : "";
 }
@@ -1039,19 +1077,58 @@ testcase_setsolverflags(Solver *solv, const char *str)
       if (!*p)
 	break;
       s = p;
-      while (*p && *p != ' ' && *p != '\t' && *p != ',')
+      while (*p && *p != ' ' && *p != '\t' && *p != ',' && *p != '=')
 	p++;
       for (i = 0; solverflags2str[i].str; i++)
 	if (!strncmp(solverflags2str[i].str, s, p - s) && solverflags2str[i].str[p - s] == 0)
 	  break;
       if (!solverflags2str[i].str)
 	return pool_error(solv->pool, 0, "setsolverflags: unknown flag '%.*s'", (int)(p - s), s);
+      if (*p == '=' && v)
+	{
+	  /* flags with a value, e.g. reducelearnt=100 */
+	  v = atoi(++p);
+	  while (*p && *p != ' ' && *p != '\t' && *p != ',')
+	    p++;
+	}
       if (solver_set_flag(solv, solverflags2str[i].flag, v) == -1)
         return pool_error(solv->pool, 0, "setsolverflags: unsupported flag '%s'", solverflags2str[i].str);
     }
   return 1;
 }
 
+/* parse a portfolio strategy like "focusbest,!watchvectors" */
+static int
+str2strategy(Pool *pool, const char *str, Queue *q)
+{
+  const char *p = str, *s;
+  int i, v;
+  for (;;)
+    {
+      while (*p == ',')
+	p++;
+      v = 1;
+      if (*p == '!')
+	{
+	  p++;
+	  v = 0;
+	}
+      if (!*p)
+	break;
+      s = p;
+      while (*p && *p != ',')
+	p++;
+      for (i = 0; solverflags2str[i].str; i++)
+	if (!strncmp(solverflags2str[i].str, s, p - s) && solverflags2str[i].str[p - s] == 0)
+	  break;
+      if (!solverflags2str[i].str)
+	return pool_error(pool, 0, "solverportfolio: unknown flag '%.*s'", (int)(p - s), s);
+      queue_push2(q, solverflags2str[i].flag, v);
+    }
+  queue_push(q, 0);
+  return 1;
+}
+
 void
 testcase_resetsolverflags(Solver *solv)
 {
@@ -1291,6 +1368,15 @@ testcase_solverresult(Solver *solv, int resultflags)
   Strqueue sq;
 
   strqueue_init(&sq);
+  if (solver_get_aborted(solv))
+    {
+      /* the result of an aborted solver run is meaningless, only
+       * the statistics tell how far it got */
+      for (i = 0; budget2str[i].str; i++)
+	if (budget2str[i].budget == solver_get_aborted(solv))
+	  strqueue_push(&sq, pool_tmpjoin(pool, "aborted ", budget2str[i].str, 0));
+      resultflags &= TESTCASE_RESULT_STATS;
+    }
   if ((resultflags & TESTCASE_RESULT_TRANSACTION) != 0)
     {
       Transaction *trans = solver_create_transaction(solv);
@@ -1438,6 +1524,21 @@ testcase_solverresult(Solver *solv, int resultflags)
       queue_free(&lq);
     }
 
+  if ((resultflags & TESTCASE_RESULT_STATS) != 0)
+    {
+      /* only the counts, the timings and memory sizes are not reproducible */
+      SolverStats stats;
+      char buf[256];
+
+      solver_get_stats(solv, &stats);
+      sprintf(buf, "stats runs %u decisions %u branches %u", stats.runs, stats.decisions, stats.branches);
+      strqueue_push(&sq, buf);
+      sprintf(buf, "stats conflicts %u learnt %u unsolvable %u", stats.conflicts, stats.learnt, stats.unsolvable);
+      strqueue_push(&sq, buf);
+      sprintf(buf, "stats reductions %u deleted %u", stats.reductions, stats.learntdeleted);
+      strqueue_push(&sq, buf);
+    }
+
   if ((resultflags & TESTCASE_RESULT_ORPHANED) != 0)
     {
       Queue q;
@@ -1872,6 +1973,15 @@ testcase_write_mangled(Solver *solv, const char *dir, int resultflags, const cha
       cmd = pool_tmpjoin(pool, "solverflags ", s, 0);
       strqueue_push(&sq, cmd);
     }
+  for (i = 0; budget2str[i].str; i++)
+    if (solver_get_budget(solv, budget2str[i].budget) > 0)
+      {
+	char buf[32];
+	sprintf(buf, "%d", solver_get_budget(solv, budget2str[i].budget));
+	cmd = pool_tmpjoin(pool, "solverbudget ", budget2str[i].str, " ");
+	cmd = pool_tmpappend(pool, cmd, buf, 0);
+	strqueue_push(&sq, cmd);
+      }
 
   /* now dump all the ns callback values we know */
   if (pool->nscallback)
@@ -2158,11 +2268,15 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
   int closefp = !fp;
   int poolflagsreset = 0;
   int missing_features = 0;
+  int badindex = 0;
   Id *genid = 0;
   int ngenid = 0;
   Queue autoinstq;
   int oldjobsize = job ? job->count : 0;
+  Pool *mainpool = pool;
 
+  if (pool_isfrozen(pool))
+    prepared = 1;	/* a reused solver still uses a snapshot */
   if (resultp)
     *resultp = 0;
   if (resultflagsp)
@@ -2229,7 +2343,11 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
 	}
       pieces = solv_extend(pieces, npieces, 1, sizeof(*pieces), 7);
       pieces[npieces] = 0;
-      if (!strcmp(pieces[0], "repo") && npieces >= 4)
+      if (!strcmp(pieces[0], "repo") && npieces >= 4 && pool_isfrozen(pool))
+	{
+	  pool_error(pool, 0, "testcase_read: cannot add repos to a frozen pool");
+	}
+      else if (!strcmp(pieces[0], "repo") && npieces >= 4)
 	{
 	  Repo *repo = repo_create(pool, pieces[1]);
 	  FILE *rfp;
@@ -2311,6 +2429,11 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
 	  int i;
 
 	  /* must set the disttype before the arch */
+	  if (pool_isfrozen(pool))
+	    {
+	      pool_error(pool, 0, "testcase_read: cannot change the system of a frozen pool");
+	      continue;
+	    }
 	  if (job && job->count != oldjobsize)
 	    {
 	      pool_error(pool, 0, "testcase_read: cannot change the system after jobs have been created");
@@ -2454,6 +2577,30 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
 	  for (i = 1; i < npieces; i++)
 	    testcase_setpoolflags(pool, pieces[i]);
         }
+      else if (!strcmp(pieces[0], "threads") && npieces == 2)
+	{
+	  /* split all the work that can be done by threads */
+	  pool_set_flag(pool, POOL_FLAG_FORCETHREADS, atoi(pieces[1]));
+	  if (!pool_isfrozen(pool))
+	    prepared = 0;
+	}
+      else if (!strcmp(pieces[0], "snapshot") && npieces == 1)
+	{
+	  /* freeze the pool and solve on a snapshot of it */
+	  if (pool_isfrozen(pool) || solv)
+	    {
+	      pool_error(pool, 0, "testcase_read: snapshot: %s", solv ? "the solver was already created" : "the pool is already frozen");
+	      continue;
+	    }
+	  if (prepared <= 0)
+	    {
+	      pool_addfileprovides(pool);
+	      pool_createwhatprovides(pool);
+	      prepared = 1;
+	    }
+	  pool_freeze(pool);
+	  pool = pool_create_snapshot(pool);
+	}
       else if (!strcmp(pieces[0], "solverflags") && npieces > 1)
         {
 	  int i;
@@ -2465,6 +2612,37 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
 	  for (i = 1; i < npieces; i++)
 	    testcase_setsolverflags(solv, pieces[i]);
         }
+      else if (!strcmp(pieces[0], "solverbudget") && npieces == 3)
+        {
+	  int i;
+	  if (!solv)
+	    {
+	      solv = solver_create(pool);
+	      testcase_resetsolverflags(solv);
+	    }
+	  for (i = 0; budget2str[i].str; i++)
+	    if (!strcmp(budget2str[i].str, pieces[1]))
+	      break;
+	  if (budget2str[i].str)
+	    solver_set_budget(solv, budget2str[i].budget, atoi(pieces[2]));
+	  else
+	    pool_error(pool, 0, "testcase_read: solverbudget: unknown budget '%s'", pieces[1]);
+        }
+      else if (!strcmp(pieces[0], "solverportfolio") && npieces > 1)
+        {
+	  Queue q;
+	  int i;
+	  if (!solv)
+	    {
+	      solv = solver_create(pool);
+	      testcase_resetsolverflags(solv);
+	    }
+	  queue_init(&q);
+	  for (i = 1; i < npieces; i++)
+	    str2strategy(pool, pieces[i], &q);
+	  solver_set_portfolio(solv, &q);
+	  queue_free(&q);
+        }
       else if (!strcmp(pieces[0], "result") && npieces > 1)
 	{
 	  char *result = 0;
@@ -2506,6 +2684,11 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
       else if (!strcmp(pieces[0], "disable") && npieces == 3)
 	{
 	  Id p, pp, jobsel, what = 0;
+	  if (pool_isfrozen(pool))
+	    {
+	      pool_error(pool, 0, "testcase_read: cannot disable packages of a frozen pool");
+	      continue;
+	    }
 	  if (!prepared)
 	    pool_createwhatprovides(pool);
 	  prepared = -1;
@@ -2530,6 +2713,35 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
 	  FOR_JOB_SELECT(p, pp, jobsel, what)
 	    MAPCLR(pool->considered, p);
 	}
+      else if ((!strcmp(pieces[0], "enablerepo") || !strcmp(pieces[0], "disablerepo")) && npieces == 2)
+	{
+	  Repo *repo = testcase_str2repo(pool, pieces[1]);
+	  Queue q;
+	  if (!repo)
+	    {
+	      pool_error(pool, 0, "testcase_read: %s: unknown repo '%s'", pieces[0], pieces[1]);
+	      continue;
+	    }
+	  if (pool_isfrozen(pool))
+	    {
+	      pool_error(pool, 0, "testcase_read: %s: cannot change the repos of a frozen pool", pieces[0]);
+	      continue;
+	    }
+	  if (prepared <= 0)
+	    {
+	      pool_addfileprovides(pool);
+	      pool_createwhatprovides(pool);
+	      prepared = 1;
+	    }
+	  repo->disabled = pieces[0][0] == 'd' ? 1 : 0;
+	  /* patch the index and make sure that it is still correct */
+	  queue_init(&q);
+	  queue_push2(&q, repo->start, repo->end);
+	  pool_updatewhatprovides(pool, &q);
+	  queue_free(&q);
+	  if (pool_checkwhatprovides(pool))
+	    badindex = 1;
+	}
       else if (!strcmp(pieces[0], "feature"))
 	{
 	  int i, j;
@@ -2600,11 +2812,24 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
 	    }
 	  queue_push(&autoinstq, pool_str2id(pool, pieces[2], 1));
 	}
-      else if (!strcmp(pieces[0], "evrcmp") && npieces == 3)
+      else if (!strcmp(pieces[0], "evrcmp") && (npieces == 3 || npieces == 4))
 	{
 	  Id evr1 = pool_str2id(pool, pieces[1], 1);
 	  Id evr2 = pool_str2id(pool, pieces[2], 1);
-	  int r = pool_evrcmp(pool, evr1, evr2, EVRCMP_COMPARE);
+	  int i, r, mode = EVRCMP_COMPARE;
+	  if (npieces == 4)
+	    {
+	      for (i = 0; evrcmpmode2str[i].str; i++)
+		if (!strcmp(evrcmpmode2str[i].str, pieces[3]))
+		  break;
+	      if (!evrcmpmode2str[i].str)
+		{
+		  pool_error(pool, 0, "testcase_read: evrcmp: unknown mode '%s'", pieces[3]);
+		  break;
+		}
+	      mode = evrcmpmode2str[i].mode;
+	    }
+	  r = pool_evrcmp(pool, evr1, evr2, mode);
 	  r = r < 0 ? REL_LT : r > 0 ? REL_GT : REL_EQ;
 	  queue_push2(job, SOLVER_NOOP | SOLVER_SOLVABLE_PROVIDES, pool_rel2id(pool, evr1, evr2, r, 1));
 	}
@@ -2627,6 +2852,8 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
       pool_addfileprovides(pool);
       pool_createwhatprovides(pool);
     }
+  if (pool_get_flag(pool, POOL_FLAG_FORCETHREADS) && pool_checkwhatprovides(pool))
+    badindex = 1;	/* the threads created a different index */
   if (!solv)
     {
       solv = solver_create(pool);
@@ -2641,6 +2868,16 @@ testcase_read(Pool *pool, FILE *fp, const char *testcase, Queue *job, char **res
       if (resultflagsp)
 	*resultflagsp = 77;	/* hack for testsolv */
     }
+  else if (badindex)
+    {
+      solver_free(solv);
+      solv = 0;
+    }
+  if (!solv && pool != mainpool)
+    {
+      pool_free(pool);	/* free the snapshot */
+      pool_unfreeze(mainpool);
+    }
   return solv;
 }
 
@@ -24,6 +24,7 @@
 #define TESTCASE_RESULT_ORDER		(1 << 12)
 #define TESTCASE_RESULT_ORDEREDGES	(1 << 13)
 #define TESTCASE_RESULT_PROOF		(1 << 14)
+#define TESTCASE_RESULT_STATS		(1 << 15)
 
 /* reuse solver hack, testsolv use only */
 #define TESTCASE_RESULT_REUSE_SOLVER	(1 << 31)
@@ -136,7 +136,7 @@ solv_vercmp_conda(const char *s1, const char *q1, const char *s2, const char *q2
 		return 1;
 	      r = (s1p - s1) ? strncmp(s1, s2, s1p - s1) : 0;
 	      if (r)
-		return r;
+		return r < 0 ? -1 : 1;
 	    }
 	  else if (s1 == s1p || (*s1 >= '0' && *s1 <= '9'))
 	    return 1;
@@ -162,7 +162,7 @@ solv_vercmp_conda(const char *s1, const char *q1, const char *s2, const char *q2
 	      if (r)
 	        r = strncasecmp(s1, s2, r);
 	      if (r)
-		return r;
+		return r < 0 ? -1 : 1;
               if (s1p - s1 < s2p - s2) 
                 return -1; 
               if (s1p - s1 > s2p - s2) 
@@ -229,69 +229,139 @@ pool_evrcmp_conda(const Pool *pool, const char *evr1, const char *evr2, int mode
   return pool_evrcmp_conda_int(evr1, evr1 + strlen(evr1), evr2, evr2 + strlen(evr2), 0);
 }
 
-static int
-regexmatch(const char *evr, const char *version, size_t versionlen, int icase)
-{
-  regex_t reg;
-  char *buf = solv_malloc(versionlen + 1);
-  int r;
+/*
+ * compiled version matchers
+ *
+ * A version spec gets parsed once into a tree of match nodes, the
+ * regular expressions and globs in it get compiled once. Matching a
+ * solvable then just walks the tree. The matchers of the specs used
+ * in dependencies are cached by the evr id in the pool.
+ */
 
-  memcpy(buf, version, versionlen);
-  buf[versionlen] = 0;
-  if (regcomp(&reg, buf, REG_EXTENDED | REG_NOSUB | (icase ? REG_ICASE : 0)))
-    {
-      solv_free(buf);
-      return 0;
-    }
-  r = regexec(&reg, evr, 0, NULL, 0);
-  regfree(&reg);
-  solv_free(buf);
-  return r == 0;
-}
+#define CONDA_M_NEVER		0
+#define CONDA_M_ANY		1
+#define CONDA_M_REGEX		2
+#define CONDA_M_OP		3	/* flags: REL_LT/REL_EQ/REL_GT */
+#define CONDA_M_STARTSWITH	4
+#define CONDA_M_NOTSTARTSWITH	5
+#define CONDA_M_COMPATIBLE	6
+#define CONDA_M_STRING		7
+#define CONDA_M_EMPTY		8
+#define CONDA_M_AND		9
+#define CONDA_M_OR		10
 
-static int
-globmatch(const char *evr, const char *version, size_t versionlen, int icase)
+typedef struct s_Conda_node {
+  int type;
+  int flags;
+  const char *str;
+  size_t len;
+  size_t prefixlen;	/* compatible release: length of the prefix */
+  regex_t *reg;
+  int child;		/* AND/OR: first child node */
+  int next;		/* next sibling node */
+} Conda_node;
+
+typedef struct s_Conda_matcher {
+  Id evr;		/* the evr id if cached */
+  char *spec;		/* the node strings point into this */
+  Conda_node *nodes;	/* node 0 is not used */
+  int nnodes;
+  int root;		/* 0: the spec does not match anything */
+  int build;		/* 0: no build spec */
+} Conda_matcher;
+
+#define CONDA_MATCHERCACHE_SIZE	256
+
+struct s_Conda_cache {
+  Conda_matcher *matchers[CONDA_MATCHERCACHE_SIZE];
+  Id *names;		/* (name, solvable) pairs sorted by the case folded name */
+  int nnames;
+  int namesnsolvables;	/* pool->nsolvables when the names were collected */
+};
+
+static regex_t *
+conda_regcomp(const char *pat, size_t patlen, int isglob, int icase)
 {
-  regex_t reg;
-  char *buf = solv_malloc(2 * versionlen + 3);
+  regex_t *reg = solv_calloc(1, sizeof(regex_t));
+  char *buf;
   size_t i, j;
   int r;
 
-  buf[0] = '^';
-  j = 1;
-  for (i = 0, j = 1; i < versionlen; i++)
+  if (isglob)
     {
-      if (version[i] == '.' || version[i] == '+' || version[i] == '*')
-	buf[j++] = version[i] == '*' ? '.' : '\\';
-      buf[j++] = version[i];
+      buf = solv_malloc(2 * patlen + 3);
+      buf[0] = '^';
+      for (i = 0, j = 1; i < patlen; i++)
+	{
+	  if (pat[i] == '.' || pat[i] == '+' || pat[i] == '*')
+	    buf[j++] = pat[i] == '*' ? '.' : '\\';
+	  buf[j++] = pat[i];
+	}
+      buf[j++] = '$';
+      buf[j] = 0;
     }
-  buf[j++] = '$';
-  buf[j] = 0;
-  if (regcomp(&reg, buf, REG_EXTENDED | REG_NOSUB | (icase ? REG_ICASE : 0)))
+  else
     {
-      solv_free(buf);
-      return 0;
+      buf = solv_malloc(patlen + 1);
+      memcpy(buf, pat, patlen);
+      buf[patlen] = 0;
     }
-  r = regexec(&reg, evr, 0, NULL, 0);
-  regfree(&reg);
+  r = regcomp(reg, buf, REG_EXTENDED | REG_NOSUB | (icase ? REG_ICASE : 0));
   solv_free(buf);
-  return r == 0;
+  if (r)
+    return solv_free(reg);
+  return reg;
+}
+
+static void
+conda_regfree(regex_t *reg)
+{
+  regfree(reg);
+  solv_free(reg);
+}
+
+static int
+conda_newnode(Conda_matcher *m, int type)
+{
+  m->nodes = solv_extend(m->nodes, m->nnodes, 1, sizeof(Conda_node), 15);
+  memset(m->nodes + m->nnodes, 0, sizeof(Conda_node));
+  m->nodes[m->nnodes].type = type;
+  return m->nnodes++;
+}
+
+static int
+conda_newstrnode(Conda_matcher *m, int type, const char *str, size_t len)
+{
+  int n = conda_newnode(m, type);
+  m->nodes[n].str = str;
+  m->nodes[n].len = len;
+  return n;
+}
+
+static int
+conda_newregexnode(Conda_matcher *m, const char *pat, size_t patlen, int isglob, int icase)
+{
+  regex_t *reg = conda_regcomp(pat, patlen, isglob, icase);
+  int n;
+
+  if (!reg)
+    return conda_newnode(m, CONDA_M_NEVER);
+  n = conda_newnode(m, CONDA_M_REGEX);
+  m->nodes[n].reg = reg;
+  return n;
 }
 
-/* return true if solvable s matches the version */
 /* see conda/models/version.py */
 static int
-solvable_conda_matchversion_single(Solvable *s, const char *version, size_t versionlen)
+conda_compile_version(Conda_matcher *m, const char *version, size_t versionlen)
 {
-  const char *evr;
   size_t i;
-  int r;
+  int n;
 
   if (versionlen == 0 || (versionlen == 1 && *version == '*'))
-    return 1;	/* matches every version */
-  evr = pool_id2str(s->repo->pool, s->evr);
+    return conda_newnode(m, CONDA_M_ANY);	/* matches every version */
   if (versionlen >= 2 && version[0] == '^' && version[versionlen - 1] == '$')
-    return regexmatch(evr, version, versionlen, 0);
+    return conda_newregexnode(m, version, versionlen, 0, 0);
   if (version[0] == '=' || version[0] == '<' || version[0] == '>' || version[0] == '!' || version[0] == '~')
     {
       int flags = 0;
@@ -301,24 +371,22 @@ solvable_conda_matchversion_single(Solvable *s, const char *version, size_t vers
       else if (version[0] == '!' || version[0] == '~')
 	{
 	  if (version[1] != '=')
-	    return 0;
+	    return conda_newnode(m, CONDA_M_NEVER);
 	  flags = version[0] == '!' ? REL_LT | REL_GT : 9;
 	}
-      else if (version[0] == '<' || version[0] == '>')
+      else
 	{
 	  flags = version[0] == '<' ? REL_LT : REL_GT;
 	  if (version[1] == '=')
 	    flags |= REL_EQ;
 	}
-      else
-	return 0;
       oplen = flags == 8 || flags == REL_LT || flags == REL_GT ? 1 : 2;
       if (versionlen < oplen + 1)
-	return 0;
+	return conda_newnode(m, CONDA_M_NEVER);
       version += oplen;
       versionlen -= oplen;
       if (version[0] == '=' || version[0] == '<' || version[0] == '>' || version[0] == '!' || version[0] == '~')
-	return 0;		/* bad chars after op */
+	return conda_newnode(m, CONDA_M_NEVER);		/* bad chars after op */
       if (versionlen >= 2 && version[versionlen - 2] == '.' && version[versionlen - 1] == '*')
 	{
 	  if (flags == 8 || flags == (REL_GT | REL_EQ))
@@ -329,42 +397,26 @@ solvable_conda_matchversion_single(Solvable *s, const char *version, size_t vers
 	      flags = 10;
 	    }
 	  else
-	    return 0;
+	    return conda_newnode(m, CONDA_M_NEVER);
 	}
       if (flags < 8)
 	{
-	  /* we now have an op and a version */
-	  r = pool_evrcmp_conda_int(evr, evr + strlen(evr), version, version + versionlen, 0);
-	  if (r < 0)
-	    return (flags & REL_LT) ? 1 : 0;
-	  if (r == 0)
-	    return (flags & REL_EQ) ? 1 : 0;
-	  if (r > 0)
-	    return (flags & REL_GT) ? 1 : 0;
-	  return 0;
+	  n = conda_newstrnode(m, CONDA_M_OP, version, versionlen);
+	  m->nodes[n].flags = flags;
+	  return n;
 	}
       if (flags == 8 || flags == 10)	/* startswith, not-startswith */
-	{
-	  r = pool_evrcmp_conda_int(evr, evr + strlen(evr), version, version + versionlen, 1);
-	  return flags == 8 ? r == 0 : r != 0;
-	}
-      else if (flags == 9)		/* compatible release op */
-	{
-	  r = pool_evrcmp_conda_int(evr, evr + strlen(evr), version, version + versionlen, 0);
-	  if (r < 0)
-	    return 0;
-	  /* split off last component */
-	  while (versionlen > 0 && version[versionlen - 1] != '.')
-	    versionlen--;
-	  if (versionlen < 2)
-	    return 0;
-	  versionlen--;
-	  r = pool_evrcmp_conda_int(evr, evr + strlen(evr), version, version + versionlen, 1);
-	  return r == 0 ? 1 : 0;
-	}
-      return 0;
+	return conda_newstrnode(m, flags == 8 ? CONDA_M_STARTSWITH : CONDA_M_NOTSTARTSWITH, version, versionlen);
+      /* compatible release op, split off last component */
+      for (i = versionlen; i > 0 && version[i - 1] != '.'; i--)
+	;
+      if (i < 2)
+	return conda_newnode(m, CONDA_M_NEVER);
+      n = conda_newstrnode(m, CONDA_M_COMPATIBLE, version, versionlen);
+      m->nodes[n].prefixlen = i - 1;
+      return n;
     }
-   
+
   /* do we have a '*' in the version */
   for (i = 0; i < versionlen; i++)
     if (version[i] == '*')
@@ -373,7 +425,7 @@ solvable_conda_matchversion_single(Solvable *s, const char *version, size_t vers
           if (version[i] != '*')
 	    break;
 	if (i < versionlen)
-	  return globmatch(evr, version, versionlen, 1);
+	  return conda_newregexnode(m, version, versionlen, 1, 1);
       }
 
   if (versionlen > 1 && version[versionlen - 1] == '*')
@@ -383,31 +435,43 @@ solvable_conda_matchversion_single(Solvable *s, const char *version, size_t vers
 	versionlen--;
       while (versionlen > 0 && version[versionlen - 1] == '.')
 	versionlen--;
-      r = pool_evrcmp_conda_int(evr, evr + strlen(evr), version, version + versionlen, 1);
-      return r == 0 ? 1 : 0;
+      return conda_newstrnode(m, CONDA_M_STARTSWITH, version, versionlen);
     }
   /* do we have a '@' in the version? */
   for (i = 0; i < versionlen; i++)
     if (version[i] == '@')
-      return strncmp(evr, version, versionlen) == 0 && evr[versionlen] == 0;
-  r = pool_evrcmp_conda_int(evr, evr + strlen(evr), version, version + versionlen, 0);
-  return r == 0 ? 1 : 0;
+      return conda_newstrnode(m, CONDA_M_STRING, version, versionlen);
+  n = conda_newstrnode(m, CONDA_M_OP, version, versionlen);
+  m->nodes[n].flags = REL_EQ;
+  return n;
 }
 
+static void
+conda_addchild(Conda_matcher *m, int parent, int *lastp, int child)
+{
+  if (*lastp)
+    m->nodes[*lastp].next = child;
+  else
+    m->nodes[parent].child = child;
+  *lastp = child;
+}
+
+/* returns an OR node of AND nodes or -1 on a syntax error */
 static int
-solvable_conda_matchversion_rec(Solvable *s, const char **versionp, const char *versionend)
+conda_compile_rec(Conda_matcher *m, const char **versionp, const char *versionend)
 {
   const char *version = *versionp;
-  int v, vor = 0, vand = -1;	/* -1: doing OR, 0,1: doing AND */
+  int v, or, and = 0, lastor = 0, lastand = 0;
 
   if (version == versionend)
     return -1;
+  or = conda_newnode(m, CONDA_M_OR);
   for (;;)
     {
       if (*version == '(')
 	{
 	  version++;
-	  v = solvable_conda_matchversion_rec(s, &version, versionend);
+	  v = conda_compile_rec(m, &version, versionend);
 	  if (v == -1 || version == versionend || *version != ')')
 	    return -1;
 	  version++;
@@ -419,56 +483,56 @@ solvable_conda_matchversion_rec(Solvable *s, const char **versionp, const char *
 	  const char *vstart = version;
 	  while (version < versionend && *version != '(' && *version != ')' && *version != '|' && *version != ',')
 	    version++;
-	  if (vand >= 0 ? !vand : vor)
-	    v = 0;		/* no need to call expensive matchversion if the result does not matter */
-	  else
-	    v = solvable_conda_matchversion_single(s, vstart, version - vstart) ? 1 : 0;
+	  v = conda_compile_version(m, vstart, version - vstart);
 	}
-      if (version == versionend || *version == ')')
+      if (!and)
 	{
- 	  *versionp = version;
-	  return vor | (vand >= 0 ? (vand & v) : v);
+	  and = conda_newnode(m, CONDA_M_AND);
+	  conda_addchild(m, or, &lastor, and);
+	  lastand = 0;
 	}
-      if (*version == ',')
-	vand = vand >= 0 ? (vand & v) : v;
-      else if (*version == '|')
+      conda_addchild(m, and, &lastand, v);
+      if (version == versionend || *version == ')')
 	{
-	  vor |= vand >= 0 ? (vand & v) : v;
-	  vand = -1;
+	  *versionp = version;
+	  return or;
 	}
-      else
+      if (*version == '|')
+	and = 0;
+      else if (*version != ',')
 	return -1;
       version++;
     }
 }
 
 static int
-solvable_conda_matchbuild(Solvable *s, const char *build, const char *buildend)
+conda_compile_build(Conda_matcher *m, const char *build, const char *buildend)
 {
   const char *bp;
-  const char *flavor = solvable_lookup_str(s, SOLVABLE_BUILDFLAVOR);
 
-  if (!flavor)
-    flavor = "";
   if (build == buildend)
-    return *flavor ? 0 : 1;
+    return conda_newnode(m, CONDA_M_EMPTY);
   if (build + 1 == buildend && *build == '*')
-    return 1;
+    return conda_newnode(m, CONDA_M_ANY);
   if (*build == '^' && buildend[-1] == '$')
-    return regexmatch(flavor, build, buildend - build, 0);
+    return conda_newregexnode(m, build, buildend - build, 0, 0);
   for (bp = build; bp < buildend; bp++)
     if (*bp == '*')
-      return globmatch(flavor, build, buildend - build, 0);
-  return strncmp(flavor, build, buildend - build) == 0 && flavor[buildend - build] == 0 ? 1 : 0;
+      return conda_newregexnode(m, build, buildend - build, 1, 0);
+  return conda_newstrnode(m, CONDA_M_STRING, build, buildend - build);
 }
 
-/* return true if solvable s matches the version */
 /* see conda/models/match_spec.py */
-int
-solvable_conda_matchversion(Solvable *s, const char *version)
+static Conda_matcher *
+conda_matcher_create(const char *version)
 {
+  Conda_matcher *m = solv_calloc(1, sizeof(*m));
   const char *build, *versionend;
   int r;
+
+  m->spec = solv_strdup(version);
+  conda_newnode(m, CONDA_M_NEVER);
+  version = m->spec;
   /* split off build */
   if ((build = strchr(version, ' ')) != 0)
     {
@@ -478,33 +542,294 @@ solvable_conda_matchversion(Solvable *s, const char *version)
     }
   else
     versionend = version + strlen(version);
-  r = solvable_conda_matchversion_rec(s, &version, versionend);
-  if (r != 1 || version != versionend)
+  r = conda_compile_rec(m, &version, versionend);
+  if (r <= 0 || version != versionend)
+    return m;		/* bad spec, matches nothing */
+  m->root = r;
+  if (build)
+    m->build = conda_compile_build(m, build, build + strlen(build));
+  return m;
+}
+
+static void
+conda_matcher_free(Conda_matcher *m)
+{
+  int i;
+  for (i = 1; i < m->nnodes; i++)
+    if (m->nodes[i].reg)
+      conda_regfree(m->nodes[i].reg);
+  solv_free(m->nodes);
+  solv_free(m->spec);
+  solv_free(m);
+}
+
+static int
+conda_node_match(Conda_matcher *m, int n, const char *str, size_t strl)
+{
+  Conda_node *node = m->nodes + n;
+  int c, r;
+
+  switch (node->type)
+    {
+    case CONDA_M_ANY:
+      return 1;
+    case CONDA_M_EMPTY:
+      return *str ? 0 : 1;
+    case CONDA_M_REGEX:
+      return regexec(node->reg, str, 0, NULL, 0) == 0;
+    case CONDA_M_STRING:
+      return strncmp(str, node->str, node->len) == 0 && str[node->len] == 0;
+    case CONDA_M_OP:
+      r = pool_evrcmp_conda_int(str, str + strl, node->str, node->str + node->len, 0);
+      if (r < 0)
+	return (node->flags & REL_LT) ? 1 : 0;
+      if (r == 0)
+	return (node->flags & REL_EQ) ? 1 : 0;
+      return (node->flags & REL_GT) ? 1 : 0;
+    case CONDA_M_STARTSWITH:
+      return pool_evrcmp_conda_int(str, str + strl, node->str, node->str + node->len, 1) == 0;
+    case CONDA_M_NOTSTARTSWITH:
+      return pool_evrcmp_conda_int(str, str + strl, node->str, node->str + node->len, 1) != 0;
+    case CONDA_M_COMPATIBLE:
+      if (pool_evrcmp_conda_int(str, str + strl, node->str, node->str + node->len, 0) < 0)
+	return 0;
+      return pool_evrcmp_conda_int(str, str + strl, node->str, node->str + node->prefixlen, 1) == 0;
+    case CONDA_M_AND:
+      for (c = node->child; c; c = m->nodes[c].next)
+	if (!conda_node_match(m, c, str, strl))
+	  return 0;
+      return 1;
+    case CONDA_M_OR:
+      for (c = node->child; c; c = m->nodes[c].next)
+	if (conda_node_match(m, c, str, strl))
+	  return 1;
+      return 0;
+    default:
+      return 0;
+    }
+}
+
+static int
+conda_matcher_match(Conda_matcher *m, Solvable *s)
+{
+  const char *str;
+
+  if (!m->root)
     return 0;
-  if (build && !solvable_conda_matchbuild(s, build, build + strlen(build)))
+  str = pool_id2str(s->repo->pool, s->evr);
+  if (!conda_node_match(m, m->root, str, strlen(str)))
     return 0;
+  if (m->build)
+    {
+      str = solvable_lookup_str(s, SOLVABLE_BUILDFLAVOR);
+      if (!str)
+	str = "";
+      return conda_node_match(m, m->build, str, strlen(str));
+    }
+  return 1;
+}
+
+/* return true if solvable s matches the version */
+int
+solvable_conda_matchversion(Solvable *s, const char *version)
+{
+  Conda_matcher *m = conda_matcher_create(version);
+  int r = conda_matcher_match(m, s);
+  conda_matcher_free(m);
   return r;
 }
 
+/* the cache of a frozen pool is not used, as it may be shared by
+ * many threads. Snapshots have their own cache. */
+static struct s_Conda_cache *
+pool_conda_getcache(Pool *pool)
+{
+  if (pool->frozen && !pool->snapshotof)
+    return 0;
+  if (!pool->condacache)
+    pool->condacache = solv_calloc(1, sizeof(struct s_Conda_cache));
+  return pool->condacache;
+}
+
+/* get the matcher for an evr id. The matcher must be released with
+ * conda_matcher_release */
+static Conda_matcher *
+pool_conda_getmatcher(Pool *pool, Id evr)
+{
+  struct s_Conda_cache *cache = pool_conda_getcache(pool);
+  Conda_matcher *m;
+  int h = evr & (CONDA_MATCHERCACHE_SIZE - 1);
+
+  if (cache && (m = cache->matchers[h]) != 0 && m->evr == evr)
+    return m;
+  m = conda_matcher_create(pool_id2str(pool, evr));
+  if (cache)
+    {
+      if (cache->matchers[h])
+	conda_matcher_free(cache->matchers[h]);
+      cache->matchers[h] = m;
+      m->evr = evr;
+    }
+  return m;
+}
+
+static inline void
+conda_matcher_release(Conda_matcher *m)
+{
+  if (!m->evr)
+    conda_matcher_free(m);
+}
+
+/*
+ * name index
+ *
+ * Glob and regex package names used to need a regex match of the
+ * names of all the solvables in the pool. We keep the names sorted
+ * case insensitive, so that only the names starting with the literal
+ * prefix of the pattern need to be matched.
+ */
+
+static int
+conda_names_sortcmp(const void *ap, const void *bp, void *dp)
+{
+  Pool *pool = dp;
+  const Id *a = ap, *b = bp;
+  int r;
+
+  if (a[0] != b[0])
+    {
+      r = strcasecmp(pool_id2str(pool, a[0]), pool_id2str(pool, b[0]));
+      if (r)
+	return r;
+      return a[0] - b[0];
+    }
+  return a[1] - b[1];
+}
+
+static void
+conda_names_build(Pool *pool, struct s_Conda_cache *cache)
+{
+  Id p, *np;
+  int n = 0;
+
+  solv_free(cache->names);
+  FOR_POOL_SOLVABLES(p)
+    n++;
+  cache->names = np = solv_calloc(2 * n + 1, sizeof(Id));
+  FOR_POOL_SOLVABLES(p)
+    {
+      *np++ = pool->solvables[p].name;
+      *np++ = p;
+    }
+  solv_sort(cache->names, n, 2 * sizeof(Id), conda_names_sortcmp, pool);
+  cache->nnames = n;
+  cache->namesnsolvables = pool->nsolvables;
+}
+
+/* return the length of the literal prefix of a name glob/regex. A
+ * char followed by a quantifier is not part of the prefix. */
+static size_t
+conda_names_prefix(const char *pat, int isglob)
+{
+  const char *meta = isglob ? "*?[](){}|\\^$" : "*?[](){}|\\^$.+";
+  size_t l;
+
+  if (strchr(pat, '|'))
+    return 0;		/* alternatives */
+  for (l = 0; pat[l] && !strchr(meta, pat[l]); l++)
+    ;
+  if (l && (pat[l] == '?' || pat[l] == '{' || (!isglob && (pat[l] == '*' || pat[l] == '+'))))
+    l--;
+  return l;
+}
+
+static int
+conda_names_idcmp(const void *ap, const void *bp, void *dp)
+{
+  return *(const Id *)ap - *(const Id *)bp;
+}
+
 static Id
 pool_addrelproviders_conda_slow(Pool *pool, const char *namestr, Id evr, Queue *plist, int mode)
 {
-  size_t namestrlen = strlen(namestr);
-  const char *evrstr = evr == 0 || evr == 1 ? 0 : pool_id2str(pool, evr);
-  Id p;
+  struct s_Conda_cache *cache = pool_conda_getcache(pool);
+  Conda_matcher *m = evr == 0 || evr == 1 ? 0 : pool_conda_getmatcher(pool, evr);
+  regex_t *reg = 0;
+  const char *prefix = 0;
+  size_t prefixlen = 0;
+  Solvable *s;
+  Id p, *np, *npe;
+  int lo, hi, mid;
 
-  FOR_POOL_SOLVABLES(p)
+  if (mode)
+    {
+      reg = conda_regcomp(namestr, strlen(namestr), mode == 1, 1);
+      if (!reg)
+	{
+	  if (m)
+	    conda_matcher_release(m);
+	  return 0;
+	}
+    }
+  if (!mode || !cache)
+    {
+      FOR_POOL_SOLVABLES(p)
+	{
+	  s = pool->solvables + p;
+	  if (!pool_installable(pool, s))
+	    continue;
+	  if (reg && regexec(reg, pool_id2str(pool, s->name), 0, NULL, 0) != 0)
+	    continue;
+	  if (!m || conda_matcher_match(m, s))
+	    queue_push(plist, p);
+	}
+    }
+  else
     {
-      Solvable *s = pool->solvables + p;
-      if (!pool_installable(pool, s))
-	continue;
-      if (mode == 1 && !globmatch(pool_id2str(pool, s->name), namestr, namestrlen, 1))
-	continue;
-      if (mode == 2 && !regexmatch(pool_id2str(pool, s->name), namestr, namestrlen, 1))
-	continue;
-      if (!evrstr || solvable_conda_matchversion(s, evrstr))
-	queue_push(plist, p);
+      if (!cache->names || cache->namesnsolvables != pool->nsolvables)
+	conda_names_build(pool, cache);
+      prefix = mode == 2 ? namestr + 1 : namestr;
+      prefixlen = conda_names_prefix(prefix, mode == 1);
+      lo = 0;
+      hi = cache->nnames;
+      while (prefixlen && lo < hi)
+	{
+	  mid = (lo + hi) / 2;
+	  if (strncasecmp(pool_id2str(pool, cache->names[2 * mid]), prefix, prefixlen) < 0)
+	    lo = mid + 1;
+	  else
+	    hi = mid;
+	}
+      np = cache->names + 2 * lo;
+      npe = cache->names + 2 * cache->nnames;
+      while (np < npe)
+	{
+	  Id name = np[0];
+	  const char *str = pool_id2str(pool, name);
+	  if (prefixlen && strncasecmp(str, prefix, prefixlen) != 0)
+	    break;
+	  if (regexec(reg, str, 0, NULL, 0) != 0)
+	    {
+	      while (np < npe && np[0] == name)
+		np += 2;
+	      continue;
+	    }
+	  for (; np < npe && np[0] == name; np += 2)
+	    {
+	      s = pool->solvables + np[1];
+	      if (!s->repo || !pool_installable(pool, s))
+		continue;
+	      if (!m || conda_matcher_match(m, s))
+		queue_push(plist, np[1]);
+	    }
+	}
+      if (plist->count > 1)
+	solv_sort(plist->elements, plist->count, sizeof(Id), conda_names_idcmp, 0);
     }
+  if (reg)
+    conda_regfree(reg);
+  if (m)
+    conda_matcher_release(m);
   return 0;
 }
 
@@ -549,19 +874,46 @@ pool_addrelproviders_conda(Pool *pool, Id name, Id evr, Queue *plist)
     wp = pool_whatprovides(pool, name);
   if (wp && evr && evr != 1)
     {
-      const char *evrstr = pool_id2str(pool, evr);
+      Conda_matcher *m = pool_conda_getmatcher(pool, evr);
       pp = pool->whatprovidesdata + wp;
       while ((p = *pp++) != 0)
 	{
-	  if (solvable_conda_matchversion(pool->solvables + p, evrstr))
+	  if (conda_matcher_match(m, pool->solvables + p))
 	    queue_push(plist, p);
 	  else
-	    wp = 0; 
+	    wp = 0;
 	}
+      conda_matcher_release(m);
     }
   return wp;
 }
 
+void
+pool_conda_flushnames(Pool *pool)
+{
+  struct s_Conda_cache *cache = pool->condacache;
+  if (cache)
+    {
+      cache->names = solv_free(cache->names);
+      cache->nnames = 0;
+    }
+}
+
+void
+pool_conda_freecache(Pool *pool)
+{
+  struct s_Conda_cache *cache = pool->condacache;
+  int i;
+
+  if (!cache)
+    return;
+  for (i = 0; i < CONDA_MATCHERCACHE_SIZE; i++)
+    if (cache->matchers[i])
+      conda_matcher_free(cache->matchers[i]);
+  solv_free(cache->names);
+  pool->condacache = solv_free(cache);
+}
+
 /* create a CONDA_REL relation from a matchspec */
 Id
 pool_conda_matchspec(Pool *pool, const char *name)
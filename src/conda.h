@@ -24,6 +24,8 @@ int pool_evrcmp_conda(const Pool *pool, const char *evr1, const char *evr2, int
 int solvable_conda_matchversion(Solvable *s, const char *version);
 Id pool_addrelproviders_conda(Pool *pool, Id name, Id evr, Queue *plist);
 Id pool_conda_matchspec(Pool *pool, const char *name);
+void pool_conda_flushnames(Pool *pool);	/* internal */
+void pool_conda_freecache(Pool *pool);	/* internal */
 
 #ifdef __cplusplus
 }
@@ -16,6 +16,8 @@
 #include <string.h>
 #include "evr.h"
 #include "pool.h"
+#include "hash.h"
+#include "util.h"
 
 #ifdef ENABLE_CONDA
 #include "conda.h"
@@ -475,12 +477,375 @@ pool_evrcmp_str(const Pool *pool, const char *evr1, const char *evr2, int mode)
   return r;
 }
 
+/*
+ * tokenized evr compare
+ *
+ * With POOL_FLAG_EVRTOKENS, the evr strings are split into the segments
+ * that solv_vercmp_rpm looks at once per evr Id. A segment is encoded in
+ * one word, the upper three bits contain the segment type. Numeric
+ * segments store the value, alpha segments are packed with six bits
+ * per character in the ascii order. Longer alpha segments are split
+ * into multiple words, all but the last one are of type ALPHACONT.
+ * Segments that do not fit (numbers with more than 8 digits) make the
+ * evr untokenizable, we then fall back to the string compare.
+ *
+ * The tokens of an evr start with a header of three words: the flags
+ * and the offsets of the version and release tokens. The epoch tokens
+ * directly follow the header. Every token list is terminated by an
+ * END token.
+ */
+
+#define EVRTOKEN_END		(0U << 29)
+#define EVRTOKEN_TILDE		(1U << 29)
+#define EVRTOKEN_CARET		(2U << 29)
+#define EVRTOKEN_NUM		(3U << 29)
+#define EVRTOKEN_ALPHA		(4U << 29)
+#define EVRTOKEN_ALPHACONT	(5U << 29)
+#define EVRTOKEN_TYPE		(7U << 29)
+
+#define EVRTOKENS_EPOCH		(1 << 0)
+#define EVRTOKENS_EPOCHZERO	(1 << 1)
+#define EVRTOKENS_EMPTYEPOCH	(1 << 2)
+#define EVRTOKENS_EMPTYVERSION	(1 << 3)
+#define EVRTOKENS_RELEASE	(1 << 4)
+#define EVRTOKENS_EMPTYRELEASE	(1 << 5)
+
+#define EVRTOKENS_BLOCK		4095
+
+/* the tokens are only valid for solv_vercmp_rpm without distepoch */
+static inline int
+pool_evrtokens_usable(const Pool *pool)
+{
+#if defined(DEBIAN) || defined(ARCHLINUX) || defined(HAIKU)
+  return 0;
+#else
+  if (pool->havedistepoch)
+    return 0;
+  return pool->disttype == DISTTYPE_RPM || pool->disttype == DISTTYPE_ARCH;
+#endif
+}
+
+static inline void
+evrtokens_push(Pool *pool, unsigned int tok)
+{
+  pool->evrtokendata = solv_extend(pool->evrtokendata, pool->evrtokendataoff, 1, sizeof(unsigned int), EVRTOKENS_BLOCK);
+  pool->evrtokendata[pool->evrtokendataoff++] = tok;
+}
+
+static inline unsigned int
+evrtokens_packalpha(const char *s, int l)
+{
+  unsigned int x = 0;
+  int i;
+  for (i = 0; i < 4; i++)
+    x = x << 6 | (i >= l ? 0 : s[i] >= 'a' ? s[i] - 'a' + 27 : s[i] - 'A' + 1);
+  return x;
+}
+
+/* tokenize the segments of s..q, q must not point to an alphanumeric char */
+static int
+evrtokens_add(Pool *pool, const char *s, const char *q)
+{
+  const char *e;
+  unsigned int x;
+
+  while (s < q)
+    {
+      if (*s == '~' || *s == '^')
+	{
+	  evrtokens_push(pool, *s++ == '~' ? EVRTOKEN_TILDE : EVRTOKEN_CARET);
+	  continue;
+	}
+      if (*s >= '0' && *s <= '9')
+	{
+	  while (*s == '0' && s[1] >= '0' && s[1] <= '9')
+	    s++;
+	  for (e = s, x = 0; *e >= '0' && *e <= '9'; e++)
+	    x = x * 10 + (*e - '0');
+	  if (e - s > 8)
+	    return 0;
+	  evrtokens_push(pool, EVRTOKEN_NUM | x);
+	  s = e;
+	  continue;
+	}
+      if ((*s >= 'a' && *s <= 'z') || (*s >= 'A' && *s <= 'Z'))
+	{
+	  for (e = s; (*e >= 'a' && *e <= 'z') || (*e >= 'A' && *e <= 'Z'); )
+	    e++;
+	  for (; e - s > 4; s += 4)
+	    evrtokens_push(pool, EVRTOKEN_ALPHACONT | evrtokens_packalpha(s, 4));
+	  evrtokens_push(pool, EVRTOKEN_ALPHA | evrtokens_packalpha(s, e - s));
+	  s = e;
+	  continue;
+	}
+      s++;	/* separator */
+    }
+  evrtokens_push(pool, EVRTOKEN_END);
+  return 1;
+}
+
+/* split the evr like pool_evrcmp_str does and tokenize the parts */
+static Offset
+evrtokens_create(Pool *pool, const char *evr)
+{
+  Offset off = pool->evrtokendataoff;
+  const char *s, *v, *r, *e;
+  unsigned int flags = 0;
+
+  for (s = evr; *s >= '0' && *s <= '9'; s++)
+    ;
+  v = evr;
+  if (s != evr && *s == ':')
+    {
+      flags |= EVRTOKENS_EPOCH;
+      for (v = evr; *v == '0'; v++)
+	;
+      if (v == s)
+	flags |= EVRTOKENS_EPOCHZERO;
+      v = s + 1;
+    }
+  else if (*evr == ':')
+    {
+      flags |= EVRTOKENS_EMPTYEPOCH;
+      v = evr + 1;
+    }
+  for (e = v, r = 0; *e; e++)
+    if (*e == '-')
+      r = e;
+  if (v == (r ? r : e))
+    flags |= EVRTOKENS_EMPTYVERSION;
+  if (r)
+    flags |= r + 1 == e ? EVRTOKENS_RELEASE | EVRTOKENS_EMPTYRELEASE : EVRTOKENS_RELEASE;
+  evrtokens_push(pool, flags);
+  evrtokens_push(pool, 0);
+  evrtokens_push(pool, 0);
+  if ((flags & EVRTOKENS_EPOCH) && !evrtokens_add(pool, evr, s))
+    {
+      pool->evrtokendataoff = off;
+      return 1;
+    }
+  pool->evrtokendata[off + 1] = pool->evrtokendataoff - off;
+  if (!evrtokens_add(pool, v, r ? r : e))
+    {
+      pool->evrtokendataoff = off;
+      return 1;
+    }
+  pool->evrtokendata[off + 2] = pool->evrtokendataoff - off;
+  if (!evrtokens_add(pool, r ? r + 1 : e, e))
+    {
+      pool->evrtokendataoff = off;
+      return 1;
+    }
+  return off;
+}
+
+/* return the tokens of an evr id, 0 if it can't be tokenized */
+static const unsigned int *
+pool_evrtokens(Pool *pool, Id evr)
+{
+  Offset off;
+
+  if (evr < pool->nevrtokens && pool->evrtokens[evr])
+    off = pool->evrtokens[evr];
+  else
+    {
+      if (pool->frozen || evr <= 0 || evr >= pool->ss.nstrings)
+	return 0;		/* the data of a frozen pool is read-only */
+      if (evr >= pool->nevrtokens)
+	{
+	  pool->evrtokens = solv_realloc2(pool->evrtokens, pool->ss.nstrings, sizeof(Offset));
+	  memset(pool->evrtokens + pool->nevrtokens, 0, (pool->ss.nstrings - pool->nevrtokens) * sizeof(Offset));
+	  pool->nevrtokens = pool->ss.nstrings;
+	}
+      if (!pool->evrtokendata)
+	{
+	  /* 0: not tokenized yet, 1: not tokenizable */
+	  pool->evrtokendata = solv_extend_resize(0, 2, sizeof(unsigned int), EVRTOKENS_BLOCK);
+	  pool->evrtokendataoff = 2;
+	}
+      off = pool->evrtokens[evr] = evrtokens_create(pool, pool_id2str(pool, evr));
+    }
+  return off == 1 ? 0 : pool->evrtokendata + off;
+}
+
+/* like solv_vercmp_rpm, but for two token lists */
+static int
+evrtokens_cmp(const unsigned int *t1, const unsigned int *t2)
+{
+  unsigned int a, b, ta, tb;
+
+  for (;; t1++, t2++)
+    {
+      a = *t1;
+      b = *t2;
+      ta = a & EVRTOKEN_TYPE;
+      tb = b & EVRTOKEN_TYPE;
+      if (ta == EVRTOKEN_TILDE)
+	{
+	  if (tb == EVRTOKEN_TILDE)
+	    continue;
+	  return -1;
+	}
+      if (tb == EVRTOKEN_TILDE)
+	return 1;
+      if (ta == EVRTOKEN_CARET)
+	{
+	  if (tb == EVRTOKEN_CARET)
+	    continue;
+	  return tb != EVRTOKEN_END ? -1 : 1;
+	}
+      if (tb == EVRTOKEN_CARET)
+	return ta != EVRTOKEN_END ? 1 : -1;
+      if (ta == EVRTOKEN_END || tb == EVRTOKEN_END)
+	return ta != EVRTOKEN_END ? 1 : tb != EVRTOKEN_END ? -1 : 0;
+      if (ta == EVRTOKEN_NUM || tb == EVRTOKEN_NUM)
+	{
+	  /* numeric segments are newer than alpha segments */
+	  if (ta != tb)
+	    return ta == EVRTOKEN_NUM ? 1 : -1;
+	  if (a != b)
+	    return a > b ? 1 : -1;
+	  continue;
+	}
+      /* two alpha segments, compare the packed characters */
+      for (;; t1++, t2++)
+	{
+	  a = *t1;
+	  b = *t2;
+	  if ((a & ~EVRTOKEN_TYPE) != (b & ~EVRTOKEN_TYPE))
+	    return (a & ~EVRTOKEN_TYPE) > (b & ~EVRTOKEN_TYPE) ? 1 : -1;
+	  ta = a & EVRTOKEN_TYPE;
+	  tb = b & EVRTOKEN_TYPE;
+	  if (ta != tb)
+	    return ta == EVRTOKEN_ALPHACONT ? 1 : -1;
+	  if (ta == EVRTOKEN_ALPHA)
+	    break;
+	}
+    }
+}
+
+/* same as pool_evrcmp_str, but with the tokens of the evrs */
+static int
+pool_evrcmp_tokens(const Pool *pool, const unsigned int *t1, const unsigned int *t2, int mode)
+{
+  unsigned int f1 = t1[0], f2 = t2[0];
+  int r;
+
+  if (mode != EVRCMP_MATCH || !((f1 | f2) & EVRTOKENS_EMPTYEPOCH))
+    {
+      if (f1 & f2 & EVRTOKENS_EPOCH)
+	{
+	  r = evrtokens_cmp(t1 + 3, t2 + 3);
+	  if (r)
+	    return r;
+	}
+      else if ((f1 & EVRTOKENS_EPOCH) && !pool->promoteepoch && !(f1 & EVRTOKENS_EPOCHZERO))
+	return 1;
+      else if ((f2 & EVRTOKENS_EPOCH) && !(f2 & EVRTOKENS_EPOCHZERO))
+	return -1;
+    }
+  r = 0;
+  if (mode != EVRCMP_MATCH || !((f1 | f2) & EVRTOKENS_EMPTYVERSION))
+    r = evrtokens_cmp(t1 + t1[1], t2 + t2[1]);
+  if (r)
+    return r;
+  if (mode == EVRCMP_COMPARE)
+    {
+      if (!(f1 & EVRTOKENS_RELEASE) && (f2 & EVRTOKENS_RELEASE))
+	return -1;
+      if ((f1 & EVRTOKENS_RELEASE) && !(f2 & EVRTOKENS_RELEASE))
+	return 1;
+    }
+  if (mode == EVRCMP_COMPARE_EVONLY)
+    return 0;
+  if (mode == EVRCMP_MATCH_RELEASE)
+    {
+      /* rpm treats empty releases as missing */
+      if (f1 & EVRTOKENS_EMPTYRELEASE)
+	f1 &= ~EVRTOKENS_RELEASE;
+      if (f2 & EVRTOKENS_EMPTYRELEASE)
+	f2 &= ~EVRTOKENS_RELEASE;
+    }
+  if (f1 & f2 & EVRTOKENS_RELEASE)
+    {
+      if (mode != EVRCMP_MATCH || !((f1 | f2) & EVRTOKENS_EMPTYRELEASE))
+	r = evrtokens_cmp(t1 + t1[2], t2 + t2[2]);
+    }
+  else if (mode == EVRCMP_MATCH_RELEASE)
+    {
+      if (!(f1 & EVRTOKENS_RELEASE) && (f2 & EVRTOKENS_RELEASE))
+	return -2;
+      if ((f1 & EVRTOKENS_RELEASE) && !(f2 & EVRTOKENS_RELEASE))
+	return 2;
+    }
+  return r;
+}
+
+/* tokenize the evrs of all solvables and dependencies, used when
+ * the pool gets frozen */
+void
+pool_tokenize_evrs(Pool *pool)
+{
+  Id p, d;
+
+  if (!pool->evrtokenize || pool->frozen)
+    return;
+  for (p = 2; p < pool->nsolvables; p++)
+    if (pool->solvables[p].repo && !ISRELDEP(pool->solvables[p].evr))
+      pool_evrtokens(pool, pool->solvables[p].evr);
+  for (d = 1; d < pool->nrels; d++)
+    if (pool->rels[d].flags > 0 && pool->rels[d].flags < 8 && !ISRELDEP(pool->rels[d].evr))
+      pool_evrtokens(pool, pool->rels[d].evr);
+}
+
+static int
+pool_evrcmp_id(Pool *pool, Id evr1id, Id evr2id, int mode)
+{
+  if (pool->evrtokenize && pool_evrtokens_usable(pool))
+    {
+      const unsigned int *t1, *t2;
+      if (pool_evrtokens(pool, evr1id) && (t2 = pool_evrtokens(pool, evr2id)) != 0)
+	{
+	  t1 = pool_evrtokens(pool, evr1id);	/* the data may have moved */
+	  return pool_evrcmp_tokens(pool, t1, t2, mode);
+	}
+    }
+  return pool_evrcmp_str(pool, pool_id2str(pool, evr1id), pool_id2str(pool, evr2id), mode);
+}
+
+/* direct mapped cache of the comparison results, enabled with
+ * POOL_FLAG_EVRCMPCACHE. Not used for frozen pools, as they may
+ * be shared by multiple threads. Snapshots have their own cache. */
+static int
+pool_evrcmp_cached(Pool *pool, Id evr1id, Id evr2id, int mode)
+{
+  Id *ent = pool->evrcmpcache + 4 * (relhash(evr1id, evr2id, mode) & (POOL_EVRCMPCACHE_SIZE - 1));
+  int r;
+
+  if (ent[0] == evr1id && ent[1] == evr2id && ent[2] == mode)
+    {
+      pool->evrcmpcachehits++;
+      return ent[3];
+    }
+  pool->evrcmpcachemisses++;
+  r = pool_evrcmp_id(pool, evr1id, evr2id, mode);
+  ent[0] = evr1id;
+  ent[1] = evr2id;
+  ent[2] = mode;
+  ent[3] = r;
+  return r;
+}
+
 int
 pool_evrcmp(const Pool *pool, Id evr1id, Id evr2id, int mode)
 {
   const char *evr1, *evr2;
   if (evr1id == evr2id)
     return 0;
+  if (pool->evrcmpcache && (!pool->frozen || pool->snapshotof))
+    return pool_evrcmp_cached((Pool *)pool, evr1id, evr2id, mode);
+  if (pool->evrtokenize)
+    return pool_evrcmp_id((Pool *)pool, evr1id, evr2id, mode);
   evr1 = pool_id2str(pool, evr1id);
   evr2 = pool_id2str(pool, evr2id);
   return pool_evrcmp_str(pool, evr1, evr2, mode);
@@ -286,6 +286,7 @@ repodata_addfileprovides_search(Repodata *data, struct addfileprovides_cbdata *c
     }
   repodata_free_dircache(data);		/* repodata_str2dir created it */
 
+  repopagestore_readahead(&data->store, REPOPAGE_READAHEAD);	/* we walk the file lists in order */
   for (p = start; p < end; p++)
     {
       const unsigned char *dp;
@@ -13,6 +13,7 @@
 #ifndef LIBSOLV_HASH_H
 #define LIBSOLV_HASH_H
 
+#include <string.h>
 #include "pooltypes.h"
 
 #ifdef __cplusplus
@@ -61,14 +62,64 @@ strhash_cont(const char *str, Hashval r)
   return r;
 }
 
+/* word at a time hash function
+ * string -> hash
+ * hashes exactly len bytes, 8 bytes per step. Unlike strnhash it does
+ * not stop at a zero byte, and the result can not be continued with
+ * strhash_cont.
+ */
+#define STRHASH_WORDS_MUL	0x9e3779b97f4a7c15ULL
+
+static inline Hashval
+strnhash_words(const char *str, unsigned int len)
+{
+  unsigned long long r = 0, v = 0;
+  unsigned int n = len, a, b;
+
+  if (len > 8)
+    {
+      while (len > 8)
+	{
+	  memcpy(&v, str, 8);
+	  r = (r ^ v) * STRHASH_WORDS_MUL;
+	  r ^= r >> 32;
+	  str += 8;
+	  len -= 8;
+	}
+      memcpy(&v, str + len - 8, 8);	/* last word, may overlap */
+    }
+  else if (len >= 4)
+    {
+      memcpy(&a, str, 4);
+      memcpy(&b, str + len - 4, 4);
+      v = (unsigned long long)a << 32 | b;
+    }
+  else if (len)
+    v = (unsigned char)str[0] << 16 | (unsigned char)str[len >> 1] << 8 | (unsigned char)str[len - 1];
+  /* mix in the last word and the length, then finalize */
+  r = (r ^ v ^ ((unsigned long long)n << 56)) * STRHASH_WORDS_MUL;
+  r ^= r >> 32;
+  r *= 0xd6e8feb86659fd93ULL;
+  r ^= r >> 32;
+  return (Hashval)r;
+}
+
+static inline Hashval
+strhash_words(const char *str)
+{
+  return strnhash_words(str, (unsigned int)strlen(str));
+}
+
 
 /* hash for rel
  * rel -> hash
+ * the ids are small and clustered, so mix them over all bits
  */
 static inline Hashval
 relhash(Id name, Id evr, int flags)
 {
-  return name + 7 * evr + 13 * flags;
+  Hashval h = (Hashval)name * 0x9e3779b1U + (Hashval)evr * 0x85ebca6bU + (Hashval)flags * 0xc2b2ae35U;
+  return h ^ (h >> 16);
 }
 
 
@@ -275,6 +275,10 @@ KNOWNID(SOLVABLE_MULTIARCH,		"solvable:multiarch"),		/* debian multi-arch field
 KNOWNID(SOLVABLE_SIGNATUREDATA,		"solvable:signaturedata"),	/* conda */
 KNOWNID(SOLVABLE_ORDERWITHREQUIRES,	"solvable:orderwithrequires"),	/* rpm */
 
+KNOWNID(REPOSITORY_RELPROVIDERS,	"repository:relproviders"),	/* versioned dependencies with stored providers */
+KNOWNID(REPOSITORY_RELPROVIDERS_DATA,	"repository:relproviders:data"),	/* the provider lists */
+KNOWNID(REPOSITORY_RELPROVIDERS_CHECKSUM,	"repository:relproviders:checksum"),	/* checksum of the pool the lists were created with */
+
 KNOWNID(ID_NUM_INTERNAL,		0)
 
 #ifdef KNOWNID_INITIALIZE
@@ -30,6 +30,9 @@
 #ifdef ENABLE_CONDA
 #include "conda.h"
 #endif
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+#endif
 
 #define SOLVABLE_BLOCK	255
 
@@ -62,6 +65,7 @@ pool_create(void)
   queue_init(&pool->vendormap);
   queue_init(&pool->pooljobs);
   queue_init(&pool->lazywhatprovidesq);
+  queue_init(&pool->whatprovidesoverlayq);
 
 #if defined(DEBIAN)
   pool->disttype = DISTTYPE_DEB;
@@ -99,12 +103,39 @@ pool_create(void)
 }
 
 
+/* free a pool snapshot, only the private data gets freed */
+static void
+pool_free_snapshot(Pool *pool)
+{
+  int i;
+
+  if (pool->whatprovidesdata != pool->snapshotof->whatprovidesdata)
+    solv_free(pool->whatprovidesdata);
+  solv_free(pool->whatprovides_rel);
+  queue_free(&pool->pooljobs);
+  queue_free(&pool->whatprovidesoverlayq);
+  for (i = 0; i < POOL_TMPSPACEBUF; i++)
+    solv_free(pool->tmpspace.buf[i]);
+  solv_free(pool->errstr);
+  solv_free(pool->evrcmpcache);
+#ifdef ENABLE_CONDA
+  pool_conda_freecache(pool);
+#endif
+  solv_free(pool);
+}
+
 /* free all the resources of our pool */
 void
 pool_free(Pool *pool)
 {
   int i;
 
+  if (pool->snapshotof)
+    {
+      pool_free_snapshot(pool);
+      return;
+    }
+  pool->frozen = 0;
   pool_freewhatprovides(pool);
   pool_freeidhashes(pool);
   pool_freeallrepos(pool, 1);
@@ -117,6 +148,7 @@ pool_free(Pool *pool)
   queue_free(&pool->vendormap);
   queue_free(&pool->pooljobs);
   queue_free(&pool->lazywhatprovidesq);
+  queue_free(&pool->whatprovidesoverlayq);
   for (i = 0; i < POOL_TMPSPACEBUF; i++)
     solv_free(pool->tmpspace.buf[i]);
   for (i = 0; i < pool->nlanguages; i++)
@@ -126,6 +158,12 @@ pool_free(Pool *pool)
   solv_free(pool->errstr);
   solv_free(pool->rootdir);
   solv_free(pool->nonstd_ids);
+  solv_free(pool->evrcmpcache);
+  solv_free(pool->evrtokens);
+  solv_free(pool->evrtokendata);
+#ifdef ENABLE_CONDA
+  pool_conda_freecache(pool);
+#endif
   solv_free(pool);
 }
 
@@ -145,6 +183,14 @@ pool_freeallrepos(Pool *pool, int reuseids)
   pool_free_solvable_block(pool, 2, pool->nsolvables - 2, reuseids);
 }
 
+/* the cached results depend on the version comparison settings */
+static void
+pool_clear_evrcmpcache(Pool *pool)
+{
+  if (pool->evrcmpcache)
+    memset(pool->evrcmpcache, 0, POOL_EVRCMPCACHE_SIZE * 4 * sizeof(Id));
+}
+
 int
 pool_setdisttype(Pool *pool, int disttype)
 {
@@ -171,6 +217,8 @@ pool_setdisttype(Pool *pool, int disttype)
     }
   pool->disttype = disttype;
   pool->solvables[SYSTEMSOLVABLE].arch = pool->noarchid;
+  pool_clear_evrcmpcache(pool);
+  pool_freeversionindex(pool);
   return olddisttype;
 #else
   return pool->disttype == disttype ? disttype : -1;
@@ -206,6 +254,18 @@ pool_get_flag(Pool *pool, int flag)
       return pool->nowhatprovidesaux;
     case POOL_FLAG_WHATPROVIDESWITHDISABLED:
       return pool->whatprovideswithdisabled;
+    case POOL_FLAG_INCREMENTALWHATPROVIDES:
+      return pool->incrementalwhatprovides;
+    case POOL_FLAG_EVRCMPCACHE:
+      return pool->evrcmpcache ? 1 : 0;
+    case POOL_FLAG_EVRTOKENS:
+      return pool->evrtokenize;
+    case POOL_FLAG_VERSIONINDEX:
+      return pool->versionindexenabled;
+    case POOL_FLAG_PAGECACHESIZE:
+      return pool->pagecachesize;
+    case POOL_FLAG_FORCETHREADS:
+      return pool->forcethreads;
     default:
       break;
     }
@@ -220,6 +280,8 @@ pool_set_flag(Pool *pool, int flag, int value)
     {
     case POOL_FLAG_PROMOTEEPOCH:
       pool->promoteepoch = value;
+      pool_clear_evrcmpcache(pool);
+      pool_freeversionindex(pool);
       break;
     case POOL_FLAG_FORBIDSELFCONFLICTS:
       pool->forbidselfconflicts = value;
@@ -241,6 +303,8 @@ pool_set_flag(Pool *pool, int flag, int value)
       break;
     case POOL_FLAG_HAVEDISTEPOCH:
       pool->havedistepoch = value;
+      pool_clear_evrcmpcache(pool);
+      pool_freeversionindex(pool);
       break;
     case POOL_FLAG_NOOBSOLETESMULTIVERSION:
       pool->noobsoletesmultiversion = value;
@@ -254,6 +318,41 @@ pool_set_flag(Pool *pool, int flag, int value)
     case POOL_FLAG_WHATPROVIDESWITHDISABLED:
       pool->whatprovideswithdisabled = value;
       break;
+    case POOL_FLAG_INCREMENTALWHATPROVIDES:
+      pool->incrementalwhatprovides = value;
+      break;
+    case POOL_FLAG_EVRCMPCACHE:
+      if (value && !pool->evrcmpcache)
+	{
+	  pool->evrcmpcache = solv_calloc(POOL_EVRCMPCACHE_SIZE * 4, sizeof(Id));
+	  pool->evrcmpcachehits = pool->evrcmpcachemisses = 0;
+	}
+      else if (!value)
+	pool->evrcmpcache = solv_free(pool->evrcmpcache);
+      break;
+    case POOL_FLAG_EVRTOKENS:
+      if (pool->frozen)
+	break;		/* the tokens of a frozen pool are shared */
+      pool->evrtokenize = value;
+      if (!value)
+	{
+	  pool->evrtokens = solv_free(pool->evrtokens);
+	  pool->nevrtokens = 0;
+	  pool->evrtokendata = solv_free(pool->evrtokendata);
+	  pool->evrtokendataoff = 0;
+	}
+      break;
+    case POOL_FLAG_VERSIONINDEX:
+      pool->versionindexenabled = value;
+      if (!value)
+	pool_freeversionindex(pool);
+      break;
+    case POOL_FLAG_PAGECACHESIZE:
+      pool->pagecachesize = value > 0 ? value : 0;
+      break;
+    case POOL_FLAG_FORCETHREADS:
+      pool->forcethreads = value > 1 ? value : 0;
+      break;
     default:
       break;
     }
@@ -440,6 +539,157 @@ pool_shrink_whatprovidesaux(Pool *pool)
 }
 
 
+/*
+ * make the whatprovides entries of file dependencies lazy, so that
+ * pool_addstdproviders also searches the file lists. The offsets
+ * of the provides are remembered in the lazywhatprovidesq.
+ */
+static void
+pool_setup_lazywhatprovides(Pool *pool)
+{
+  int i;
+
+  queue_empty(&pool->lazywhatprovidesq);
+  if (pool->addedfileprovides == 1)
+    {
+      /* lazyly add file provides for nonstd */
+      for (i = 0; i < pool->nonstd_nids; i++)
+	{
+	  Id id = pool->nonstd_ids[i];
+	  const char *str = pool->ss.stringspace + pool->ss.strings[id];
+	  if (str[0] != '/')		/* just in case, all entries should start with '/' */
+	    continue;
+	  /* setup lazy adding, but remember old value */
+	  if (pool->whatprovides[id] > 1)
+	    queue_push2(&pool->lazywhatprovidesq, id, pool->whatprovides[id]);
+	  pool->whatprovides[id] = 0;
+	  if (pool->whatprovidesaux)
+	    pool->whatprovidesaux[id] = 0;	/* sorry */
+	}
+    }
+  else if (!pool->addedfileprovides && pool->disttype == DISTTYPE_RPM)
+    {
+      if (!pool->addedfileprovides)
+	POOL_DEBUG(SOLV_DEBUG_STATS, "WARNING: pool_addfileprovides was not called, this may result in slow operation\n");
+      /* lazyly add file provides */
+      for (i = 1; i < pool->ss.nstrings; i++)
+	{
+	  const char *str = pool->ss.stringspace + pool->ss.strings[i];
+	  if (str[0] != '/')
+	    continue;
+	  if (pool->addedfileprovides == 1 && repodata_filelistfilter_matches(0, str))
+	    continue;
+	  /* setup lazy adding, but remember old value */
+	  if (pool->whatprovides[i] > 1)
+	    queue_push2(&pool->lazywhatprovidesq, i, pool->whatprovides[i]);
+	  pool->whatprovides[i] = 0;
+	  if (pool->whatprovidesaux)
+	    pool->whatprovidesaux[i] = 0;	/* sorry */
+	}
+    }
+  if (pool->lazywhatprovidesq.count)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "lazywhatprovidesq size: %d entries\n", pool->lazywhatprovidesq.count / 2);
+}
+
+/* per thread data for the parallel whatprovides creation */
+struct whatprovides_threads {
+  Pool *pool;
+  int nthreads;
+  Offset **cnt;			/* per thread: provider count, later fill position */
+  Id **last;			/* per thread: last solvable seen for an id */
+  Id *whatprovidesdata;
+  Id *whatprovidesauxdata;
+};
+
+static inline void
+whatprovides_thread_range(struct whatprovides_threads *wt, int idx, Id *startp, Id *endp)
+{
+  Id chunk = (wt->pool->nsolvables + wt->nthreads - 1) / wt->nthreads;
+  Id start = idx * chunk, end = start + chunk;
+  if (end > wt->pool->nsolvables)
+    end = wt->pool->nsolvables;
+  *startp = start > 0 ? start : 1;
+  *endp = end;
+}
+
+/* count the providers of each name in the solvable range of this thread */
+static void
+whatprovides_thread_count(void *data, int idx)
+{
+  struct whatprovides_threads *wt = data;
+  Pool *pool = wt->pool;
+  Offset *cnt;
+  Id *last, *pp, id, p, start, end;
+  Solvable *s;
+
+  cnt = wt->cnt[idx] = solv_calloc(pool->ss.nstrings, sizeof(Offset));
+  last = wt->last[idx] = solv_calloc(pool->ss.nstrings, sizeof(Id));
+  whatprovides_thread_range(wt, idx, &start, &end);
+  for (p = start, s = pool->solvables + p; p < end; p++, s++)
+    {
+      if (!s->provides || !s->repo || s->repo->disabled)
+	continue;
+      if (!pool_installable_whatprovides(pool, s))
+	continue;
+      pp = s->repo->idarraydata + s->provides;
+      while ((id = *pp++) != 0)
+	{
+	  while (ISRELDEP(id))
+	    {
+	      Reldep *rd = GETRELDEP(pool, id);
+	      id = rd->name;
+	    }
+	  if (last[id] != p)	/* count every solvable only once */
+	    {
+	      last[id] = p;
+	      cnt[id]++;
+	    }
+	}
+    }
+}
+
+/* fill the providers into this thread's slice of the name lists */
+static void
+whatprovides_thread_fill(void *data, int idx)
+{
+  struct whatprovides_threads *wt = data;
+  Pool *pool = wt->pool;
+  Offset *pos = wt->cnt[idx];
+  Id *last = wt->last[idx];
+  Id *whatprovidesdata = wt->whatprovidesdata;
+  Id *whatprovidesauxdata = wt->whatprovidesauxdata;
+  Id *pp, id, auxid, p, start, end;
+  Solvable *s;
+
+  whatprovides_thread_range(wt, idx, &start, &end);
+  for (p = end - 1, s = pool->solvables + p; p >= start; p--, s--)
+    {
+      if (!s->provides || !s->repo || s->repo->disabled)
+	continue;
+      if (!pool_installable_whatprovides(pool, s))
+	continue;
+      pp = s->repo->idarraydata + s->provides;
+      while ((id = *pp++) != 0)
+	{
+	  auxid = id;
+	  while (ISRELDEP(id))
+	    {
+	      Reldep *rd = GETRELDEP(pool, id);
+	      id = rd->name;
+	    }
+	  if (last[id] != -p)	/* don't add same solvable twice */
+	    {
+	      last[id] = -p;
+	      whatprovidesdata[--pos[id]] = p;
+	    }
+	  else
+	    auxid = 1;
+	  if (whatprovidesauxdata)
+	    whatprovidesauxdata[pos[id]] = auxid;
+	}
+    }
+}
+
 /*
  * pool_createwhatprovides()
  *
@@ -449,7 +699,23 @@ pool_shrink_whatprovidesaux(Pool *pool)
 void
 pool_createwhatprovides(Pool *pool)
 {
-  int i, num, np, extra;
+  pool_createwhatprovides_threaded(pool, pool->forcethreads ? pool->forcethreads : 1);
+}
+
+/*
+ * pool_createwhatprovides_threaded()
+ *
+ * like pool_createwhatprovides, but split the counting and filling
+ * passes over the solvables into nthreads slices that are worked on
+ * in parallel. Every thread keeps its own provider counts, the fill
+ * positions of the threads are derived from them so that no locking
+ * is needed. The resulting index is identical to the one created
+ * by pool_createwhatprovides.
+ */
+void
+pool_createwhatprovides_threaded(Pool *pool, int nthreads)
+{
+  int i, t, num, np, extra;
   Offset off;
   Solvable *s;
   Id id;
@@ -457,8 +723,15 @@ pool_createwhatprovides(Pool *pool)
   Offset *whatprovides;
   Id *whatprovidesdata, *dp, *whatprovidesauxdata;
   Offset *whatprovidesaux;
+  struct whatprovides_threads wt;
   unsigned int now;
 
+  if (pool->frozen)
+    {
+      /* the index of a frozen pool is shared */
+      pool_error(pool, -1, "pool_createwhatprovides: the pool is frozen");
+      return;
+    }
   now = solv_timems(0);
   POOL_DEBUG(SOLV_DEBUG_STATS, "number of solvables: %d, memory used: %d K\n", pool->nsolvables, pool->nsolvables * (int)sizeof(Solvable) / 1024);
   POOL_DEBUG(SOLV_DEBUG_STATS, "number of ids: %d + %d\n", pool->ss.nstrings, pool->nrels);
@@ -472,8 +745,24 @@ pool_createwhatprovides(Pool *pool)
   pool->whatprovides = whatprovides = solv_calloc_block(num, sizeof(Offset), WHATPROVIDES_BLOCK);
   pool->whatprovides_rel = solv_calloc_block(pool->nrels, sizeof(Offset), WHATPROVIDES_BLOCK);
 
+  if (nthreads > pool->nsolvables / 1024 && !pool->forcethreads)
+    nthreads = pool->nsolvables / 1024;	/* not worth the overhead */
+  memset(&wt, 0, sizeof(wt));
+  if (nthreads > 1)
+    {
+      POOL_DEBUG(SOLV_DEBUG_STATS, "using %d threads\n", nthreads);
+      wt.pool = pool;
+      wt.nthreads = nthreads;
+      wt.cnt = solv_calloc(nthreads, sizeof(Offset *));
+      wt.last = solv_calloc(nthreads, sizeof(Id *));
+      solv_runthreads(nthreads, whatprovides_thread_count, &wt);
+      for (t = 0; t < nthreads; t++)
+	for (id = 0; id < num; id++)
+	  whatprovides[id] += wt.cnt[t][id];
+    }
+
   /* count providers for each name */
-  for (i = pool->nsolvables - 1; i > 0; i--)
+  for (i = pool->nsolvables - 1; i > 0 && nthreads <= 1; i--)
     {
       Id *pp;
       s = pool->solvables + i;
@@ -531,8 +820,36 @@ pool_createwhatprovides(Pool *pool)
       pool->whatprovidesauxdata = whatprovidesauxdata = solv_calloc(pool->whatprovidesauxdataoff, sizeof(Id));
     }
 
+  if (nthreads > 1)
+    {
+      /* thread t gets the part of the list right before the one of thread t + 1 */
+      for (id = 0; id < num; id++)
+	{
+	  Offset o = whatprovides[id];
+	  if (o == 1)
+	    continue;
+	  for (t = nthreads - 1; t >= 0; t--)
+	    {
+	      n = wt.cnt[t][id];
+	      wt.cnt[t][id] = o;
+	      o -= n;
+	    }
+	  whatprovides[id] = o;
+	}
+      wt.whatprovidesdata = whatprovidesdata;
+      wt.whatprovidesauxdata = whatprovidesauxdata;
+      solv_runthreads(nthreads, whatprovides_thread_fill, &wt);
+      for (t = 0; t < nthreads; t++)
+	{
+	  solv_free(wt.cnt[t]);
+	  solv_free(wt.last[t]);
+	}
+      solv_free(wt.cnt);
+      solv_free(wt.last);
+    }
+
   /* now fill data for all provides */
-  for (i = pool->nsolvables - 1; i > 0; i--)
+  for (i = pool->nsolvables - 1; i > 0 && nthreads <= 1; i--)
     {
       Id *pp;
       s = pool->solvables + i;
@@ -574,48 +891,558 @@ pool_createwhatprovides(Pool *pool)
   if (pool->whatprovidesaux)
     POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovidesaux memory used: %d K id array, %d K data\n", pool->whatprovidesauxoff / (int)(1024/sizeof(Id)), pool->whatprovidesauxdataoff / (int)(1024/sizeof(Id)));
 
-  queue_empty(&pool->lazywhatprovidesq);
+  pool->whatprovidesnameoff = pool->whatprovidesdataoff;
+  pool->whatprovidesgarbage = 0;
+  pool_setup_lazywhatprovides(pool);
+  pool_apply_relprovidercache(pool);
+
+  POOL_DEBUG(SOLV_DEBUG_STATS, "createwhatprovides took %d ms\n", solv_timems(now));
+}
+
+/*
+ * undo pool_setup_lazywhatprovides, i.e. make the whatprovides entries
+ * of the file dependencies point to the plain provides again
+ */
+static void
+pool_restore_lazywhatprovides(Pool *pool)
+{
+  int i;
+  Id id, off;
+
   if (pool->addedfileprovides == 1)
     {
-      /* lazyly add file provides for nonstd */
       for (i = 0; i < pool->nonstd_nids; i++)
 	{
-	  Id id = pool->nonstd_ids[i];
-	  const char *str = pool->ss.stringspace + pool->ss.strings[id];
-	  if (str[0] != '/')		/* just in case, all entries should start with '/' */
+	  id = pool->nonstd_ids[i];
+	  if (pool->ss.stringspace[pool->ss.strings[id]] != '/')
 	    continue;
-	  /* setup lazy adding, but remember old value */
-	  if (pool->whatprovides[id] > 1)
-	    queue_push2(&pool->lazywhatprovidesq, id, pool->whatprovides[id]);
-	  pool->whatprovides[id] = 0;
-	  if (pool->whatprovidesaux)
-	    pool->whatprovidesaux[id] = 0;	/* sorry */
+	  off = pool_searchlazywhatprovidesq(pool, id);
+	  pool->whatprovides[id] = off ? off : 1;
 	}
     }
   else if (!pool->addedfileprovides && pool->disttype == DISTTYPE_RPM)
     {
-      if (!pool->addedfileprovides)
-	POOL_DEBUG(SOLV_DEBUG_STATS, "WARNING: pool_addfileprovides was not called, this may result in slow operation\n");
-      /* lazyly add file provides */
-      for (i = 1; i < num; i++)
+      for (id = 1; id < pool->ss.nstrings; id++)
 	{
-	  const char *str = pool->ss.stringspace + pool->ss.strings[i];
-	  if (str[0] != '/')
+	  if (pool->ss.stringspace[pool->ss.strings[id]] != '/')
 	    continue;
-	  if (pool->addedfileprovides == 1 && repodata_filelistfilter_matches(0, str))
+	  off = pool_searchlazywhatprovidesq(pool, id);
+	  pool->whatprovides[id] = off ? off : 1;
+	}
+    }
+  queue_empty(&pool->lazywhatprovidesq);
+}
+
+static int
+pool_updatewhatprovides_sortcmp(const void *ap, const void *bp, void *dp)
+{
+  const Id *a = ap, *b = bp;
+  if (a[0] != b[0])
+    return a[0] - b[0];
+  return a[1] - b[1];
+}
+
+/*
+ * pool_updatewhatprovides()
+ *
+ * incrementally update the whatprovides index after repos were added,
+ * removed, enabled or disabled. ranges contains (start, end) pairs
+ * of the solvable ids that changed, e.g. repo->start and repo->end
+ * of the affected repos. Only the provider lists of names that are
+ * provided by those solvables are rewritten, all other lists are
+ * left untouched.
+ * The relation providers are recomputed lazily, like after
+ * pool_createwhatprovides. Falls back to a full rebuild if there is
+ * no index yet or if too much space was wasted by older updates.
+ */
+void
+pool_updatewhatprovides(Pool *pool, Queue *ranges)
+{
+  int i, k, num, nsolv, nnames;
+  Id p, id, auxid, start, end;
+  Id *pp, *dp, *auxp;
+  Offset o, off, nameoff;
+  Solvable *s;
+  Map changed, touched;
+  Queue provq, newq, newauxq;
+  unsigned int now;
+
+  if (!pool->whatprovides || !pool->whatprovidesnameoff || pool->whatprovidesgarbage > pool->whatprovidesnameoff / 2)
+    {
+      pool_createwhatprovides(pool);
+      return;
+    }
+  now = solv_timems(0);
+  num = pool->ss.nstrings;
+  nameoff = pool->whatprovidesnameoff;
+
+  /* get back to the plain provides index, dropping all the relation
+   * and file list data that was added after the name lists */
+  pool_restore_lazywhatprovides(pool);
+  for (id = 1; id < num; id++)
+    if (pool->whatprovides[id] >= nameoff)
+      break;
+  if (id < num)
+    {
+      /* somebody used pool_set_whatprovides on a name */
+      POOL_DEBUG(SOLV_DEBUG_STATS, "updatewhatprovides: index was modified, recreating it\n");
+      pool_createwhatprovides(pool);
+      return;
+    }
+  pool->whatprovidesdataleft += pool->whatprovidesdataoff - nameoff;
+  pool->whatprovidesdataoff = nameoff;
+  pool->whatprovidesoverlayoff = 0;	/* overlay is gone with the data */
+  queue_empty(&pool->whatprovidesoverlayq);
+  solv_free(pool->whatprovides_rel);
+  pool->whatprovides_rel = solv_calloc_block(pool->nrels, sizeof(Offset), WHATPROVIDES_BLOCK);
+  pool->relprovidercachestate = 0;
+  pool->relprovidercachechksum = solv_free(pool->relprovidercachechksum);
+  pool_freeversionindex(pool);
+#ifdef ENABLE_CONDA
+  pool_conda_flushnames(pool);
+#endif
+  if (pool->whatprovidesaux)
+    {
+      if (pool->whatprovidesauxoff < num)
+	{
+	  pool->whatprovidesaux = solv_realloc2(pool->whatprovidesaux, num, sizeof(Offset));
+	  memset(pool->whatprovidesaux + pool->whatprovidesauxoff, 0, (num - pool->whatprovidesauxoff) * sizeof(Offset));
+	  pool->whatprovidesauxoff = num;
+	}
+      pool->whatprovidesauxdata = solv_extend_resize(pool->whatprovidesauxdata, pool->whatprovidesauxdataoff, sizeof(Id), WHATPROVIDES_BLOCK);
+    }
+
+  /* mark the changed solvables and collect their provides */
+  nsolv = pool->nsolvables;
+  for (i = 0; i < ranges->count; i += 2)
+    if (ranges->elements[i + 1] > nsolv)
+      nsolv = ranges->elements[i + 1];
+  map_init(&changed, nsolv);
+  queue_init(&provq);
+  for (i = 0; i < ranges->count; i += 2)
+    {
+      start = ranges->elements[i] < 2 ? 2 : ranges->elements[i];
+      end = ranges->elements[i + 1];
+      for (p = start; p < end; p++)
+	{
+	  if (MAPTST(&changed, p))
 	    continue;
-	  /* setup lazy adding, but remember old value */
-	  if (pool->whatprovides[i] > 1)
-	    queue_push2(&pool->lazywhatprovidesq, i, pool->whatprovides[i]);
-	  pool->whatprovides[i] = 0;
-	  if (pool->whatprovidesaux)
-	    pool->whatprovidesaux[i] = 0;	/* sorry */
+	  MAPSET(&changed, p);
+	  if (p >= pool->nsolvables)
+	    continue;
+	  s = pool->solvables + p;
+	  if (!s->provides || !s->repo || s->repo->disabled)
+	    continue;
+	  if (!pool_installable_whatprovides(pool, s))
+	    continue;
+	  pp = s->repo->idarraydata + s->provides;
+	  while ((id = *pp++) != 0)
+	    {
+	      auxid = id;
+	      while (ISRELDEP(id))
+		{
+		  Reldep *rd = GETRELDEP(pool, id);
+		  id = rd->name;
+		}
+	      queue_push(&provq, id);
+	      queue_push2(&provq, p, auxid);
+	    }
 	}
     }
-  if (pool->lazywhatprovidesq.count)
-    POOL_DEBUG(SOLV_DEBUG_STATS, "lazywhatprovidesq size: %d entries\n", pool->lazywhatprovidesq.count / 2);
+  solv_sort(provq.elements, provq.count / 3, 3 * sizeof(Id), pool_updatewhatprovides_sortcmp, 0);
 
-  POOL_DEBUG(SOLV_DEBUG_STATS, "createwhatprovides took %d ms\n", solv_timems(now));
+  /* find all name lists that contain a changed solvable */
+  map_init(&touched, nameoff);
+  dp = pool->whatprovidesdata;
+  for (o = off = 4; o < nameoff; o++)
+    {
+      if (!(p = dp[o]))
+	off = o + 1;
+      else if (p >= nsolv || MAPTST(&changed, p))
+	MAPSET(&touched, off);
+    }
+
+  /* now rewrite the lists of all affected names */
+  queue_init(&newq);
+  queue_init(&newauxq);
+  nnames = 0;
+  for (id = 1, k = 0; id < num; id++)
+    {
+      o = pool->whatprovides[id];
+      if (o < 4 || !MAPTST(&touched, o))
+	{
+	  if (k >= provq.count || provq.elements[k] != id)
+	    continue;
+	}
+      if (o == 0)
+	o = 1;
+      auxp = 0;
+      if (pool->whatprovidesaux && o >= 4 && pool->whatprovidesaux[id])
+	auxp = pool->whatprovidesauxdata + pool->whatprovidesaux[id];
+      queue_empty(&newq);
+      queue_empty(&newauxq);
+      for (pp = pool->whatprovidesdata + o; ; pp++)
+	{
+	  p = *pp;
+	  /* merge in the new providers, both lists are sorted */
+	  for (; k < provq.count && provq.elements[k] == id && (!p || provq.elements[k + 1] < p); k += 3)
+	    {
+	      if (newq.count && newq.elements[newq.count - 1] == provq.elements[k + 1])
+		{
+		  newauxq.elements[newauxq.count - 1] = 1;	/* provided more than once */
+		  continue;
+		}
+	      queue_push(&newq, provq.elements[k + 1]);
+	      queue_push(&newauxq, provq.elements[k + 2]);
+	    }
+	  if (!p)
+	    break;
+	  if (p < nsolv && !MAPTST(&changed, p))
+	    {
+	      queue_push(&newq, p);
+	      queue_push(&newauxq, auxp ? auxp[pp - (pool->whatprovidesdata + o)] : 0);
+	    }
+	}
+      if (o >= 4)
+	pool->whatprovidesgarbage += pp - (pool->whatprovidesdata + o) + 1;
+      pool->whatprovides[id] = newq.count ? pool_queuetowhatprovides(pool, &newq) : 1;
+      if (pool->whatprovidesaux)
+	{
+	  if (newq.count && (o < 4 || auxp))
+	    {
+	      pool->whatprovidesauxdata = solv_extend(pool->whatprovidesauxdata, pool->whatprovidesauxdataoff, newauxq.count, sizeof(Id), WHATPROVIDES_BLOCK);
+	      memcpy(pool->whatprovidesauxdata + pool->whatprovidesauxdataoff, newauxq.elements, newauxq.count * sizeof(Id));
+	      pool->whatprovidesaux[id] = pool->whatprovidesauxdataoff;
+	      pool->whatprovidesauxdataoff += newauxq.count;
+	    }
+	  else
+	    pool->whatprovidesaux[id] = 0;
+	}
+      nnames++;
+    }
+  queue_free(&newauxq);
+  queue_free(&newq);
+  map_free(&touched);
+  queue_free(&provq);
+  map_free(&changed);
+
+  pool->whatprovidesnameoff = pool->whatprovidesdataoff;
+  pool_setup_lazywhatprovides(pool);
+  pool_apply_relprovidercache(pool);
+
+  POOL_DEBUG(SOLV_DEBUG_STATS, "updatewhatprovides: rewrote %d of %d name lists, %d ids unused\n", nnames, num, pool->whatprovidesgarbage);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "updatewhatprovides took %d ms\n", solv_timems(now));
+}
+
+/*
+ * pool_checkwhatprovides()
+ *
+ * consistency check of the name part of the whatprovides index,
+ * i.e. compare it with what pool_createwhatprovides would create.
+ * Returns 0 if the index is consistent, -1 otherwise. Meant for
+ * testing pool_updatewhatprovides.
+ */
+int
+pool_checkwhatprovides(Pool *pool)
+{
+  int num, ret = 0;
+  Id p, id, auxid, *pp, *lp;
+  Id *last, *firstaux;
+  Offset *pos, o;
+  Solvable *s;
+  Map lazy;
+
+  if (!pool->whatprovides)
+    return 0;
+  num = pool->ss.nstrings;
+  /* the file provides that pool_setup_lazywhatprovides made lazy */
+  map_init(&lazy, num);
+  if (pool->addedfileprovides == 1)
+    {
+      for (p = 0; p < pool->nonstd_nids; p++)
+	MAPSET(&lazy, pool->nonstd_ids[p]);
+    }
+  else if (!pool->addedfileprovides && pool->disttype == DISTTYPE_RPM)
+    {
+      for (id = 1; id < num; id++)
+	if (pool->ss.stringspace[pool->ss.strings[id]] == '/')
+	  MAPSET(&lazy, id);
+    }
+  pos = solv_calloc(num, sizeof(Offset));
+  for (id = 1; id < num; id++)
+    {
+      o = pool->whatprovides[id];
+      if (MAPTST(&lazy, id))
+	o = pool_searchlazywhatprovidesq(pool, id);
+      pos[id] = o ? o : 1;
+    }
+  last = solv_calloc(num, sizeof(Id));
+  firstaux = solv_calloc(num, sizeof(Id));
+  for (p = 2, s = pool->solvables + p; p < pool->nsolvables && !ret; p++, s++)
+    {
+      if (!s->provides || !s->repo || s->repo->disabled)
+	continue;
+      if (!pool_installable_whatprovides(pool, s))
+	continue;
+      for (pp = s->repo->idarraydata + s->provides; (id = *pp) != 0; pp++)
+	{
+	  auxid = id;
+	  while (ISRELDEP(id))
+	    id = GETRELDEP(pool, id)->name;
+	  firstaux[id] = last[id] == p ? 1 : auxid;
+	  last[id] = p;
+	}
+      for (pp = s->repo->idarraydata + s->provides; (id = *pp) != 0; pp++)
+	{
+	  while (ISRELDEP(id))
+	    id = GETRELDEP(pool, id)->name;
+	  if (last[id] != p)
+	    continue;		/* already checked */
+	  last[id] = -p;
+	  lp = pool->whatprovidesdata + pos[id];
+	  if (*lp != p)
+	    {
+	      ret = pool_error(pool, -1, "pool_checkwhatprovides: %s is missing in the providers of %s", pool_solvid2str(pool, p), pool_id2str(pool, id));
+	      break;
+	    }
+	  if (pool->whatprovidesaux && id < pool->whatprovidesauxoff && pool->whatprovidesaux[id] && !MAPTST(&lazy, id))
+	    {
+	      if (pool->whatprovidesauxdata[pool->whatprovidesaux[id] + (pos[id] - pool->whatprovides[id])] != firstaux[id])
+		{
+		  ret = pool_error(pool, -1, "pool_checkwhatprovides: bad aux entry for %s in the providers of %s", pool_solvid2str(pool, p), pool_id2str(pool, id));
+		  break;
+		}
+	    }
+	  pos[id]++;
+	}
+    }
+  for (id = 1; id < num && !ret; id++)
+    if (pool->whatprovidesdata[pos[id]] != 0)
+      ret = pool_error(pool, -1, "pool_checkwhatprovides: %s is wrongly listed as provider of %s", pool_solvid2str(pool, pool->whatprovidesdata[pos[id]]), pool_id2str(pool, id));
+  solv_free(firstaux);
+  solv_free(last);
+  solv_free(pos);
+  map_free(&lazy);
+  return ret;
+}
+
+/*
+ * pool_freeze()
+ *
+ * compute all the lazily created data of the pool, so that it can
+ * be used by multiple threads at the same time. The threads need to
+ * work with snapshots created by pool_create_snapshot().
+ */
+void
+pool_freeze(Pool *pool)
+{
+  Repo *repo;
+  Id id;
+  int i;
+  unsigned int now;
+
+  if (pool->frozen)
+    return;
+  now = solv_timems(0);
+  /* page in all repository data, lookups must not modify the repodata */
+  FOR_REPOS(i, repo)
+    repo_disable_paging(repo);
+  if (!pool->whatprovides)
+    pool_createwhatprovides(pool);
+  /* resolve the lazy file provides */
+  for (id = 1; id < pool->ss.nstrings; id++)
+    if (!pool->whatprovides[id])
+      pool_whatprovides(pool, id);
+  /* compute the providers of all relations */
+  for (id = 1; id < pool->nrels; id++)
+    if (!pool->whatprovides_rel[id])
+      pool_whatprovides(pool, MAKERELDEP(id));
+  pool_tokenize_evrs(pool);
+  /* lookups create the hashes on demand */
+  pool_str2id(pool, "<NULL>", 0);
+  pool_rel2id(pool, 1, 1, REL_EQ, 0);
+  pool->frozen = 1;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "pool freeze took %d ms, %d K provider data\n", solv_timems(now), pool->whatprovidesdataoff / (int)(1024/sizeof(Id)));
+}
+
+void
+pool_unfreeze(Pool *pool)
+{
+  if (!pool->snapshotof)
+    pool->frozen = 0;
+}
+
+int
+pool_isfrozen(Pool *pool)
+{
+  return pool->frozen;
+}
+
+/*
+ * pool_create_snapshot()
+ *
+ * create a pool that shares all the data with a frozen pool. The
+ * snapshot has its own tmp space, search position and whatprovides
+ * extension area, so one thread can use it to create and run
+ * solvers while other threads do the same with other snapshots.
+ */
+Pool *
+pool_create_snapshot(Pool *pool)
+{
+  Pool *snap;
+
+  if (!pool->frozen || pool->snapshotof)
+    {
+      pool_error(pool, 0, "pool_create_snapshot: pool is not frozen");
+      return 0;
+    }
+  snap = solv_calloc(1, sizeof(Pool));
+  *snap = *pool;
+  snap->snapshotof = pool;
+  memset(&snap->tmpspace, 0, sizeof(snap->tmpspace));
+  memset(&snap->pos, 0, sizeof(snap->pos));
+  snap->errstr = 0;
+  snap->errstra = 0;
+  queue_init_clone(&snap->pooljobs, &pool->pooljobs);
+  snap->whatprovidesoverlayoff = 0;
+  snap->whatprovidesoverlayref = 0;
+  snap->whatprovidesoverlaysolving = 0;
+  queue_init(&snap->whatprovidesoverlayq);
+  /* the relation offsets are private, the provider data gets copied on
+   * the first addition, see pool_ids2whatprovides */
+  snap->whatprovides_rel = solv_calloc_block(pool->nrels, sizeof(Offset), WHATPROVIDES_BLOCK);
+  memcpy(snap->whatprovides_rel, pool->whatprovides_rel, pool->nrels * sizeof(Offset));
+  snap->whatprovidesdataleft = 0;
+  snap->relprovidercachestate = 1;	/* the frozen pool has all providers */
+  snap->relprovidercachechksum = 0;
+  if (pool->evrcmpcache)
+    snap->evrcmpcache = solv_calloc(POOL_EVRCMPCACHE_SIZE * 4, sizeof(Id));
+  snap->evrcmpcachehits = snap->evrcmpcachemisses = 0;
+  snap->condacache = 0;
+  return snap;
+}
+
+/*
+ * whatprovides overlays
+ *
+ * Provider lists added while an overlay is active are only valid
+ * until the overlay ends. This is used by the solver to get rid of
+ * its rule data and the lazily computed providers when it is freed,
+ * so that the whatprovides data does not grow with every solver run.
+ * Overlays are reference counted, the data is dropped when the last
+ * user ends the overlay.
+ * The overlay users must enclose their solving with
+ * pool_whatprovides_overlay_enter/leave. Data that is added by
+ * somebody else may still be referenced when the overlay ends, so
+ * it pins the overlay and nothing gets dropped. The lazily computed
+ * providers of the overlay are hidden when the users leave, so that
+ * the others do not pick up offsets into the overlay.
+ */
+void
+pool_whatprovides_overlay_begin(Pool *pool)
+{
+  if (pool->whatprovidesoverlayref++ || !pool->whatprovides)
+    return;
+  pool->whatprovidesoverlayoff = pool->whatprovidesdataoff;
+  pool->whatprovidesoverlaypromote = 0;
+  pool->whatprovidesoverlaypinned = 0;
+  queue_empty(&pool->whatprovidesoverlayq);
+}
+
+/* forget the entries that point into the overlay. Returns the
+ * number of entries left in the overlay queue. */
+static int
+pool_whatprovides_overlay_hide(Pool *pool)
+{
+  Offset off = pool->whatprovidesoverlayoff;
+  Queue *q = &pool->whatprovidesoverlayq;
+  int i, j;
+  Id id;
+
+  for (i = j = 0; i < q->count; i++)
+    {
+      id = q->elements[i];
+      if (ISRELDEP(id))
+	{
+	  if (pool->whatprovides_rel[GETRELID(id)] >= off)
+	    pool->whatprovides_rel[GETRELID(id)] = 0;
+	  else if (pool->whatprovides_rel[GETRELID(id)])
+	    continue;
+	}
+      else if (pool->whatprovides[id] >= off)
+	pool->whatprovides[id] = 0;
+      else if (pool->whatprovides[id])
+	continue;
+      q->elements[j++] = id;
+    }
+  queue_truncate(q, j);
+  return j;
+}
+
+/* start solving with the overlay */
+void
+pool_whatprovides_overlay_enter(Pool *pool)
+{
+  pool->whatprovidesoverlaysolving++;
+}
+
+/* done solving with the overlay */
+void
+pool_whatprovides_overlay_leave(Pool *pool)
+{
+  if (!pool->whatprovidesoverlaysolving)
+    return;
+  if (--pool->whatprovidesoverlaysolving || !pool->whatprovidesoverlayoff)
+    return;
+  pool_whatprovides_overlay_hide(pool);
+}
+
+/* end an overlay. If promote is set, the lazily computed providers
+ * get recomputed in a batch after the overlay data is dropped, so
+ * that they stay available in the pool */
+void
+pool_whatprovides_overlay_end(Pool *pool, int promote)
+{
+  Offset off = pool->whatprovidesoverlayoff;
+  Queue *q = &pool->whatprovidesoverlayq;
+  int i, npromoted = 0;
+  Id id;
+
+  if (!pool->whatprovidesoverlayref)
+    return;
+  if (promote)
+    pool->whatprovidesoverlaypromote = 1;
+  if (--pool->whatprovidesoverlayref)
+    return;
+  if (!off)
+    return;	/* the index was recreated */
+  if (pool->whatprovidesoverlaypinned)
+    {
+      /* somebody else added data, it may point into the overlay */
+      POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovides overlay: kept %d K data, it may still be referenced\n", (pool->whatprovidesdataoff - off) / (int)(1024/sizeof(Id)));
+      pool->whatprovidesoverlayoff = 0;
+      queue_empty(q);
+      return;
+    }
+  pool_whatprovides_overlay_hide(pool);
+  pool->whatprovidesoverlayoff = 0;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovides overlay: dropped %d K data\n", (pool->whatprovidesdataoff - off) / (int)(1024/sizeof(Id)));
+  pool->whatprovidesdataleft += pool->whatprovidesdataoff - off;
+  pool->whatprovidesdataoff = off;
+  pool->relprovidercachestate = 0;	/* the stored providers may have been dropped */
+  if (pool->whatprovidesoverlaypromote)
+    {
+      for (i = 0; i < q->count; i++)
+	{
+	  id = q->elements[i];
+	  if (ISRELDEP(id) ? pool->whatprovides_rel[GETRELID(id)] : pool->whatprovides[id])
+	    continue;	/* already promoted */
+	  pool_whatprovides(pool, id);
+	  npromoted++;
+	}
+      POOL_DEBUG(SOLV_DEBUG_STATS, "whatprovides overlay: promoted %d entries\n", npromoted);
+    }
+  queue_empty(q);
 }
 
 /*
@@ -626,6 +1453,12 @@ pool_createwhatprovides(Pool *pool)
 void
 pool_freewhatprovides(Pool *pool)
 {
+  if (pool->frozen)
+    {
+      /* the index of a frozen pool is shared */
+      pool_error(pool, -1, "pool_freewhatprovides: the pool is frozen");
+      return;
+    }
   pool->whatprovides = solv_free(pool->whatprovides);
   pool->whatprovides_rel = solv_free(pool->whatprovides_rel);
   pool->whatprovidesdata = solv_free(pool->whatprovidesdata);
@@ -635,6 +1468,16 @@ pool_freewhatprovides(Pool *pool)
   pool->whatprovidesauxdata = solv_free(pool->whatprovidesauxdata);
   pool->whatprovidesauxoff = 0;
   pool->whatprovidesauxdataoff = 0;
+  pool->whatprovidesnameoff = 0;
+  pool->whatprovidesgarbage = 0;
+  pool->whatprovidesoverlayoff = 0;	/* overlay is gone with the data */
+  queue_empty(&pool->whatprovidesoverlayq);
+  pool->relprovidercachestate = 0;
+  pool->relprovidercachechksum = solv_free(pool->relprovidercachechksum);
+  pool_freeversionindex(pool);
+#ifdef ENABLE_CONDA
+  pool_conda_flushnames(pool);
+#endif
 }
 
 
@@ -660,6 +1503,14 @@ pool_ids2whatprovides(Pool *pool, Id *ids, int count)
     return 2;
 
   /* extend whatprovidesdata if needed, +1 for 0-termination */
+  if (pool->snapshotof && pool->whatprovidesdata == pool->snapshotof->whatprovidesdata)
+    {
+      /* first addition in a snapshot, switch to a private copy */
+      Id *whatprovidesdata = solv_calloc(pool->whatprovidesdataoff + count + 4096, sizeof(Id));
+      memcpy(whatprovidesdata, pool->whatprovidesdata, pool->whatprovidesdataoff * sizeof(Id));
+      pool->whatprovidesdata = whatprovidesdata;
+      pool->whatprovidesdataleft = count + 4096;
+    }
   if (pool->whatprovidesdataleft < count + 1)
     {
       POOL_DEBUG(SOLV_DEBUG_STATS, "growing provides hash data...\n");
@@ -667,6 +1518,10 @@ pool_ids2whatprovides(Pool *pool, Id *ids, int count)
       pool->whatprovidesdataleft = count + 4096;
     }
 
+  /* data of others may reference the overlay, see pool_whatprovides_overlay_end */
+  if (pool->whatprovidesoverlayoff && !pool->whatprovidesoverlaysolving)
+    pool->whatprovidesoverlaypinned = 1;
+
   /* copy queue to next free slot */
   off = pool->whatprovidesdataoff;
   memcpy(pool->whatprovidesdata + pool->whatprovidesdataoff, ids, count * sizeof(Id));
@@ -1020,6 +1875,8 @@ pool_addstdproviders(Pool *pool, Id d)
 	    }
 	}
       pool->whatprovides[d] = pool_queuetowhatprovides(pool, &q);
+      if (pool->whatprovidesoverlayoff)
+	queue_push(&pool->whatprovidesoverlayq, d);
     }
   queue_free(&q);
   return pool->whatprovides[d];
@@ -1107,6 +1964,12 @@ rpmeqmagic_cantmatch(Pool *pool, int flags, Id evr, int eqmagic)
   return 0;
 }
 
+static int
+addrelproviders_idcmp(const void *ap, const void *bp, void *dp)
+{
+  return *(const Id *)ap - *(const Id *)bp;
+}
+
 /*
  * addrelproviders
  *
@@ -1342,19 +2205,32 @@ pool_addrelproviders(Pool *pool, Id d)
 	  /* we can reuse an existing entry */
 	  queue_free(&plist);
 	  pool->whatprovides_rel[d] = wp;
+	  if (pool->whatprovidesoverlayoff && (Offset)wp >= pool->whatprovidesoverlayoff)
+	    queue_push(&pool->whatprovidesoverlayq, MAKERELDEP(d));
 	  return wp;
 	}
     }
   else if (flags)
     {
-      Id *ppaux = 0;
+      Id *ppaux = 0, *ppindex = 0;
       int eqmagic = 0;
       /* simple version comparison relation */
+      if (!pool->relprovidercachestate)
+	{
+	  pool_apply_relprovidercache(pool);
+	  if (pool->whatprovides_rel[d])
+	    {
+	      queue_free(&plist);
+	      return pool->whatprovides_rel[d];
+	    }
+	}
 #if 0
       POOL_DEBUG(SOLV_DEBUG_STATS, "addrelproviders: what provides %s?\n", pool_dep2str(pool, name));
 #endif
       pp = pool_whatprovides_ptr(pool, name);
-      if (!ISRELDEP(name) && (Offset)name < pool->whatprovidesauxoff)
+      if (pool->versionindexenabled && (ppindex = pool_versionindex_addproviders(pool, name, flags, evr, &plist)) != 0)
+	pp = ppindex;		/* only check the providers that are not indexed */
+      else if (!ISRELDEP(name) && (Offset)name < pool->whatprovidesauxoff)
 	ppaux = pool->whatprovidesaux[name] ? pool->whatprovidesauxdata + pool->whatprovidesaux[name] : 0;
       while (ISRELDEP(name))
 	{
@@ -1432,6 +2308,16 @@ pool_addrelproviders(Pool *pool, Id d)
 	    continue;	/* none of the providers matched */
 	  queue_push(&plist, p);
 	}
+      if (ppindex && plist.count > 1)
+	{
+	  /* the index is sorted by evr, bring the providers back into order */
+	  int i, j;
+	  solv_sort(plist.elements, plist.count, sizeof(Id), addrelproviders_idcmp, 0);
+	  for (i = j = 1; i < plist.count; i++)
+	    if (plist.elements[i] != plist.elements[j - 1])
+	      plist.elements[j++] = plist.elements[i];
+	  queue_truncate(&plist, j);
+	}
       /* make our system solvable provide all unknown rpmlib() stuff */
       if (plist.count == 0 && !strncmp(pool_id2str(pool, name), "rpmlib(", 7))
 	queue_push(&plist, SYSTEMSOLVABLE);
@@ -1442,6 +2328,8 @@ pool_addrelproviders(Pool *pool, Id d)
 #endif
   pool->whatprovides_rel[d] = pool_queuetowhatprovides(pool, &plist);
   queue_free(&plist);
+  if (pool->whatprovidesoverlayoff)
+    queue_push(&pool->whatprovidesoverlayq, MAKERELDEP(d));
 
   return pool->whatprovides_rel[d];
 }
@@ -1740,19 +2628,65 @@ pool_id2langid(Pool *pool, Id id, const char *lang, int create)
   return id;
 }
 
+#ifdef ENABLE_THREADS
+
+/* frozen pools may be used by many threads, so every thread
+ * gets its own tmp space */
+static pthread_key_t frozen_tmpspace_key;
+static pthread_once_t frozen_tmpspace_once = PTHREAD_ONCE_INIT;
+
+static void
+frozen_tmpspace_free(void *data)
+{
+  struct s_Pool_tmpspace *tmpspace = data;
+  int i;
+  for (i = 0; i < POOL_TMPSPACEBUF; i++)
+    solv_free(tmpspace->buf[i]);
+  solv_free(tmpspace);
+}
+
+static void
+frozen_tmpspace_create_key(void)
+{
+  pthread_key_create(&frozen_tmpspace_key, frozen_tmpspace_free);
+}
+
+#endif
+
+static inline struct s_Pool_tmpspace *
+pool_get_tmpspace(Pool *pool)
+{
+#ifdef ENABLE_THREADS
+  if (pool->frozen && !pool->snapshotof)
+    {
+      struct s_Pool_tmpspace *tmpspace;
+      pthread_once(&frozen_tmpspace_once, frozen_tmpspace_create_key);
+      tmpspace = pthread_getspecific(frozen_tmpspace_key);
+      if (!tmpspace)
+	{
+	  tmpspace = solv_calloc(1, sizeof(*tmpspace));
+	  pthread_setspecific(frozen_tmpspace_key, tmpspace);
+	}
+      return tmpspace;
+    }
+#endif
+  return &pool->tmpspace;
+}
+
 char *
 pool_alloctmpspace(Pool *pool, int len)
 {
-  int n = pool->tmpspace.n;
+  struct s_Pool_tmpspace *tmpspace = pool_get_tmpspace(pool);
+  int n = tmpspace->n;
   if (!len)
     return 0;
-  if (len > pool->tmpspace.len[n])
+  if (len > tmpspace->len[n])
     {
-      pool->tmpspace.buf[n] = solv_realloc(pool->tmpspace.buf[n], len + 32);
-      pool->tmpspace.len[n] = len + 32;
+      tmpspace->buf[n] = solv_realloc(tmpspace->buf[n], len + 32);
+      tmpspace->len[n] = len + 32;
     }
-  pool->tmpspace.n = (n + 1) % POOL_TMPSPACEBUF;
-  return pool->tmpspace.buf[n];
+  tmpspace->n = (n + 1) % POOL_TMPSPACEBUF;
+  return tmpspace->buf[n];
 }
 
 static char *
@@ -1760,22 +2694,23 @@ pool_alloctmpspace_free(Pool *pool, const char *space, int len)
 {
   if (space)
     {
+      struct s_Pool_tmpspace *tmpspace = pool_get_tmpspace(pool);
       int n, oldn;
-      n = oldn = pool->tmpspace.n;
+      n = oldn = tmpspace->n;
       for (;;)
 	{
 	  if (!n--)
 	    n = POOL_TMPSPACEBUF - 1;
 	  if (n == oldn)
 	    break;
-	  if (pool->tmpspace.buf[n] != space)
+	  if (tmpspace->buf[n] != space)
 	    continue;
-	  if (len > pool->tmpspace.len[n])
+	  if (len > tmpspace->len[n])
 	    {
-	      pool->tmpspace.buf[n] = solv_realloc(pool->tmpspace.buf[n], len + 32);
-	      pool->tmpspace.len[n] = len + 32;
+	      tmpspace->buf[n] = solv_realloc(tmpspace->buf[n], len + 32);
+	      tmpspace->len[n] = len + 32;
 	    }
-          return pool->tmpspace.buf[n];
+          return tmpspace->buf[n];
 	}
     }
   return 0;
@@ -1784,12 +2719,13 @@ pool_alloctmpspace_free(Pool *pool, const char *space, int len)
 void
 pool_freetmpspace(Pool *pool, const char *space)
 {
-  int n = pool->tmpspace.n;
+  struct s_Pool_tmpspace *tmpspace = pool_get_tmpspace(pool);
+  int n = tmpspace->n;
   if (!space)
     return;
   n = (n + (POOL_TMPSPACEBUF - 1)) % POOL_TMPSPACEBUF;
-  if (pool->tmpspace.buf[n] == space)
-    pool->tmpspace.n = n;
+  if (tmpspace->buf[n] == space)
+    tmpspace->n = n;
 }
 
 char *
@@ -1958,6 +2894,8 @@ pool_set_whatprovides(Pool *pool, Id id, Id providers)
   Reldep *rd;
   Map m;
 
+  if (pool->whatprovidesoverlayoff && (Offset)providers >= pool->whatprovidesoverlayoff)
+    queue_push(&pool->whatprovidesoverlayq, id);
   /* set new entry */
   if (ISRELDEP(id))
     {
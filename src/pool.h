@@ -53,6 +53,9 @@ typedef struct s_Datapos {
 /* how many strings to maintain (round robin) */
 #define POOL_TMPSPACEBUF 16
 
+/* number of entries of the evr compare cache */
+#define POOL_EVRCMPCACHE_SIZE 65536
+
 struct s_Pool_tmpspace {
   char *buf[POOL_TMPSPACEBUF];
   int   len[POOL_TMPSPACEBUF];
@@ -167,6 +170,43 @@ struct s_Pool {
   int nonstd_nids;
 
   int whatprovideswithdisabled;
+  int incrementalwhatprovides;	/* true: keep the whatprovides index when repos are added/freed */
+  Offset whatprovidesnameoff;	/* end of the name provider lists in whatprovidesdata */
+  Offset whatprovidesgarbage;	/* space of name lists replaced by pool_updatewhatprovides */
+
+  int frozen;			/* true: all lazy data is computed, the pool is read-only */
+  Pool *snapshotof;		/* the frozen pool this snapshot shares its data with */
+  int forcethreads;		/* testing: use this many threads, also for small amounts of work */
+
+  Offset whatprovidesoverlayoff;	/* start of the overlay data in whatprovidesdata */
+  int whatprovidesoverlayref;		/* number of overlay users */
+  int whatprovidesoverlaypromote;	/* true: recompute the overlay entries when it ends */
+  int whatprovidesoverlaysolving;	/* number of overlay users that are solving */
+  int whatprovidesoverlaypinned;	/* true: data was added outside of the overlay users */
+  Queue whatprovidesoverlayq;		/* ids whose providers were set in the overlay */
+
+  int relprovidercachestate;		/* true: the stored rel providers of the repos were added */
+  unsigned char *relprovidercachechksum;	/* checksum of the pool composition */
+
+  Id *evrcmpcache;		/* (evr1, evr2, mode, result) entries, see pool_evrcmp */
+  unsigned int evrcmpcachehits;
+  unsigned int evrcmpcachemisses;
+
+  int evrtokenize;		/* true: compare the tokenized evrs */
+  Offset *evrtokens;		/* evr id -> offset into evrtokendata, 1: can't be tokenized */
+  Id nevrtokens;
+  unsigned int *evrtokendata;
+  Offset evrtokendataoff;
+
+  int versionindexenabled;	/* true: use the sorted version index for simple relations */
+  Offset *versionindex;		/* name id -> offset into versionindexdata */
+  Id nversionindex;
+  Id *versionindexdata;
+  Offset versionindexdataoff;
+
+  int pagecachesize;		/* K of uncompressed pages to keep per paged repodata */
+
+  struct s_Conda_cache *condacache;	/* compiled matchspecs and the name index, see conda.c */
 #endif
 };
 
@@ -207,6 +247,12 @@ struct s_Pool {
 #define POOL_FLAG_IMPLICITOBSOLETEUSESCOLORS		10
 #define POOL_FLAG_NOWHATPROVIDESAUX			11
 #define POOL_FLAG_WHATPROVIDESWITHDISABLED		12
+#define POOL_FLAG_INCREMENTALWHATPROVIDES		13
+#define POOL_FLAG_EVRCMPCACHE				14
+#define POOL_FLAG_EVRTOKENS				15
+#define POOL_FLAG_VERSIONINDEX				16
+#define POOL_FLAG_PAGECACHESIZE				17
+#define POOL_FLAG_FORCETHREADS				18
 
 /* ----------------------------------------------- */
 
@@ -322,6 +368,17 @@ static inline int pool_match_nevr(Pool *pool, Solvable *s, Id d)
  * Prepares a pool for solving
  */
 extern void pool_createwhatprovides(Pool *pool);
+extern void pool_createwhatprovides_threaded(Pool *pool, int nthreads);
+extern void pool_updatewhatprovides(Pool *pool, Queue *ranges);
+extern int  pool_checkwhatprovides(Pool *pool);
+extern void pool_freeze(Pool *pool);
+extern void pool_unfreeze(Pool *pool);
+extern int pool_isfrozen(Pool *pool);
+extern Pool *pool_create_snapshot(Pool *pool);
+extern void pool_whatprovides_overlay_begin(Pool *pool);		/* internal */
+extern void pool_whatprovides_overlay_end(Pool *pool, int promote);	/* internal */
+extern void pool_whatprovides_overlay_enter(Pool *pool);		/* internal */
+extern void pool_whatprovides_overlay_leave(Pool *pool);		/* internal */
 extern void pool_addfileprovides(Pool *pool);
 extern void pool_addfileprovides_queue(Pool *pool, Queue *idq, Queue *idqinst);
 extern void pool_freewhatprovides(Pool *pool);
@@ -330,6 +387,10 @@ extern Id pool_ids2whatprovides(Pool *pool, Id *ids, int count);
 extern Id pool_searchlazywhatprovidesq(Pool *pool, Id d);
 
 extern Id pool_addrelproviders(Pool *pool, Id d);
+extern void pool_apply_relprovidercache(Pool *pool);	/* internal */
+extern void pool_tokenize_evrs(Pool *pool);		/* internal */
+extern Id *pool_versionindex_addproviders(Pool *pool, Id name, int flags, Id evr, Queue *plist);	/* internal */
+extern void pool_freeversionindex(Pool *pool);		/* internal */
 
 static inline Id pool_whatprovides(Pool *pool, Id d)
 {
@@ -39,7 +39,16 @@ Id
 pool_str2id(Pool *pool, const char *str, int create)
 {
   int oldnstrings = pool->ss.nstrings;
-  Id id = stringpool_str2id(&pool->ss, str, create);
+  Id id;
+  if (pool->frozen && create)
+    {
+      /* frozen pools are read-only */
+      id = stringpool_str2id(&pool->ss, str, 0);
+      if (!id && str)
+	pool_error(pool, 0, "pool_str2id: cannot add '%s' to a frozen pool", str);
+      return id;
+    }
+  id = stringpool_str2id(&pool->ss, str, create);
   if (create && pool->whatprovides && oldnstrings != pool->ss.nstrings)
     grow_whatprovides(pool, id);
   return id;
@@ -49,7 +58,16 @@ Id
 pool_strn2id(Pool *pool, const char *str, unsigned int len, int create)
 {
   int oldnstrings = pool->ss.nstrings;
-  Id id = stringpool_strn2id(&pool->ss, str, len, create);
+  Id id;
+  if (pool->frozen && create)
+    {
+      /* frozen pools are read-only */
+      id = stringpool_strn2id(&pool->ss, str, len, 0);
+      if (!id && str)
+	pool_error(pool, 0, "pool_strn2id: cannot add '%.*s' to a frozen pool", (int)len, str);
+      return id;
+    }
+  id = stringpool_strn2id(&pool->ss, str, len, create);
   if (create && pool->whatprovides && oldnstrings != pool->ss.nstrings)
     grow_whatprovides(pool, id);
   return id;
@@ -118,6 +136,8 @@ pool_rel2id(Pool *pool, Id name, Id evr, int flags, int create)
 
   if (!create)
     return ID_NULL;
+  if (pool->frozen)
+    return pool_error(pool, ID_NULL, "pool_rel2id: cannot add relations to a frozen pool");
 
   id = pool->nrels++;
   /* extend rel space if needed */
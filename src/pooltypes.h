@@ -28,6 +28,7 @@ extern "C" {
 #define SOLV_VERSION_7 7
 #define SOLV_VERSION_8 8
 #define SOLV_VERSION_9 9
+#define SOLV_VERSION_10 10
 
 #define SOLV_FLAG_PREFIX_POOL	4
 #define SOLV_FLAG_SIZE_BYTES	8
@@ -934,6 +934,7 @@ create_solutions(Solver *solv, int probnr, int solidx)
     }
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "create_solutions for problem #%d took %d ms\n", probnr, solv_timems(now));
+  solv->stats.time_problems += solv_timems(now);
 }
 
 
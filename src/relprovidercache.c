@@ -0,0 +1,389 @@
+/*
+ * relprovidercache.c
+ *
+ * Precomputed providers of the versioned dependencies of a repository.
+ *
+ * The provider lists are stored in the meta section of the repository,
+ * so they get written to the solv file. They are only valid for the
+ * pool they were computed with, so a checksum over the composition of
+ * the pool is stored with them. The checksum of the pool is computed
+ * when the whatprovides index is created. If it matches, all stored
+ * lists are added to the index without doing any evr comparisons.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "util.h"
+#include "bitmap.h"
+#include "chksum.h"
+#include "repopack.h"
+#include "hash.h"
+
+#define RELPROVIDERCACHE_BLOCK	4095
+
+/* we only cache the simple version comparison relations */
+static inline int
+is_cacheable_rel(Pool *pool, Id dep)
+{
+  Reldep *rd;
+  if (!ISRELDEP(dep))
+    return 0;
+  rd = GETRELDEP(pool, dep);
+  return rd->flags > 0 && rd->flags < 8 && !ISRELDEP(rd->name) && !ISRELDEP(rd->evr);
+}
+
+static void
+chksum_add_dep(Pool *pool, Chksum *chk, Id id)
+{
+  unsigned char buf[5];
+
+  while (ISRELDEP(id))
+    {
+      Reldep *rd = GETRELDEP(pool, id);
+      buf[0] = 1;
+      buf[1] = rd->flags >> 24;
+      buf[2] = rd->flags >> 16;
+      buf[3] = rd->flags >> 8;
+      buf[4] = rd->flags;
+      solv_chksum_add(chk, buf, 5);
+      chksum_add_dep(pool, chk, rd->name);
+      id = rd->evr;
+    }
+  if (id >= pool->ss.nstrings)
+    {
+      /* not a string, e.g. a namespace argument */
+      buf[0] = 2;
+      buf[1] = id >> 24;
+      buf[2] = id >> 16;
+      buf[3] = id >> 8;
+      buf[4] = id;
+      solv_chksum_add(chk, buf, 5);
+      return;
+    }
+  solv_chksum_add(chk, pool_id2str(pool, id), strlen(pool_id2str(pool, id)) + 1);
+}
+
+/* a hash of a dependency that does not depend on the ids of the pool */
+static Hashval
+dep_hash(Pool *pool, Id id)
+{
+  if (ISRELDEP(id))
+    {
+      Reldep *rd = GETRELDEP(pool, id);
+      return relhash(dep_hash(pool, rd->name), dep_hash(pool, rd->evr), rd->flags);
+    }
+  if (id >= pool->ss.nstrings)
+    return id;
+  return strhash(pool_id2str(pool, id));
+}
+
+static int
+provides_sort_cmp(const void *ap, const void *bp, void *dp)
+{
+  const Hashval *a = ap, *b = bp;
+  return *a < *b ? -1 : *a > *b ? 1 : 0;
+}
+
+/*
+ * calculate a checksum over everything that influences the providers
+ * of a versioned dependency: the solvables with their ids, which of
+ * them are part of the whatprovides index, their provides and the
+ * version comparison settings of the pool.
+ */
+static void
+pool_relprovidercache_chksum(Pool *pool, unsigned char *out)
+{
+  Chksum *chk = solv_chksum_create(REPOKEY_TYPE_SHA256);
+  unsigned char buf[16];
+  Solvable *s;
+  Id p, *pp;
+  Queue prvq;
+  int i;
+
+  queue_init(&prvq);
+  buf[0] = pool->disttype;
+  buf[1] = pool->promoteepoch;
+  buf[2] = pool->havedistepoch;
+  for (i = 0; i < 4; i++)
+    buf[3 + i] = pool->nsolvables >> (24 - 8 * i);
+  solv_chksum_add(chk, buf, 7);
+  for (p = 1, s = pool->solvables + p; p < pool->nsolvables; p++, s++)
+    {
+      if (!s->repo)
+	{
+	  solv_chksum_add(chk, "", 1);
+	  continue;
+	}
+      buf[0] = 1;
+      if (s->repo == pool->installed)
+	buf[0] |= 2;
+      if (!s->repo->disabled && pool_installable_whatprovides(pool, s))
+	buf[0] |= 4;
+      solv_chksum_add(chk, buf, 1);
+      chksum_add_dep(pool, chk, s->name);
+      chksum_add_dep(pool, chk, s->evr);
+      chksum_add_dep(pool, chk, s->arch);
+      if (s->provides)
+	{
+	  /* the order of the provides is not kept when the repository
+	   * is written, so add them sorted by their hash */
+	  queue_empty(&prvq);
+	  for (pp = s->repo->idarraydata + s->provides; *pp; pp++)
+	    queue_push2(&prvq, dep_hash(pool, *pp), *pp);
+	  if (prvq.count > 2)
+	    solv_sort(prvq.elements, prvq.count / 2, 2 * sizeof(Id), provides_sort_cmp, 0);
+	  for (i = 0; i < prvq.count; i += 2)
+	    chksum_add_dep(pool, chk, prvq.elements[i + 1]);
+	}
+      solv_chksum_add(chk, "", 1);
+    }
+  queue_free(&prvq);
+  solv_chksum_free(chk, out);
+}
+
+static void
+collect_dep(Pool *pool, Map *seen, Queue *deps, Id dep)
+{
+  while (ISRELDEP(dep))
+    {
+      Reldep *rd = GETRELDEP(pool, dep);
+      if (rd->flags > 0 && rd->flags < 8)
+	{
+	  if (is_cacheable_rel(pool, dep) && !MAPTST(seen, GETRELID(dep)))
+	    {
+	      MAPSET(seen, GETRELID(dep));
+	      queue_push(deps, dep);
+	    }
+	  return;
+	}
+      if (rd->flags != REL_AND && rd->flags != REL_OR && rd->flags != REL_WITH && rd->flags != REL_WITHOUT &&
+	  rd->flags != REL_COND && rd->flags != REL_UNLESS && rd->flags != REL_ELSE)
+	return;
+      /* complex dependency, look at both sides */
+      collect_dep(pool, seen, deps, rd->name);
+      dep = rd->evr;
+    }
+}
+
+static void
+collect_deps(Repo *repo, Map *seen, Queue *deps, Offset off)
+{
+  Id *dp;
+  if (!off)
+    return;
+  for (dp = repo->idarraydata + off; *dp; dp++)
+    collect_dep(repo->pool, seen, deps, *dp);
+}
+
+static unsigned char *
+addid(unsigned char *buf, int *lenp, Id sx)
+{
+  unsigned int x = (unsigned int)sx;
+  unsigned char *dp;
+
+  buf = solv_extend(buf, *lenp, 5, 1, RELPROVIDERCACHE_BLOCK);
+  dp = buf + *lenp;
+  if (x >= (1 << 14))
+    {
+      if (x >= (1 << 28))
+	*dp++ = (x >> 28) | 128;
+      if (x >= (1 << 21))
+	*dp++ = (x >> 21) | 128;
+      *dp++ = (x >> 14) | 128;
+    }
+  if (x >= (1 << 7))
+    *dp++ = (x >> 7) | 128;
+  *dp++ = x & 127;
+  *lenp = dp - buf;
+  return buf;
+}
+
+/*
+ * repo_add_relprovidercache()
+ *
+ * compute the providers of all versioned dependencies used by the
+ * solvables of the repository and store them in the meta section.
+ * The whatprovides index must have been created, the lists are only
+ * used again if the pool has the same composition.
+ *
+ * The provider lists are stored as a list of solvable id deltas,
+ * preceded by the number of providers plus one. A zero count means
+ * that all providers of the dependency name match.
+ */
+int
+repo_add_relprovidercache(Repo *repo, int flags)
+{
+  Pool *pool = repo->pool;
+  Repodata *data;
+  Queue deps, cached;
+  Map seen;
+  Solvable *s;
+  Id p, d, wp, nwp, last, *pp, *npp;
+  int i, cnt, len = 0, nsame = 0;
+  unsigned char *buf = 0;
+  unsigned char chk[32];
+
+  if (!pool->whatprovides)
+    return pool_error(pool, -1, "repo_add_relprovidercache: no whatprovides index");
+  queue_init(&deps);
+  queue_init(&cached);
+  map_init(&seen, pool->nrels);
+  FOR_REPO_SOLVABLES(repo, p, s)
+    {
+      collect_deps(repo, &seen, &deps, s->requires);
+      collect_deps(repo, &seen, &deps, s->conflicts);
+      collect_deps(repo, &seen, &deps, s->obsoletes);
+      collect_deps(repo, &seen, &deps, s->recommends);
+      collect_deps(repo, &seen, &deps, s->suggests);
+      collect_deps(repo, &seen, &deps, s->supplements);
+      collect_deps(repo, &seen, &deps, s->enhances);
+    }
+  map_free(&seen);
+
+  for (i = 0; i < deps.count; i++)
+    {
+      d = deps.elements[i];
+      nwp = pool_whatprovides(pool, GETRELDEP(pool, d)->name);
+      wp = pool_whatprovides(pool, d);
+      pp = pool->whatprovidesdata + wp;
+      npp = pool->whatprovidesdata + nwp;
+      for (cnt = 0; pp[cnt] && pp[cnt] == npp[cnt]; cnt++)
+	;
+      if (!pp[cnt] && !npp[cnt])
+	{
+	  buf = addid(buf, &len, 0);
+	  queue_push(&cached, d);
+	  nsame++;
+	  continue;
+	}
+      for (cnt = 0; pp[cnt]; cnt++)
+	if (cnt && pp[cnt] <= pp[cnt - 1])
+	  break;
+      if (pp[cnt])
+	continue;	/* not sorted, can't store it */
+      buf = addid(buf, &len, cnt + 1);
+      for (last = 0; (p = *pp++) != 0; last = p)
+	buf = addid(buf, &len, p - last);
+      queue_push(&cached, d);
+    }
+  queue_free(&deps);
+
+  pool_relprovidercache_chksum(pool, chk);
+  data = repo_add_repodata(repo, flags);
+  repodata_set_idarray(data, SOLVID_META, REPOSITORY_RELPROVIDERS, &cached);
+  repodata_set_binary(data, SOLVID_META, REPOSITORY_RELPROVIDERS_DATA, buf, len);
+  repodata_set_bin_checksum(data, SOLVID_META, REPOSITORY_RELPROVIDERS_CHECKSUM, REPOKEY_TYPE_SHA256, chk);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "relprovidercache: stored %d dependencies (%d same as name), %d K data\n", cached.count, nsame, len / 1024);
+  queue_free(&cached);
+  solv_free(buf);
+  if (!(flags & REPO_NO_INTERNALIZE))
+    repodata_internalize(data);
+  return 0;
+}
+
+/* add the cached lists of one repository to the index */
+static int
+repo_apply_relprovidercache(Repo *repo)
+{
+  Pool *pool = repo->pool;
+  Queue deps, q;
+  const unsigned char *bin;
+  unsigned char *buf, *dp, *end;
+  Id d, x, p, wp;
+  int i, cnt, len, napplied = 0;
+
+  queue_init(&deps);
+  if (!repo_lookup_idarray(repo, SOLVID_META, REPOSITORY_RELPROVIDERS, &deps))
+    {
+      queue_free(&deps);
+      return 0;
+    }
+  bin = repo_lookup_binary(repo, SOLVID_META, REPOSITORY_RELPROVIDERS_DATA, &len);
+  if (!bin || !len || (bin[len - 1] & 0x80) != 0)
+    {
+      queue_free(&deps);
+      return 0;
+    }
+  /* copy the data, looking up providers may page in other data */
+  buf = solv_memdup(bin, len);
+  end = buf + len;
+  queue_init(&q);
+  for (i = 0, dp = buf; i < deps.count && dp < end; i++)
+    {
+      d = deps.elements[i];
+      dp = data_read_id(dp, &cnt);
+      queue_empty(&q);
+      for (p = 0; cnt > 1 && dp < end; cnt--)
+	{
+	  dp = data_read_id(dp, &x);
+	  if (x <= 0 || p + x >= pool->nsolvables)
+	    break;
+	  p += x;
+	  queue_push(&q, p);
+	}
+      if (cnt > 1)
+	break;		/* corrupt data */
+      if (!is_cacheable_rel(pool, d) || pool->whatprovides_rel[GETRELID(d)])
+	continue;
+      if (cnt)
+        wp = pool_queuetowhatprovides(pool, &q);
+      else
+        wp = pool_whatprovides(pool, GETRELDEP(pool, d)->name);
+      pool->whatprovides_rel[GETRELID(d)] = wp;
+      if (pool->whatprovidesoverlayoff && (Offset)wp >= pool->whatprovidesoverlayoff)
+	queue_push(&pool->whatprovidesoverlayq, d);
+      napplied++;
+    }
+  queue_free(&q);
+  queue_free(&deps);
+  solv_free(buf);
+  return napplied;
+}
+
+/*
+ * pool_apply_relprovidercache()
+ *
+ * called when the whatprovides index is created, and again by
+ * pool_addrelproviders if the added lists were dropped. Adds the
+ * cached providers of all repositories that were created with a pool
+ * of the same composition.
+ */
+void
+pool_apply_relprovidercache(Pool *pool)
+{
+  Repo *repo;
+  Id repoid, type;
+  const unsigned char *rchk;
+  unsigned char chk[32];
+  unsigned int now;
+  int napplied = 0, nrepos = 0;
+
+  pool->relprovidercachestate = 1;
+  now = solv_timems(0);
+  FOR_REPOS(repoid, repo)
+    {
+      rchk = repo_lookup_bin_checksum(repo, SOLVID_META, REPOSITORY_RELPROVIDERS_CHECKSUM, &type);
+      if (!rchk || type != REPOKEY_TYPE_SHA256)
+	continue;
+      memcpy(chk, rchk, 32);
+      if (!pool->relprovidercachechksum)
+	{
+	  pool->relprovidercachechksum = solv_calloc(1, 32);
+	  pool_relprovidercache_chksum(pool, pool->relprovidercachechksum);
+	  POOL_DEBUG(SOLV_DEBUG_STATS, "relprovidercache: pool checksum took %d ms\n", solv_timems(now));
+	}
+      if (memcmp(chk, pool->relprovidercachechksum, 32) != 0)
+	{
+	  POOL_DEBUG(SOLV_DEBUG_STATS, "relprovidercache: %s was created for a different pool\n", repo->name ? repo->name : "repo");
+	  continue;
+	}
+      napplied += repo_apply_relprovidercache(repo);
+      nrepos++;
+    }
+  if (nrepos)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "relprovidercache: added %d provider lists from %d repositories in %d ms\n", napplied, nrepos, solv_timems(now));
+}
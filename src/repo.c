@@ -40,7 +40,8 @@ repo_create(Pool *pool, const char *name)
 {
   Repo *repo;
 
-  pool_freewhatprovides(pool);
+  if (!pool->incrementalwhatprovides)
+    pool_freewhatprovides(pool);
   repo = (Repo *)solv_calloc(1, sizeof(*repo));
   if (!pool->nrepos)
     {
@@ -83,7 +84,8 @@ repo_empty(Repo *repo, int reuseids)
   Solvable *s;
   int i;
 
-  pool_freewhatprovides(pool);
+  if (!pool->incrementalwhatprovides)
+    pool_freewhatprovides(pool);
   if (reuseids && repo->end == pool->nsolvables)
     {
       /* it's ok to reuse the ids. As this is the last repo, we can
@@ -1644,3 +1646,15 @@ repo_disable_paging(Repo *repo)
     repodata_disable_paging(data);
 }
 
+/* like repo_disable_paging, but read and decompress the pages of
+ * the repodata with up to nthreads threads */
+void
+repo_disable_paging_threaded(Repo *repo, int nthreads)
+{
+  int i;
+  Repodata *data;
+
+  FOR_REPODATAS(repo, i, data)
+    repodata_disable_paging_threaded(data, nthreads);
+}
+
@@ -170,6 +170,8 @@ Repodata *repo_add_repodata(Repo *repo, int flags);
 Repodata *repo_id2repodata(Repo *repo, Id id);
 Repodata *repo_last_repodata(Repo *repo);
 
+int repo_add_relprovidercache(Repo *repo, int flags);
+
 void repo_search(Repo *repo, Id p, Id key, const char *match, int flags, int (*callback)(void *cbdata, Solvable *s, Repodata *data, Repokey *key, KeyValue *kv), void *cbdata);
 
 /* returns the last repodata that contains the key */
@@ -205,6 +207,7 @@ void repo_unset(Repo *repo, Id p, Id keyname);
 
 void repo_internalize(Repo *repo);
 void repo_disable_paging(Repo *repo);
+void repo_disable_paging_threaded(Repo *repo, int nthreads);
 Id *repo_create_keyskip(Repo *repo, Id entry, Id **oldkeyskip);
 
 
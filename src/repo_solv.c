@@ -18,6 +18,10 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "repo_solv.h"
 #include "util.h"
@@ -40,9 +44,39 @@
 
 
 /*******************************************************************************
- * functions to extract data from a file handle
+ * functions to extract data from a file handle or the mapped file
  */
 
+/*
+ * read a byte, returns EOF at the end of the file
+ */
+
+static inline int
+read_byte(Repodata *data)
+{
+  if (data->mapp)
+    return data->mapp < data->mapend ? *data->mapp++ : EOF;
+  return getc(data->fp);
+}
+
+/*
+ * read a block of bytes, returns 0 at the end of the file
+ */
+
+static int
+read_bytes(Repodata *data, void *buf, size_t len)
+{
+  if (data->mapp)
+    {
+      if ((size_t)(data->mapend - data->mapp) < len)
+	return 0;
+      memcpy(buf, data->mapp, len);
+      data->mapp += len;
+      return 1;
+    }
+  return fread(buf, len, 1, data->fp) == 1;
+}
+
 /*
  * read u32
  */
@@ -57,7 +91,7 @@ read_u32(Repodata *data)
     return 0;
   for (i = 0; i < 4; i++)
     {
-      c = getc(data->fp);
+      c = read_byte(data);
       if (c == EOF)
 	{
 	  data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -80,7 +114,7 @@ read_u8(Repodata *data)
 
   if (data->error)
     return 0;
-  c = getc(data->fp);
+  c = read_byte(data);
   if (c == EOF)
     {
       data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -104,7 +138,7 @@ read_id(Repodata *data, Id max)
     return 0;
   for (i = 0; i < 5; i++)
     {
-      c = getc(data->fp);
+      c = read_byte(data);
       if (c == EOF)
 	{
 	  data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -137,7 +171,7 @@ read_idarray(Repodata *data, Id max, Id *map, Id *store, Id *end)
     return 0;
   for (;;)
     {
-      c = getc(data->fp);
+      c = read_byte(data);
       if (c == EOF)
 	{
 	  data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -202,7 +236,7 @@ read_idarray_block(Repodata *data, Id *block, int size)
 	  if (!clen)
 	    clen = 65536;
 	  eof = flags & 0x80;
-	  if (fread(flags & 0x40 ? cbuf : bp, clen, 1, data->fp) != 1)
+	  if (!read_bytes(data, flags & 0x40 ? cbuf : bp, clen))
 	    {
 	      data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "unexpected EOF");
 	      return;
@@ -529,16 +563,29 @@ incore_add_u8(Repodata *data, unsigned int x)
 #endif
 
 
+/*
+ * continue with the file pointer after reading from the mapped file
+ */
+
+static void
+sync_mapped_fp(Repodata *data)
+{
+  if (fseeko(data->fp, -(off_t)(data->mapend - data->mapp), SEEK_END) != 0)
+    data->error = pool_error(data->repo->pool, SOLV_ERROR_EOF, "seek error after reading the mapped file");
+  data->mapp = data->mapend = 0;
+}
+
 /*******************************************************************************
  * our main function
  */
 
 /*
  * read repo from .solv file and add it to pool
+ * map/mapend is the rest of the file if it is mapped
  */
 
-int
-repo_add_solv(Repo *repo, FILE *fp, int flags)
+static int
+add_solv(Repo *repo, FILE *fp, int flags, const unsigned char *map, const unsigned char *mapend)
 {
   Pool *pool = repo->pool;
   int i, l;
@@ -604,6 +651,8 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
   memset(&data, 0, sizeof(data));
   data.repo = repo;
   data.fp = fp;
+  data.mapp = map;
+  data.mapend = mapend;
   repopagestore_init(&data.store);
 
   if (read_u32(&data) != ('S' << 24 | 'O' << 16 | 'L' << 8 | 'V'))
@@ -613,6 +662,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
     {
       case SOLV_VERSION_8:
       case SOLV_VERSION_9:
+      case SOLV_VERSION_10:
 	break;
       default:
         return pool_error(pool, SOLV_ERROR_UNSUPPORTED, "unsupported SOLV version");
@@ -659,7 +709,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
       if (userdatalen >= 65536)
         return pool_error(pool, SOLV_ERROR_CORRUPT, "illegal userdata length");
       while (userdatalen--)
-	if (getc(data.fp) == EOF)
+	if (read_byte(&data) == EOF)
 	  return pool_error(pool, SOLV_ERROR_EOF, "unexpected EOF");
     }
 
@@ -708,7 +758,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
   strsp = spool->stringspace + spool->sstrings;	/* append new entries */
   if ((solvflags & SOLV_FLAG_PREFIX_POOL) == 0)
     {
-      if (sizeid && fread(strsp, sizeid, 1, fp) != 1)
+      if (sizeid && !read_bytes(&data, strsp, sizeid))
 	{
 	  repodata_freedata(&data);
 	  return pool_error(pool, SOLV_ERROR_EOF, "read error while reading strings");
@@ -723,7 +773,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
       char *dest = strsp;
       int freesp = sizeid;
 
-      if (pfsize && fread(prefix, pfsize, 1, fp) != 1)
+      if (pfsize && !read_bytes(&data, prefix, pfsize))
 	{
 	  solv_free(prefix);
 	  repodata_freedata(&data);
@@ -1031,7 +1081,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
     l = DATA_READ_CHUNK;
   if (l > allsize)
     l = allsize;
-  if (!l || fread(buf, l, 1, data.fp) != 1)
+  if (!l || !read_bytes(&data, buf, l))
     {
       if (!data.error)
         data.error = pool_error(pool, SOLV_ERROR_EOF, "unexpected EOF");
@@ -1080,7 +1130,7 @@ repo_add_solv(Repo *repo, FILE *fp, int flags)
 		l = DATA_READ_CHUNK;
 	      if (l > allsize)
 		l = allsize;
-	      if (l && fread(buf + left, l, 1, data.fp) != 1)
+	      if (l && !read_bytes(&data, buf + left, l))
 		{
 		  data.error = pool_error(pool, SOLV_ERROR_EOF, "unexpected EOF");
 		  break;
@@ -1391,15 +1441,21 @@ printf("=> %s %s %p\n", pool_id2str(pool, keys[key].name), pool_id2str(pool, key
 	  }
       data.lastverticaloffset = fileoffset;
       pagesize = read_u32(&data);
+      if (!data.error && data.mapp)
+	sync_mapped_fp(&data);
       if (!data.error)
 	{
 	  data.error = repopagestore_read_or_setup_pages(&data.store, data.fp, pagesize, fileoffset);
+	  if (!data.error && (flags & SOLV_ADD_MMAP) != 0)
+	    repopagestore_map_pages(&data.store);
 	  if (data.error == SOLV_ERROR_EOF)
 	    pool_error(pool, data.error, "repopagestore setup: unexpected EOF");
 	  else if (data.error)
 	    pool_error(pool, data.error, "repopagestore setup failed");
 	}
     }
+  if (!data.error && data.mapp)
+    sync_mapped_fp(&data);
   data.fp = 0; /* no longer needed */
 
   if (data.error)
@@ -1458,6 +1514,39 @@ printf("=> %s %s %p\n", pool_id2str(pool, keys[key].name), pool_id2str(pool, key
   return 0;
 }
 
+/*
+ * with SOLV_ADD_MMAP the file is mapped and parsed from memory instead
+ * of being read through stdio, so that all processes share the page
+ * cache and no read buffers are filled. Not seekable files are read
+ * with stdio as usual.
+ */
+
+int
+repo_add_solv(Repo *repo, FILE *fp, int flags)
+{
+#ifndef _WIN32
+  if ((flags & SOLV_ADD_MMAP) != 0)
+    {
+      struct stat stb;
+      off_t start = ftello(fp);
+      unsigned char *map;
+      int ret;
+
+      if (start >= 0 && fstat(fileno(fp), &stb) == 0 && S_ISREG(stb.st_mode) && stb.st_size > start && (size_t)stb.st_size == stb.st_size)
+	{
+	  map = mmap(0, stb.st_size, PROT_READ, MAP_SHARED, fileno(fp), 0);
+	  if (map != MAP_FAILED)
+	    {
+	      ret = add_solv(repo, fp, flags, map + start, map + stb.st_size);
+	      munmap(map, stb.st_size);
+	      return ret;
+	    }
+	}
+    }
+#endif
+  return add_solv(repo, fp, flags, 0, 0);
+}
+
 int
 solv_read_userdata(FILE *fp, unsigned char **datap, int *lenp)
 {
@@ -1473,6 +1562,7 @@ solv_read_userdata(FILE *fp, unsigned char **datap, int *lenp)
     {
     case SOLV_VERSION_8:
     case SOLV_VERSION_9:
+    case SOLV_VERSION_10:
       break;
     default:
       return SOLV_ERROR_UNSUPPORTED;
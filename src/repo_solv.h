@@ -26,6 +26,7 @@ extern int repo_add_solv(Repo *repo, FILE *fp, int flags);
 extern int solv_read_userdata(FILE *fp, unsigned char **datap, int *lenp);
 
 #define SOLV_ADD_NO_STUBS	(1 << 8)
+#define SOLV_ADD_MMAP		(1 << 9)
 
 #ifdef __cplusplus
 }
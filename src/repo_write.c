@@ -1007,12 +1007,13 @@ traverse_dirs(Dirpool *dp, Id *dirmap, Id n, Id dir, Id *used)
 }
 
 static void
-write_compressed_page(Repodata *data, unsigned char *page, int len)
+write_compressed_page(Repodata *data, unsigned char *page, int len, int codec)
 {
-  int clen;
+  int clen = 0;
   unsigned char cpage[REPOPAGE_BLOBSIZE];
 
-  clen = repopagestore_compress_page(page, len, cpage, len - 1);
+  if (codec >= 0)
+    clen = repopagestore_compress_page_codec(page, len, cpage, len - 1, codec);
   if (!clen)
     {
       write_u32(data, len * 2);
@@ -1020,7 +1021,7 @@ write_compressed_page(Repodata *data, unsigned char *page, int len)
     }
   else
     {
-      write_u32(data, clen * 2 + 1);
+      write_u32(data, codec << 24 | (clen * 2 + 1));
       write_blob(data, cpage, clen);
     }
 }
@@ -1071,7 +1072,7 @@ repo_write_stdkeyfilter(Repo *repo, Repokey *key, void *kfdata)
 }
 
 static int
-write_compressed_extdata(Repodata *target, struct extdata *xd, unsigned char *vpage, int lpage)
+write_compressed_extdata(Repodata *target, struct extdata *xd, unsigned char *vpage, int lpage, int codec)
 {
   unsigned char *dp = xd->buf;
   int l = xd->len;
@@ -1086,7 +1087,7 @@ write_compressed_extdata(Repodata *target, struct extdata *xd, unsigned char *vp
       l -= ll;
       if (lpage == REPOPAGE_BLOBSIZE)
 	{
-	  write_compressed_page(target, vpage, lpage);
+	  write_compressed_page(target, vpage, lpage, codec);
 	  lpage = 0;
 	}
     }
@@ -2016,7 +2017,12 @@ for (i = 1; i < target.nkeys; i++)
 
   /* write file header */
   write_u32(&target, 'S' << 24 | 'O' << 16 | 'L' << 8 | 'V');
-  if ((solv_flags & (SOLV_FLAG_USERDATA | SOLV_FLAG_IDARRAYBLOCK)) != 0)
+  for (i = 1; i < target.nkeys; i++)
+    if (cbdata.extdata[i].len)
+      break;
+  if (i < target.nkeys && (writer->flags & (REPOWRITER_NO_PAGE_COMPRESSION | REPOWRITER_LZ4_PAGE_COMPRESSION)) == REPOWRITER_LZ4_PAGE_COMPRESSION)
+    write_u32(&target, SOLV_VERSION_10);	/* older versions do not know the page codecs */
+  else if ((solv_flags & (SOLV_FLAG_USERDATA | SOLV_FLAG_IDARRAYBLOCK)) != 0)
     write_u32(&target, SOLV_VERSION_9);
   else
     write_u32(&target, SOLV_VERSION_8);
@@ -2170,13 +2176,19 @@ for (i = 1; i < target.nkeys; i++)
       /* have vertical data, write it in pages */
       unsigned char vpage[REPOPAGE_BLOBSIZE];
       int lpage = 0;
+      int codec = REPOPAGE_CODEC_SOLV;
+
+      if ((writer->flags & REPOWRITER_NO_PAGE_COMPRESSION) != 0)
+	codec = -1;
+      else if ((writer->flags & REPOWRITER_LZ4_PAGE_COMPRESSION) != 0)
+	codec = REPOPAGE_CODEC_LZ4;
 
       write_u32(&target, REPOPAGE_BLOBSIZE);
       if (!cbdata.filelistmode)
 	{
 	  for (i = 1; i < target.nkeys; i++)
 	    if (cbdata.extdata[i].len)
-	      lpage = write_compressed_extdata(&target, cbdata.extdata + i, vpage, lpage);
+	      lpage = write_compressed_extdata(&target, cbdata.extdata + i, vpage, lpage, codec);
 	}
       else
 	{
@@ -2207,15 +2219,15 @@ for (i = 1; i < target.nkeys; i++)
 		}
 	      if (xd->len > 1024 * 1024)
 		{
-		  lpage = write_compressed_extdata(&target, xd, vpage, lpage);
+		  lpage = write_compressed_extdata(&target, xd, vpage, lpage, codec);
 		  xd->len = 0;
 		}
 	    }
 	  if (xd->len)
-	    lpage = write_compressed_extdata(&target, xd, vpage, lpage);
+	    lpage = write_compressed_extdata(&target, xd, vpage, lpage, codec);
 	}
       if (lpage)
-	write_compressed_page(&target, vpage, lpage);
+	write_compressed_page(&target, vpage, lpage, codec);
     }
 
   for (i = 1; i < target.nkeys; i++)
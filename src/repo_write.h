@@ -39,6 +39,8 @@ typedef struct s_Repowriter {
 /* repowriter flags */
 #define REPOWRITER_NO_STORAGE_SOLVABLE	(1 << 0)
 #define REPOWRITER_KEEP_TYPE_DELETED	(1 << 1)
+#define REPOWRITER_NO_PAGE_COMPRESSION	(1 << 2)	/* so that the pages can be mapped */
+#define REPOWRITER_LZ4_PAGE_COMPRESSION	(1 << 3)	/* faster to decompress, needs SOLV_VERSION_10 */
 #define REPOWRITER_LEGACY		(1 << 30)
 
 Repowriter *repowriter_create(Repo *repo);
@@ -494,8 +494,10 @@ get_vertical_data(Repodata *data, Repokey *key, Id off, Id len)
   /* we now have the offset, go into vertical */
   off += data->verticaloffset[key - data->keys];
   /* fprintf(stderr, "key %d page %d\n", key->name, off / REPOPAGE_BLOBSIZE); */
+  data->store.cachepages = data->repo->pool->pagecachesize / (REPOPAGE_BLOBSIZE / 1024);
   dp = repopagestore_load_page_range(&data->store, off / REPOPAGE_BLOBSIZE, (off + len - 1) / REPOPAGE_BLOBSIZE);
-  data->storestate++;
+  if (data->store.nmapped < data->store.num_pages)
+    data->storestate++;		/* pages may have been replaced */
   if (dp)
     dp += off % REPOPAGE_BLOBSIZE;
   return dp;
@@ -1786,6 +1788,8 @@ dataiterator_step(Dataiterator *di)
 	  if (di->key->storage == KEY_STORAGE_VERTICAL_OFFSET)
 	    {
 	      Id off, len;
+	      if (di->keyname && !(di->flags & SEARCH_THISSOLVID))
+		repopagestore_readahead(&di->data->store, REPOPAGE_READAHEAD);	/* sequential scan */
 	      di->dp = data_read_id(di->dp, &off);
 	      di->dp = data_read_id(di->dp, &len);
 	      di->vert_ddp = di->ddp = get_vertical_data(di->data, di->key, off, len);
@@ -3763,6 +3767,16 @@ repodata_disable_paging(Repodata *data)
     }
 }
 
+void
+repodata_disable_paging_threaded(Repodata *data, int nthreads)
+{
+  if (maybe_load_repodata(data, 0))
+    {
+      repopagestore_disable_paging_threaded(&data->store, nthreads);
+      data->storestate++;
+    }
+}
+
 /* call the pool's loadcallback to load a stub repodata */
 static void
 repodata_stub_loader(Repodata *data)
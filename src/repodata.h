@@ -92,6 +92,8 @@ struct s_Repodata {
 
 #ifdef LIBSOLV_INTERNAL
   FILE *fp;			/* file pointer of solv file */
+  const unsigned char *mapp;	/* read position in the mapped solv file */
+  const unsigned char *mapend;	/* end of the mapped solv file */
   int error;			/* corrupt solv file */
 
   int filelisttype;		/* type of filelist */
@@ -310,6 +312,8 @@ Repodata *repodata_create_stubs(Repodata *data);
  * load all paged data, used to speed up copying in repo_rpmdb
  */
 void repodata_disable_paging(Repodata *data);
+/* like repodata_disable_paging, use up to nthreads threads */
+void repodata_disable_paging_threaded(Repodata *data, int nthreads);
 
 /* helper functions */
 Id repodata_globalize_id(Repodata *data, Id id, int create);
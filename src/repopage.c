@@ -34,6 +34,13 @@
   #include <windows.h>
   #include <fileapi.h>
   #include <io.h>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+#ifdef ENABLE_THREADS
+#include <pthread.h>
 #endif
 
 #include "repo.h"
@@ -600,18 +607,198 @@ check_decompress_buf(const unsigned char *in, unsigned int in_len)
 
 /**********************************************************************/
 
+/*
+   The lz4 block format, used for REPOPAGE_CODEC_LZ4 pages. It needs
+   more space than the format above for text, but the decompression
+   copies whole runs instead of single bytes:
+
+   <token> [<literal length bytes>] <literals> <8o> <8o> [<match length bytes>]
+
+   The high nibble of the token is the literal length, the low nibble
+   the match length - 4, 15 means that more length bytes follow (added
+   up until a byte is not 255). The match is at offset -o. The last
+   sequence only has literals, it contains at least the last 5 bytes.
+*/
+
+#define LZ4_HASHBITS	12
+#define LZ4_MINMATCH	4
+
+static inline unsigned int
+lz4_read32(const unsigned char *p)
+{
+  uint32_t x;
+  memcpy(&x, p, 4);
+  return x;
+}
+
+static inline unsigned int
+lz4_hash(unsigned int x)
+{
+  return (x * 2654435761U) >> (32 - LZ4_HASHBITS);
+}
+
+static inline unsigned char *
+lz4_put_len(unsigned char *out, unsigned int l)
+{
+  for (; l >= 255; l -= 255)
+    *out++ = 255;
+  *out++ = l;
+  return out;
+}
+
+static unsigned int
+lz4_compress_buf(const unsigned char *in, unsigned int in_len,
+		 unsigned char *out, unsigned int out_len)
+{
+  uint32_t htab[1 << LZ4_HASHBITS];
+  unsigned char *op = out, *out_end = out + out_len, *token;
+  unsigned int io = 0, anchor = 0, ref, mlen, litlen, h;
+  /* a match must start 12 bytes and end 5 bytes before the end */
+  unsigned int mflimit = in_len > 12 ? in_len - 12 : 0;
+  unsigned int matchlimit = in_len > 5 ? in_len - 5 : 0;
+
+  memset(htab, -1, sizeof(htab));
+  while (io < mflimit)
+    {
+      unsigned int x = lz4_read32(in + io);
+      h = lz4_hash(x);
+      ref = htab[h];
+      htab[h] = io;
+      if (ref == (uint32_t)-1 || io - ref > 65535 || lz4_read32(in + ref) != x)
+	{
+	  io++;
+	  continue;
+	}
+      for (mlen = LZ4_MINMATCH; io + mlen < matchlimit && in[io + mlen] == in[ref + mlen]; mlen++)
+	;
+      while (io > anchor && ref > 0 && in[io - 1] == in[ref - 1])
+	io--, ref--, mlen++;
+      litlen = io - anchor;
+      if (op + 1 + litlen / 255 + 1 + litlen + 2 + (mlen - LZ4_MINMATCH) / 255 + 1 > out_end)
+	return 0;
+      token = op++;
+      *token = litlen >= 15 ? 15 << 4 : litlen << 4;
+      if (litlen >= 15)
+	op = lz4_put_len(op, litlen - 15);
+      memcpy(op, in + anchor, litlen);
+      op += litlen;
+      *op++ = io - ref;
+      *op++ = (io - ref) >> 8;
+      mlen -= LZ4_MINMATCH;
+      *token |= mlen >= 15 ? 15 : mlen;
+      if (mlen >= 15)
+	op = lz4_put_len(op, mlen - 15);
+      io += mlen + LZ4_MINMATCH;
+      anchor = io;
+      if (io - 2 < mflimit)
+	htab[lz4_hash(lz4_read32(in + io - 2))] = io - 2;
+    }
+  /* the last literals */
+  litlen = in_len - anchor;
+  if (op + 1 + litlen / 255 + 1 + litlen > out_end)
+    return 0;
+  token = op++;
+  *token = litlen >= 15 ? 15 << 4 : litlen << 4;
+  if (litlen >= 15)
+    op = lz4_put_len(op, litlen - 15);
+  memcpy(op, in + anchor, litlen);
+  op += litlen;
+  return op - out;
+}
+
+/* returns 0 if the data is corrupt or does not fit */
+static unsigned int
+lz4_decompress_buf(const unsigned char *in, unsigned int in_len,
+		   unsigned char *out, unsigned int out_len)
+{
+  const unsigned char *in_end = in + in_len, *m;
+  unsigned char *op = out, *out_end = out + out_len;
+  unsigned int token, l, o, c;
+
+  while (in < in_end)
+    {
+      token = *in++;
+      if ((l = token >> 4) == 15)
+	do
+	  {
+	    if (in == in_end)
+	      return 0;
+	    l += c = *in++;
+	  }
+	while (c == 255);
+      if (l <= 16 && in_end - in >= 16 && out_end - op >= 16)
+	memcpy(op, in, 16);	/* short run, copy a fixed size */
+      else if (l <= (unsigned int)(in_end - in) && l <= (unsigned int)(out_end - op))
+	memcpy(op, in, l);
+      else
+	return 0;
+      op += l;
+      in += l;
+      if (in == in_end)
+	break;		/* the last sequence has no match */
+      if (in_end - in < 2)
+	return 0;
+      o = in[0] | in[1] << 8;
+      in += 2;
+      if (!o || o > (unsigned int)(op - out))
+	return 0;
+      if ((l = token & 15) == 15)
+	do
+	  {
+	    if (in == in_end)
+	      return 0;
+	    l += c = *in++;
+	  }
+	while (c == 255);
+      l += LZ4_MINMATCH;
+      m = op - o;
+      if (o >= 16 && l <= 16 && out_end - op >= 16)
+	memcpy(op, m, 16);
+      else if (l > (unsigned int)(out_end - op))
+	return 0;
+      else if (o >= l)
+	memcpy(op, m, l);
+      else
+	for (c = 0; c < l; c++)
+	  op[c] = m[c];
+      op += l;
+    }
+  return op - out;
+}
+
+static unsigned int
+decompress_page(int codec, const unsigned char *in, unsigned int in_len,
+		unsigned char *out, unsigned int out_len)
+{
+  if (codec == REPOPAGE_CODEC_LZ4)
+    return lz4_decompress_buf(in, in_len, out, out_len);
+  return unchecked_decompress_buf(in, in_len, out, out_len);
+}
+
+/**********************************************************************/
+
 void repopagestore_init(Repopagestore *store)
 {
   memset(store, 0, sizeof(*store));
   store->pagefd = -1;
 }
 
+static void stop_prefetch(Repopagestore *store);
+
 void repopagestore_free(Repopagestore *store)
 {
+  if (store->prefetch)
+    stop_prefetch(store);	/* the thread uses the file */
   store->blob_store = solv_free(store->blob_store);
   store->file_pages = solv_free(store->file_pages);
   store->mapped_at = solv_free(store->mapped_at);
   store->mapped = solv_free(store->mapped);
+  store->lastused = solv_free(store->lastused);
+#ifndef _WIN32
+  if (store->filemap)
+    munmap(store->filemap, store->filemapsize);
+#endif
+  store->filemap = 0;
   if (store->pagefd != -1)
     close(store->pagefd);
   store->pagefd = -1;
@@ -620,6 +807,292 @@ void repopagestore_free(Repopagestore *store)
 
 /**********************************************************************/
 
+/* make room for nmapped pages in the blob store */
+static void
+grow_mapped(Repopagestore *store, unsigned int nmapped)
+{
+  unsigned int i, oldcan = store->nmapped;
+
+  store->nmapped = nmapped;
+  store->mapped = solv_realloc2(store->mapped, store->nmapped, sizeof(store->mapped[0]));
+  store->lastused = solv_realloc2(store->lastused, store->nmapped, sizeof(store->lastused[0]));
+  for (i = oldcan; i < store->nmapped; i++)
+    {
+      store->mapped[i] = -1;
+      store->lastused[i] = 0;
+    }
+  store->blob_store = solv_realloc2(store->blob_store, store->nmapped, REPOPAGE_BLOBSIZE);
+#ifdef DEBUG_PAGING
+  fprintf(stderr, "PAGE: can map %d pages\n", store->nmapped);
+#endif
+}
+
+/* read page pnum from the backing file into dest, buf is used for
+   compressed pages. Returns 0 on error. Only reads the store, so it
+   may be called by many threads for different pages.  */
+static int
+read_page(Repopagestore *store, unsigned int pnum, unsigned char *dest, unsigned char *buf)
+{
+  Attrblobpage *p = store->file_pages + pnum;
+  unsigned int in_len = p->page_size;
+  unsigned int compressed = in_len & 1;
+  const unsigned char *cp = buf;
+
+  in_len >>= 1;
+  if (store->filemap)
+    {
+      /* take the page from the mapped file */
+      cp = store->filemap + store->file_offset + p->page_offset;
+      if (!compressed)
+	memcpy(dest, cp, in_len);
+    }
+  else
+    {
+#ifndef _WIN32
+      if (pread(store->pagefd, compressed ? buf : dest, in_len, store->file_offset + p->page_offset) != in_len)
+	{
+	  perror("mapping pread");
+	  return 0;
+	}
+#else
+      DWORD read_len;
+      OVERLAPPED ovlp = {0};
+      ovlp.Offset = store->file_offset + p->page_offset;
+      if (!ReadFile((HANDLE) _get_osfhandle(store->pagefd), compressed ? buf : dest, in_len, &read_len, &ovlp) || read_len != in_len)
+	{
+	  perror("mapping ReadFile");
+	  return 0;
+	}
+#endif
+    }
+  if (compressed)
+    {
+      unsigned int out_len;
+      out_len = decompress_page(p->page_codec, cp, in_len, dest, REPOPAGE_BLOBSIZE);
+      if (out_len != (pnum < store->num_pages - 1 ? REPOPAGE_BLOBSIZE : store->last_page_len))
+	{
+#ifdef DEBUG_PAGING
+	  fprintf(stderr, "can't decompress page %d\n", pnum);
+#endif
+	  return 0;
+	}
+#ifdef DEBUG_PAGING
+      fprintf(stderr, "PAGE: expand %d to %d\n", in_len, out_len);
+#endif
+    }
+  return 1;
+}
+
+/**********************************************************************/
+
+/*
+ * Page prefetching for sequential scans. After a readahead hint the
+ * next pages are read and decompressed by a background thread into
+ * slots of its own while the current page is used. A page miss then
+ * just copies the prefetched page. The hint is dropped as soon as
+ * the access is no longer sequential.
+ */
+
+#ifdef ENABLE_THREADS
+
+#define PREFETCH_FREE		0
+#define PREFETCH_QUEUED		1
+#define PREFETCH_LOADING	2
+#define PREFETCH_DONE		3
+#define PREFETCH_FAILED		4
+
+struct s_Repopageprefetch {
+  Repopagestore file;		/* copy of the store for read_page, the
+				   store moves if the repodata array grows */
+  pthread_t tid;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;		/* new work or a finished page */
+  int quit;
+  unsigned int nslots;
+  unsigned int *page;		/* the page in the slot */
+  unsigned char *state;		/* PREFETCH_xxx */
+  unsigned char *buf;		/* nslots pages */
+};
+
+static void *
+prefetch_thread(void *arg)
+{
+  struct s_Repopageprefetch *pf = arg;
+  unsigned char buf[REPOPAGE_BLOBSIZE];
+  unsigned int i, best;
+  int ok;
+
+  pthread_mutex_lock(&pf->lock);
+  while (!pf->quit)
+    {
+      /* load the queued page with the lowest number first */
+      for (i = 0, best = pf->nslots; i < pf->nslots; i++)
+	if (pf->state[i] == PREFETCH_QUEUED && (best == pf->nslots || pf->page[i] < pf->page[best]))
+	  best = i;
+      if (best == pf->nslots)
+	{
+	  pthread_cond_wait(&pf->cond, &pf->lock);
+	  continue;
+	}
+      pf->state[best] = PREFETCH_LOADING;
+      pthread_mutex_unlock(&pf->lock);
+      ok = read_page(&pf->file, pf->page[best], pf->buf + best * REPOPAGE_BLOBSIZE, buf);
+      pthread_mutex_lock(&pf->lock);
+      pf->state[best] = ok ? PREFETCH_DONE : PREFETCH_FAILED;
+      pthread_cond_broadcast(&pf->cond);
+    }
+  pthread_mutex_unlock(&pf->lock);
+  return 0;
+}
+
+static struct s_Repopageprefetch *
+start_prefetch(Repopagestore *store)
+{
+  struct s_Repopageprefetch *pf = solv_calloc(1, sizeof(*pf));
+  pf->file = *store;
+  pf->nslots = store->readahead;
+  pf->page = solv_calloc(pf->nslots, sizeof(*pf->page));
+  pf->state = solv_calloc(pf->nslots, 1);
+  pf->buf = solv_malloc2(pf->nslots, REPOPAGE_BLOBSIZE);
+  pthread_mutex_init(&pf->lock, 0);
+  pthread_cond_init(&pf->cond, 0);
+  if (pthread_create(&pf->tid, 0, prefetch_thread, pf) != 0)
+    {
+      pf->quit = 1;	/* no thread, do not try again */
+      pf->nslots = 0;
+    }
+  store->prefetch = pf;
+  return pf;
+}
+
+static void
+stop_prefetch(Repopagestore *store)
+{
+  struct s_Repopageprefetch *pf = store->prefetch;
+  if (!pf->quit)
+    {
+      pthread_mutex_lock(&pf->lock);
+      pf->quit = 1;
+      pthread_cond_broadcast(&pf->cond);
+      pthread_mutex_unlock(&pf->lock);
+      pthread_join(pf->tid, 0);
+    }
+  pthread_cond_destroy(&pf->cond);
+  pthread_mutex_destroy(&pf->lock);
+  solv_free(pf->page);
+  solv_free(pf->state);
+  solv_free(pf->buf);
+  store->prefetch = solv_free(pf);
+}
+
+/* queue the pages after pend, drop the pages before pstart */
+static void
+queue_prefetch(Repopagestore *store, unsigned int pstart, unsigned int pend)
+{
+  struct s_Repopageprefetch *pf = store->prefetch;
+  unsigned int i, pnum, queued = 0;
+
+  if (!pf)
+    pf = start_prefetch(store);
+  if (!pf->nslots)
+    return;
+  pthread_mutex_lock(&pf->lock);
+  for (i = 0; i < pf->nslots; i++)
+    if ((pf->state[i] == PREFETCH_DONE || pf->state[i] == PREFETCH_FAILED || pf->state[i] == PREFETCH_QUEUED) && pf->page[i] < pstart)
+      pf->state[i] = PREFETCH_FREE;
+  for (pnum = pend + 1; pnum <= pend + pf->nslots && pnum < store->num_pages; pnum++)
+    {
+      if (store->mapped_at[pnum] != -1)
+	continue;
+      for (i = 0; i < pf->nslots; i++)
+	if (pf->state[i] != PREFETCH_FREE && pf->page[i] == pnum)
+	  break;
+      if (i < pf->nslots)
+	continue;	/* already there */
+      for (i = 0; i < pf->nslots; i++)
+	if (pf->state[i] == PREFETCH_FREE)
+	  break;
+      if (i == pf->nslots)
+	break;		/* no free slot */
+      pf->page[i] = pnum;
+      pf->state[i] = PREFETCH_QUEUED;
+      queued++;
+    }
+  if (queued)
+    pthread_cond_signal(&pf->cond);
+  pthread_mutex_unlock(&pf->lock);
+}
+
+/* copy a prefetched page to dest, returns 0 if it was not prefetched */
+static int
+get_prefetched(Repopagestore *store, unsigned int pnum, unsigned char *dest)
+{
+  struct s_Repopageprefetch *pf = store->prefetch;
+  unsigned int i;
+  int ok = 0;
+
+  pthread_mutex_lock(&pf->lock);
+  for (i = 0; i < pf->nslots; i++)
+    if (pf->state[i] != PREFETCH_FREE && pf->page[i] == pnum)
+      break;
+  if (i < pf->nslots)
+    {
+      while (pf->state[i] == PREFETCH_LOADING)
+	pthread_cond_wait(&pf->cond, &pf->lock);
+      if (pf->state[i] == PREFETCH_DONE)
+	{
+	  memcpy(dest, pf->buf + i * REPOPAGE_BLOBSIZE, REPOPAGE_BLOBSIZE);
+	  ok = 1;
+	}
+      pf->state[i] = PREFETCH_FREE;	/* also if still queued, we read it ourself */
+    }
+  pthread_mutex_unlock(&pf->lock);
+  return ok;
+}
+
+#else
+
+static void
+stop_prefetch(Repopagestore *store)
+{
+}
+
+#endif
+
+/* see if the access is still sequential, prefetch the next pages */
+static void
+check_readahead(Repopagestore *store, unsigned int pstart, unsigned int pend)
+{
+  if (store->lastpage != -1 && pstart != store->lastpage && pstart != store->lastpage + 1)
+    {
+      store->readahead = 0;	/* not sequential, drop the hint */
+      return;
+    }
+  if (pend == store->lastpage)
+    return;
+  store->lastpage = pend;
+#ifdef ENABLE_THREADS
+  queue_prefetch(store, pstart, pend);
+#endif
+}
+
+void
+repopagestore_readahead(Repopagestore *store, unsigned int npages)
+{
+  /* nothing to do if all pages are loaded. This also keeps lookups in
+     frozen pools from writing to the store */
+  if (store->readahead == npages || store->nmapped >= store->num_pages || store->pagefd == -1 || !store->file_pages)
+    return;
+#ifdef ENABLE_THREADS
+  if (store->prefetch && store->prefetch->nslots && npages > store->prefetch->nslots)
+    npages = store->prefetch->nslots;	/* keep the slots of the running thread */
+#else
+  npages = 0;	/* no prefetching without threads */
+#endif
+  store->readahead = npages;
+  store->lastpage = -1;
+}
+
 unsigned char *
 repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigned int pend)
 {
@@ -628,11 +1101,22 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
   unsigned char buf[REPOPAGE_BLOBSIZE];
   unsigned int i, best, pnum;
 
+  if (store->readahead)
+    check_readahead(store, pstart, pend);
   if (pstart == pend)
     {
       /* Quick check in case the requested page is already mapped */
       if (store->mapped_at[pstart] != -1)
-	return store->blob_store + store->mapped_at[pstart];
+	{
+	  /* no need to stamp if all pages fit, this also keeps lookups
+	     in frozen pools from writing to the store */
+	  if (store->lastused && store->nmapped < store->num_pages)
+	    store->lastused[store->mapped_at[pstart] / REPOPAGE_BLOBSIZE] = ++store->lru_counter;
+	  return store->blob_store + store->mapped_at[pstart];
+	}
+      /* uncompressed pages of a mapped file can be used in place */
+      if (store->filemap && (store->file_pages[pstart].page_size & 1) == 0)
+	return store->filemap + store->file_offset + store->file_pages[pstart].page_offset;
     }
   else
     {
@@ -656,21 +1140,29 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 
   /* Ensure that we can map the numbers of pages we need at all.  */
   if (pend - pstart + 1 > store->nmapped)
+    grow_mapped(store, pend - pstart + 1 < 4 ? 4 : pend - pstart + 1);
+
+  if (pstart == pend)
     {
-      unsigned int oldcan = store->nmapped;
-      store->nmapped = pend - pstart + 1;
-      if (store->nmapped < 4)
-        store->nmapped = 4;
-      store->mapped = solv_realloc2(store->mapped, store->nmapped, sizeof(store->mapped[0]));
-      for (i = oldcan; i < store->nmapped; i++)
-	store->mapped[i] = -1;
-      store->blob_store = solv_realloc2(store->blob_store, store->nmapped, REPOPAGE_BLOBSIZE);
-#ifdef DEBUG_PAGING
-      fprintf(stderr, "PAGE: can map %d pages\n", store->nmapped);
-#endif
+      /* use a free or the least recently used page */
+      for (i = best = 0; i < store->nmapped; i++)
+	{
+	  if (store->mapped[i] == -1)
+	    {
+	      best = i;
+	      break;
+	    }
+	  if (store->lastused[i] < store->lastused[best])
+	    best = i;
+	}
+      if (i == store->nmapped && store->nmapped < store->cachepages)
+	{
+	  /* all pages are in use but the cache may grow */
+	  best = store->nmapped;
+	  grow_mapped(store, best * 2 < store->cachepages ? best * 2 : store->cachepages);
+	}
     }
-
-  if (store->mapped_at[pstart] != -1)
+  else if (store->mapped_at[pstart] != -1)
     {
       /* assume forward search */
       best = store->mapped_at[pstart] / REPOPAGE_BLOBSIZE;
@@ -744,50 +1236,18 @@ repopagestore_load_page_range(Repopagestore *store, unsigned int pstart, unsigne
 	}
       else
         {
-	  Attrblobpage *p = store->file_pages + pnum;
-	  unsigned int in_len = p->page_size;
-	  unsigned int compressed = in_len & 1;
-	  in_len >>= 1;
-#ifdef DEBUG_PAGING
-	  fprintf(stderr, "PAGEIN: %d to %d", pnum, i);
-#endif
-#ifndef _WIN32
-          if (pread(store->pagefd, compressed ? buf : dest, in_len, store->file_offset + p->page_offset) != in_len)
-	    {
-	      perror("mapping pread");
-	      return 0;
-	    }
-#else
-	  DWORD read_len;
-	  OVERLAPPED ovlp = {0};
-	  ovlp.Offset = store->file_offset + p->page_offset;
-	  if (!ReadFile((HANDLE) _get_osfhandle(store->pagefd), compressed ? buf : dest, in_len, &read_len, &ovlp) || read_len != in_len)
-	  {
-	  	perror("mapping ReadFile");
-	  	return 0;
-	  }
-#endif
-	  if (compressed)
-	    {
-	      unsigned int out_len;
-	      out_len = unchecked_decompress_buf(buf, in_len, dest, REPOPAGE_BLOBSIZE);
-	      if (out_len != REPOPAGE_BLOBSIZE && pnum < store->num_pages - 1)
-	        {
 #ifdef DEBUG_PAGING
-	          fprintf(stderr, "can't decompress\n");
+	  fprintf(stderr, "PAGEIN: %d to %d\n", pnum, i);
 #endif
-		  return 0;
-		}
-#ifdef DEBUG_PAGING
-	      fprintf(stderr, " (expand %d to %d)", in_len, out_len);
-#endif
-	    }
-#ifdef DEBUG_PAGING
-	  fprintf(stderr, "\n");
+#ifdef ENABLE_THREADS
+	  if (!store->prefetch || !get_prefetched(store, pnum, dest))
 #endif
+	  if (!read_page(store, pnum, dest, buf))
+	    return 0;
 	}
       store->mapped_at[pnum] = i * REPOPAGE_BLOBSIZE;
       store->mapped[i] = pnum;
+      store->lastused[i] = ++store->lru_counter;
     }
   return store->blob_store + best * REPOPAGE_BLOBSIZE;
 }
@@ -798,6 +1258,14 @@ repopagestore_compress_page(unsigned char *page, unsigned int len, unsigned char
   return compress_buf(page, len, cpage, max);
 }
 
+unsigned int
+repopagestore_compress_page_codec(unsigned char *page, unsigned int len, unsigned char *cpage, unsigned int max, int codec)
+{
+  if (codec == REPOPAGE_CODEC_LZ4)
+    return lz4_compress_buf(page, len, cpage, max);
+  return codec == REPOPAGE_CODEC_SOLV ? compress_buf(page, len, cpage, max) : 0;
+}
+
 unsigned int
 repopagestore_decompress_page(const unsigned char *cpage, unsigned int len, unsigned char *page, unsigned int max)
 {
@@ -861,6 +1329,7 @@ repopagestore_read_or_setup_pages(Repopagestore *store, FILE *fp, unsigned int p
   npages = (blobsz + REPOPAGE_BLOBSIZE - 1) / REPOPAGE_BLOBSIZE;
 
   store->num_pages = npages;
+  store->last_page_len = npages ? blobsz - (npages - 1) * REPOPAGE_BLOBSIZE : 0;
   store->mapped_at = solv_malloc2(npages, sizeof(*store->mapped_at));
 
   /* If we can't seek on our input we have to slurp in everything.
@@ -874,12 +1343,15 @@ repopagestore_read_or_setup_pages(Repopagestore *store, FILE *fp, unsigned int p
   for (i = 0; i < npages; i++)
     {
       unsigned int in_len = read_u32(fp);
+      unsigned int codec = in_len >> 24;
       unsigned int compressed = in_len & 1;
-      in_len >>= 1;
+      in_len = (in_len & 0xffffff) >> 1;
 #ifdef DEBUG_PAGING
-      fprintf(stderr, "page %d: len %d (%scompressed)\n",
-      	       i, in_len, compressed ? "" : "not ");
+      fprintf(stderr, "page %d: len %d (%scompressed, codec %d)\n",
+      	       i, in_len, compressed ? "" : "not ", codec);
 #endif
+      if (in_len > REPOPAGE_BLOBSIZE || codec > REPOPAGE_CODEC_LZ4 || (codec && !compressed))
+	return SOLV_ERROR_CORRUPT;
       if (can_seek)
         {
 	  Attrblobpage *p = store->file_pages + i;
@@ -887,6 +1359,7 @@ repopagestore_read_or_setup_pages(Repopagestore *store, FILE *fp, unsigned int p
           store->mapped_at[i] = -1;	/* not mapped yet */
 	  p->page_offset = cur_page_ofs;
 	  p->page_size = in_len * 2 + compressed;
+	  p->page_codec = codec;
 	  if (fseek(fp, in_len, SEEK_CUR) < 0)
 	    {
 	      /* We can't fall back to non-seeking behaviour as we already
@@ -910,17 +1383,64 @@ repopagestore_read_or_setup_pages(Repopagestore *store, FILE *fp, unsigned int p
 	    }
 	  if (compressed)
 	    {
-	      out_len = unchecked_decompress_buf(buf, in_len, dest, REPOPAGE_BLOBSIZE);
-	      if (out_len != REPOPAGE_BLOBSIZE && i < npages - 1)
+	      out_len = decompress_page(codec, buf, in_len, dest, REPOPAGE_BLOBSIZE);
+	      if (out_len != (i < npages - 1 ? REPOPAGE_BLOBSIZE : store->last_page_len))
 	        {
 		  return SOLV_ERROR_CORRUPT;
 	        }
 	    }
 	}
     }
+#ifndef _WIN32
+  if (can_seek)
+    {
+      /* seeking does not notice a truncated file */
+      struct stat stb;
+      if (fstat(store->pagefd, &stb) == 0 && S_ISREG(stb.st_mode) && stb.st_size < store->file_offset + cur_page_ofs)
+	{
+	  close(store->pagefd);
+	  store->pagefd = -1;
+	  return SOLV_ERROR_EOF;
+	}
+    }
+#endif
   return 0;
 }
 
+/* Map the pages of the backing file. Uncompressed pages are then used
+   in place and shared with all processes using the file, compressed
+   pages are decompressed from the mapping. Returns 1 if the pages
+   are mapped.  */
+int
+repopagestore_map_pages(Repopagestore *store)
+{
+#ifndef _WIN32
+  unsigned int i;
+  Attrblobpage *p;
+  struct stat stb;
+  size_t size;
+  void *map;
+
+  if (store->pagefd == -1 || !store->file_pages || !store->num_pages || store->filemap)
+    return 0;
+  /* only the last page may be shorter, we return pointers to full pages */
+  for (i = 0, p = store->file_pages; i < store->num_pages - 1; i++, p++)
+    if ((p->page_size & 1) == 0 && p->page_size / 2 != REPOPAGE_BLOBSIZE)
+      return 0;
+  size = store->file_offset + p->page_offset + p->page_size / 2;
+  if (fstat(store->pagefd, &stb) || (size_t)stb.st_size < size)
+    return 0;
+  map = mmap(0, size, PROT_READ, MAP_SHARED, store->pagefd, 0);
+  if (map == MAP_FAILED)
+    return 0;
+  store->filemap = map;
+  store->filemapsize = size;
+  return 1;
+#else
+  return 0;
+#endif
+}
+
 void
 repopagestore_disable_paging(Repopagestore *store)
 {
@@ -928,6 +1448,77 @@ repopagestore_disable_paging(Repopagestore *store)
     repopagestore_load_page_range(store, 0, store->num_pages - 1);
 }
 
+#define PAGES_THREAD_MIN	16	/* less is not worth a thread */
+
+struct page_threads {
+  Repopagestore *store;
+  int nthreads;
+};
+
+static void
+page_thread_load(void *data, int idx)
+{
+  struct page_threads *pt = data;
+  Repopagestore *store = pt->store;
+  unsigned int chunk = (store->num_pages + pt->nthreads - 1) / pt->nthreads;
+  unsigned int pnum = idx * chunk, pend = pnum + chunk;
+  unsigned char buf[REPOPAGE_BLOBSIZE];
+
+  if (pend > store->num_pages)
+    pend = store->num_pages;
+  for (; pnum < pend; pnum++)
+    if (store->mapped_at[pnum] == -1 && read_page(store, pnum, store->blob_store + pnum * REPOPAGE_BLOBSIZE, buf))
+      store->mapped_at[pnum] = pnum * REPOPAGE_BLOBSIZE;
+}
+
+/*
+ * like repopagestore_disable_paging, but the pages are read and
+ * decompressed by up to nthreads threads. Every page goes directly to
+ * its final slot in the blob store, so the threads do not share any
+ * data. Pages that could not be read stay unloaded.
+ */
+void
+repopagestore_disable_paging_threaded(Repopagestore *store, int nthreads)
+{
+  struct page_threads pt;
+  unsigned char *blob_store;
+  unsigned int i, pnum;
+
+  if (nthreads > store->num_pages / PAGES_THREAD_MIN)
+    nthreads = store->num_pages / PAGES_THREAD_MIN;
+  if (nthreads <= 1 || store->pagefd == -1 || !store->file_pages)
+    {
+      repopagestore_disable_paging(store);
+      return;
+    }
+#ifdef DEBUG_PAGING
+  fprintf(stderr, "PAGE: loading %d pages with %d threads\n", store->num_pages, nthreads);
+#endif
+  /* move the loaded pages to their final slot */
+  blob_store = solv_malloc2(store->num_pages, REPOPAGE_BLOBSIZE);
+  for (pnum = 0; pnum < store->num_pages; pnum++)
+    if (store->mapped_at[pnum] != -1)
+      {
+	memcpy(blob_store + pnum * REPOPAGE_BLOBSIZE, store->blob_store + store->mapped_at[pnum], REPOPAGE_BLOBSIZE);
+	store->mapped_at[pnum] = pnum * REPOPAGE_BLOBSIZE;
+      }
+  solv_free(store->blob_store);
+  store->blob_store = blob_store;
+
+  pt.store = store;
+  pt.nthreads = nthreads;
+  solv_runthreads(nthreads, page_thread_load, &pt);
+
+  store->nmapped = store->num_pages;
+  store->mapped = solv_realloc2(store->mapped, store->nmapped, sizeof(store->mapped[0]));
+  store->lastused = solv_realloc2(store->lastused, store->nmapped, sizeof(store->lastused[0]));
+  for (i = 0; i < store->nmapped; i++)
+    {
+      store->mapped[i] = store->mapped_at[i] != -1 ? i : -1;
+      store->lastused[i] = 0;
+    }
+}
+
 #ifdef STANDALONE
 
 static void
@@ -984,107 +1575,78 @@ transfer_file(FILE * from, FILE * to, int compress)
     }
 }
 
-/* Just for benchmarking purposes.  */
-static void
-dumb_memcpy(void *dest, const void *src, unsigned int len)
+/* Just for benchmarking purposes: compress the input in pages with
+   every codec, check the round trip and print ratio and speed.  */
+
+static double
+elapsed(clock_t start)
 {
-  char *d = dest;
-  const char *s = src;
-  while (len--)
-    *d++ = *s++;
+  return (clock() - start) / (double)CLOCKS_PER_SEC;
 }
 
 static void
 benchmark(FILE * from)
 {
-  unsigned char inb[BLOCK_SIZE];
-  unsigned char outb[BLOCK_SIZE];
-  unsigned int in_len = fread(inb, 1, BLOCK_SIZE, from);
-  unsigned int out_len;
-  if (!in_len)
-    {
-      perror("can't read from input");
-      exit(1);
-    }
-
-  unsigned int calib_loop;
-  unsigned int per_loop;
-  unsigned int i, j;
-  clock_t start, end;
-  float seconds;
+  static const char *codecnames[] = { "solv", "lz4" };
+  unsigned char *inb = 0, *cb, *outb;
+  unsigned int *clens;
+  size_t len = 0, l, clen;
+  unsigned int npages, i, r, rounds, pl;
+  int codec;
+  clock_t start;
+  double csecs, dsecs, mb;
 
-#if 0
-  calib_loop = 1;
-  per_loop = 0;
-  start = clock();
-  while ((clock() - start) < CLOCKS_PER_SEC / 4)
+  for (;;)
     {
-      calib_loop *= 2;
-      for (i = 0; i < calib_loop; i++)
-	dumb_memcpy(outb, inb, in_len);
-      per_loop += calib_loop;
+      inb = solv_realloc(inb, len + BLOCK_SIZE);
+      if (!(l = fread(inb + len, 1, BLOCK_SIZE, from)))
+	break;
+      len += l;
     }
-
-  fprintf(stderr, "memcpy:\nCalibrated to %d iterations per loop\n",
-	   per_loop);
-
-  start = clock();
-  for (i = 0; i < 10; i++)
-    for (j = 0; j < per_loop; j++)
-      dumb_memcpy(outb, inb, in_len);
-  end = clock();
-  seconds = (end - start) / (float) CLOCKS_PER_SEC;
-  fprintf(stderr, "%.2f seconds == %.2f MB/s\n", seconds,
-	   ((long long) in_len * per_loop * 10) / (1024 * 1024 * seconds));
-#endif
-
-  calib_loop = 1;
-  per_loop = 0;
-  start = clock();
-  while ((clock() - start) < CLOCKS_PER_SEC / 4)
+  if (!len)
     {
-      calib_loop *= 2;
-      for (i = 0; i < calib_loop; i++)
-	compress_buf(inb, in_len, outb, sizeof(outb));
-      per_loop += calib_loop;
+      perror("can't read from input");
+      exit(1);
     }
-
-  fprintf(stderr, "compression:\nCalibrated to %d iterations per loop\n",
-	   per_loop);
-
-  start = clock();
-  for (i = 0; i < 10; i++)
-    for (j = 0; j < per_loop; j++)
-      compress_buf(inb, in_len, outb, sizeof(outb));
-  end = clock();
-  seconds = (end - start) / (float) CLOCKS_PER_SEC;
-  fprintf(stderr, "%.2f seconds == %.2f MB/s\n", seconds,
-	   ((long long) in_len * per_loop * 10) / (1024 * 1024 * seconds));
-
-  out_len = compress_buf(inb, in_len, outb, sizeof(outb));
-
-  calib_loop = 1;
-  per_loop = 0;
-  start = clock();
-  while ((clock() - start) < CLOCKS_PER_SEC / 4)
+  npages = (len + REPOPAGE_BLOBSIZE - 1) / REPOPAGE_BLOBSIZE;
+  cb = solv_malloc2(npages, REPOPAGE_BLOBSIZE);
+  outb = solv_malloc2(npages, REPOPAGE_BLOBSIZE);
+  clens = solv_calloc(npages, sizeof(*clens));
+  /* work on about 64M per measurement */
+  rounds = 1 + (64 << 20) / len;
+  mb = (double)len * rounds / (1 << 20);
+  printf("%zu bytes in %u pages, %u rounds\n", len, npages, rounds);
+  printf("codec   ratio    compress   decompress\n");
+  for (codec = REPOPAGE_CODEC_SOLV; codec <= REPOPAGE_CODEC_LZ4; codec++)
     {
-      calib_loop *= 2;
-      for (i = 0; i < calib_loop; i++)
-	unchecked_decompress_buf(outb, out_len, inb, sizeof(inb));
-      per_loop += calib_loop;
+      start = clock();
+      for (r = 0; r < rounds; r++)
+	for (i = 0; i < npages; i++)
+	  {
+	    pl = i < npages - 1 ? REPOPAGE_BLOBSIZE : len - (size_t)i * REPOPAGE_BLOBSIZE;
+	    clens[i] = repopagestore_compress_page_codec(inb + (size_t)i * REPOPAGE_BLOBSIZE, pl, cb + (size_t)i * REPOPAGE_BLOBSIZE, pl - 1, codec);
+	  }
+      csecs = elapsed(start);
+      start = clock();
+      for (r = 0; r < rounds; r++)
+	for (i = 0; i < npages; i++)
+	  {
+	    pl = i < npages - 1 ? REPOPAGE_BLOBSIZE : len - (size_t)i * REPOPAGE_BLOBSIZE;
+	    if (clens[i])
+	      decompress_page(codec, cb + (size_t)i * REPOPAGE_BLOBSIZE, clens[i], outb + (size_t)i * REPOPAGE_BLOBSIZE, REPOPAGE_BLOBSIZE);
+	    else	/* stored uncompressed */
+	      memcpy(outb + (size_t)i * REPOPAGE_BLOBSIZE, inb + (size_t)i * REPOPAGE_BLOBSIZE, pl);
+	  }
+      dsecs = elapsed(start);
+      for (i = 0, clen = 0; i < npages; i++)
+	clen += clens[i] ? clens[i] : (i < npages - 1 ? REPOPAGE_BLOBSIZE : len - (size_t)i * REPOPAGE_BLOBSIZE);
+      printf("%-6s %6.3f %7.1f MB/s %7.1f MB/s%s\n", codecnames[codec], (double)clen / len,
+	     mb / csecs, mb / dsecs, memcmp(inb, outb, len) ? "  ROUND TRIP FAILED" : "");
     }
-
-  fprintf(stderr, "decompression:\nCalibrated to %d iterations per loop\n",
-	   per_loop);
-
-  start = clock();
-  for (i = 0; i < 10; i++)
-    for (j = 0; j < per_loop; j++)
-      unchecked_decompress_buf(outb, out_len, inb, sizeof(inb));
-  end = clock();
-  seconds = (end - start) / (float) CLOCKS_PER_SEC;
-  fprintf(stderr, "%.2f seconds == %.2f MB/s\n", seconds,
-	   ((long long) in_len * per_loop * 10) / (1024 * 1024 * seconds));
+  solv_free(clens);
+  solv_free(outb);
+  solv_free(cb);
+  solv_free(inb);
 }
 
 int
@@ -1094,7 +1656,15 @@ main(int argc, char *argv[])
   if (argc > 1 && !strcmp(argv[1], "-d"))
     compress = 0;
   if (argc > 1 && !strcmp(argv[1], "-b"))
-    benchmark(stdin);
+    {
+      FILE *fp = argc > 2 ? fopen(argv[2], "r") : stdin;
+      if (!fp)
+	{
+	  perror(argv[2]);
+	  exit(1);
+	}
+      benchmark(fp);
+    }
   else
     transfer_file(stdin, stdout, compress);
   return 0;
@@ -11,13 +11,20 @@
 #define REPOPAGE_BLOBBITS 15
 #define REPOPAGE_BLOBSIZE (1 << REPOPAGE_BLOBBITS)
 
+/* page compression codecs, stored in the top byte of the page length */
+#define REPOPAGE_CODEC_SOLV	0	/* the byte based libsolv format */
+#define REPOPAGE_CODEC_LZ4	1	/* lz4 block format, faster to decompress */
+
+#define REPOPAGE_READAHEAD	4	/* pages to prefetch for sequential scans */
+
 typedef struct s_Attrblobpage
 {
   /* page_size == 0 means the page is not backed by some file storage.
      Otherwise it is L*2+(compressed ? 1 : 0), with L being the data
-     length.  */
+     length.  page_codec is the codec of a compressed page.  */
   unsigned int page_offset;
   unsigned int page_size;
+  unsigned int page_codec;
 } Attrblobpage;
 
 typedef struct s_Repopagestore {
@@ -26,6 +33,7 @@ typedef struct s_Repopagestore {
 
   unsigned char *blob_store;
   unsigned int num_pages;
+  unsigned int last_page_len;	/* uncompressed length of the last page */
 
   /* mapped_at[page] == -1  --> not loaded, otherwise offset into
      store->blob_store.  The size of the mapping is REPOPAGE_BLOBSIZE
@@ -39,6 +47,17 @@ typedef struct s_Repopagestore {
   unsigned int *mapped;
   unsigned int nmapped;
   unsigned int rr_counter;
+
+  unsigned int *lastused;	/* lru stamp of the mapped pages */
+  unsigned int lru_counter;
+  unsigned int cachepages;	/* keep up to this many pages, 0: as needed */
+
+  unsigned char *filemap;	/* the mapped solv file, see repopagestore_map_pages */
+  size_t filemapsize;
+
+  unsigned int readahead;	/* prefetch this many pages while the access is sequential */
+  unsigned int lastpage;	/* last page of the sequential access */
+  struct s_Repopageprefetch *prefetch;	/* the prefetch thread */
 } Repopagestore;
 
 #ifdef __cplusplus
@@ -53,13 +72,23 @@ unsigned char *repopagestore_load_page_range(Repopagestore *store, unsigned int
 
 /* compress a page, return compressed len */
 unsigned int repopagestore_compress_page(unsigned char *page, unsigned int len, unsigned char *cpage, unsigned int max);
+/* compress a page with a REPOPAGE_CODEC_xxx codec, return compressed len */
+unsigned int repopagestore_compress_page_codec(unsigned char *page, unsigned int len, unsigned char *cpage, unsigned int max, int codec);
 /* uncompress a page, return uncompressed len */
 unsigned int repopagestore_decompress_page(const unsigned char *cpage, unsigned int len, unsigned char *page, unsigned int max);
 
 /* setup page data for repodata_load_page_range */
 int repopagestore_read_or_setup_pages(Repopagestore *store, FILE *fp, unsigned int pagesz, unsigned int blobsz);
 
+/* map the pages of the file, uncompressed pages are then used in place */
+int repopagestore_map_pages(Repopagestore *store);
+
+/* readahead hint for sequential scans, 0 to stop */
+void repopagestore_readahead(Repopagestore *store, unsigned int npages);
+
 void repopagestore_disable_paging(Repopagestore *store);
+/* load all pages with up to nthreads threads */
+void repopagestore_disable_paging_threaded(Repopagestore *store, int nthreads);
 
 #ifdef __cplusplus
 }
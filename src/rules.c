@@ -709,32 +709,25 @@ add_conda_constrains_rule(Solver *solv, Id n, Id dep, int dontfix)
 
 /*-------------------------------------------------------------------
  *
- * add dependency rules for solvable
+ * add dependency rules for solvables
  *
- * s: Solvable for which to add rules
+ * workq: solvables we still have to work on
  * m: m[s] = 1 for solvables which have rules, prevent rule duplication
- *
- * Algorithm: 'visit all nodes of a graph'. The graph nodes are
- *  solvables, the edges their dependencies.
- *  Starting from an installed solvable, this will create all rules
- *  representing the graph created by the solvables dependencies.
+ * level, nlevel: if set, only work on these solvables. They are
+ *  already marked in m, the referenced solvables are pushed on workq
+ *  for the next level. Used for the parallel rule creation.
  *
  * for unfulfilled requirements, conflicts, obsoletes,....
  * add a negative assertion for solvables that are not installable
  *
- * It will also create rules for all solvables referenced by 's'
- *  i.e. descend to all providers of requirements of 's'
- *
  */
 
-void
-solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
+static void
+addpkgrules_work(Solver *solv, Queue *workq, Map *m, Id *level, int nlevel)
 {
   Pool *pool = solv->pool;
   Repo *installed = solv->installed;
 
-  Queue workq;	/* list of solvables we still have to work on */
-  Id workqbuf[64];
   Queue depq;	/* list of pre-req ids to ignore */
   Id depqbuf[16];
 
@@ -748,26 +741,32 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
   Id p, pp;		/* whatprovides loops */
   Id *dp;		/* ptr to 'whatprovides' */
   Id n;			/* Id for current solvable 's' */
-
-  queue_init_buffer(&workq, workqbuf, sizeof(workqbuf)/sizeof(*workqbuf));
-  queue_push(&workq, s - pool->solvables);	/* push solvable Id to work queue */
+  Solvable *s;
 
   queue_init_buffer(&depq, depqbuf, sizeof(depqbuf)/sizeof(*depqbuf));
 
   /* loop until there's no more work left */
-  while (workq.count)
+  while (level ? nlevel > 0 : workq->count > 0)
     {
       /*
        * n: Id of solvable
        * s: Pointer to solvable
        */
 
-      n = queue_shift(&workq);		/* 'pop' next solvable to work on from queue */
-      if (m)
+      if (level)
 	{
-	  if (MAPTST(m, n))		/* continue if already visited */
-	    continue;
-	  MAPSET(m, n);			/* mark as visited */
+	  n = *level++;			/* already marked in m */
+	  nlevel--;
+	}
+      else
+	{
+	  n = queue_shift(workq);	/* 'pop' next solvable to work on from queue */
+	  if (m)
+	    {
+	      if (MAPTST(m, n))		/* continue if already visited */
+		continue;
+	      MAPSET(m, n);		/* mark as visited */
+	    }
 	}
 
       s = pool->solvables + n;
@@ -795,7 +794,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 #ifdef ENABLE_LINKED_PKGS
       /* add pseudo-package <-> real-package links */
       if (has_package_link(pool, s))
-        add_package_link(solv, s, m, &workq);
+        add_package_link(solv, s, m, workq);
 #endif
 
       /*-----------------------------------------
@@ -834,7 +833,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      if (pool_is_complex_dep(pool, req))
 		{
 		  /* we have AND/COND deps, normalize */
-		  add_complex_deprules(solv, n, req, SOLVER_RULE_PKG_REQUIRES, dontfix, &workq, m);
+		  add_complex_deprules(solv, n, req, SOLVER_RULE_PKG_REQUIRES, dontfix, workq, m);
 		  continue;
 		}
 #endif
@@ -890,7 +889,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      if (m)
 	        for (; *dp; dp++)
 		  if (!MAPTST(m, *dp))
-		    queue_push(&workq, *dp);
+		    queue_push(workq, *dp);
 	    }
 	}
 
@@ -905,7 +904,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      if (pool_is_complex_dep(pool, req))
 		{
 		  /* we have AND/COND deps, normalize */
-		  add_complex_deprules(solv, n, req, SOLVER_RULE_PKG_RECOMMENDS, dontfix, &workq, m);
+		  add_complex_deprules(solv, n, req, SOLVER_RULE_PKG_RECOMMENDS, dontfix, workq, m);
 		  continue;
 		}
 #endif
@@ -921,7 +920,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      if (m)
 	        for (; *dp; dp++)
 		  if (!MAPTST(m, *dp))
-		    queue_push(&workq, *dp);
+		    queue_push(workq, *dp);
 	    }
 	  if (!solv->ruleinfoq && start < solv->nrules)
 	    {
@@ -973,7 +972,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      if (!ispatch && pool_is_complex_dep(pool, con))
 		{
 		  /* we have AND/COND deps, normalize */
-		  add_complex_deprules(solv, n, con, SOLVER_RULE_PKG_CONFLICTS, dontfix, &workq, m);
+		  add_complex_deprules(solv, n, con, SOLVER_RULE_PKG_CONFLICTS, dontfix, workq, m);
 		  continue;
 		}
 #endif
@@ -1081,8 +1080,9 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 		    {
 		      /* optimization: do not add the same-name conflict rule if it was
 		       * already added when we looked at the other package.
-		       * (this assumes pool_colormatch is symmetric) */
-		      if (p && m && ps->repo != installed && MAPTST(m, p) &&
+		       * (this assumes pool_colormatch is symmetric)
+		       * not done for a level, all its solvables are marked in m */
+		      if (p && m && !level && ps->repo != installed && MAPTST(m, p) &&
 			  (ps->arch != ARCH_SRC && ps->arch != ARCH_NOSRC) &&
 			  !(solv->multiversion.size && MAPTST(&solv->multiversion, p)))
 			continue;
@@ -1106,7 +1106,7 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 	      pa = pool_arch2score(pool, ps->arch);
 	      if (!pa || pa == 1 || pa >= a)
 		continue;
-	      queue_push(&workq, p);
+	      queue_push(workq, p);
 	    }
 	}
 
@@ -1121,13 +1121,13 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 #ifdef ENABLE_COMPLEX_DEPS
 	      if (pool_is_complex_dep(pool, rec))
 		{
-		  pool_add_pos_literals_complex_dep(pool, rec, &workq, m, 0);
+		  pool_add_pos_literals_complex_dep(pool, rec, workq, m, 0);
 		  continue;
 		}
 #endif
 	      FOR_PROVIDES(p, pp, rec)
 		if (!MAPTST(m, p))
-		  queue_push(&workq, p);
+		  queue_push(workq, p);
 	    }
 	}
       if (s->suggests && m)
@@ -1138,20 +1138,239 @@ solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
 #ifdef ENABLE_COMPLEX_DEPS
 	      if (pool_is_complex_dep(pool, sug))
 		{
-		  pool_add_pos_literals_complex_dep(pool, sug, &workq, m, 0);
+		  pool_add_pos_literals_complex_dep(pool, sug, workq, m, 0);
 		  continue;
 		}
 #endif
 	      FOR_PROVIDES(p, pp, sug)
 		if (!MAPTST(m, p))
-		  queue_push(&workq, p);
+		  queue_push(workq, p);
 	    }
 	}
     }
   queue_free(&depq);
+}
+
+/*-------------------------------------------------------------------
+ *
+ * add dependency rules for solvable
+ *
+ * s: Solvable for which to add rules
+ * m: m[s] = 1 for solvables which have rules, prevent rule duplication
+ *
+ * Algorithm: 'visit all nodes of a graph'. The graph nodes are
+ *  solvables, the edges their dependencies.
+ *  Starting from an installed solvable, this will create all rules
+ *  representing the graph created by the solvables dependencies.
+ *
+ * It will also create rules for all solvables referenced by 's'
+ *  i.e. descend to all providers of requirements of 's'
+ *
+ */
+
+void
+solver_addpkgrulesforsolvable(Solver *solv, Solvable *s, Map *m)
+{
+  Queue workq;	/* list of solvables we still have to work on */
+  Id workqbuf[64];
+
+  queue_init_buffer(&workq, workqbuf, sizeof(workqbuf)/sizeof(*workqbuf));
+  queue_push(&workq, s - solv->pool->solvables);	/* push solvable Id to work queue */
+  addpkgrules_work(solv, &workq, m, 0, 0);
   queue_free(&workq);
 }
 
+/* the parallel rule creation needs read-only lookups */
+static int
+pkgrules_threadsafe(Solver *solv)
+{
+  Pool *pool = solv->pool;
+#ifndef ENABLE_THREADS
+  if (!pool->forcethreads)
+    return 0;		/* the slices would be done one after the other */
+#endif
+  if (solv->nthreads <= 1 || !pool->frozen)
+    return 0;		/* lookups may modify an unfrozen pool */
+  if (pool->snapshotof && (pool->evrcmpcache || pool->disttype == DISTTYPE_CONDA))
+    return 0;		/* snapshots have their own caches */
+  if (solv->strongrecommends || solv->ruleinfoq)
+    return 0;		/* these record rule numbers */
+  if ((pool->debugmask & SOLV_DEBUG_RULE_CREATION) != 0)
+    return 0;		/* keep the debug output in order */
+  return 1;
+}
+
+#ifdef ENABLE_COMPLEX_DEPS
+static int
+has_complex_dep(Pool *pool, Solvable *s, Offset off)
+{
+  Id *dp;
+  if (!off)
+    return 0;
+  for (dp = s->repo->idarraydata + off; *dp; dp++)
+    if (pool_is_complex_dep(pool, *dp))
+      return 1;
+  return 0;
+}
+#endif
+
+/* solvables whose rules may add provider lists to the pool */
+static int
+pkgrules_needserial(Solver *solv, Solvable *s)
+{
+  Pool *pool = solv->pool;
+#ifdef ENABLE_LINKED_PKGS
+  if (has_package_link(pool, s))
+    return 1;
+#endif
+#ifdef ENABLE_COMPLEX_DEPS
+  if (has_complex_dep(pool, s, s->requires) || has_complex_dep(pool, s, s->conflicts) ||
+      has_complex_dep(pool, s, s->recommends) || has_complex_dep(pool, s, s->suggests))
+    return 1;
+#endif
+  if (s->conflicts && solv->multiversion.size && !strncmp("patch:", pool_id2str(pool, s->name), 6))
+    return 1;	/* makemultiversionconflict */
+  return 0;
+}
+
+/* do not start a thread for less solvables */
+#define PKGRULES_THREAD_MIN 64
+
+struct pkgrules_threads {
+  Map *m;
+  Id *level;
+  int nlevel;
+  int nthreads;
+  Solver *tsolvs;	/* per thread: solver copy with its own rule area */
+  Queue *tworkqs;	/* per thread: referenced solvables */
+};
+
+static void
+pkgrules_thread(void *data, int idx)
+{
+  struct pkgrules_threads *pt = data;
+  int chunk = (pt->nlevel + pt->nthreads - 1) / pt->nthreads;
+  int start = idx * chunk, end = start + chunk;
+
+  if (end > pt->nlevel)
+    end = pt->nlevel;
+  if (start < end)
+    addpkgrules_work(pt->tsolvs + idx, pt->tworkqs + idx, pt->m, pt->level + start, end - start);
+}
+
+/*-------------------------------------------------------------------
+ *
+ * add dependency rules for all solvables in q and the solvables
+ * they reference, like calling solver_addpkgrulesforsolvable for
+ * every element.
+ *
+ * With solv->nthreads > 1 and a frozen pool the graph is walked
+ * level by level. The solvables of a level are split into slices
+ * that are worked on in parallel, every thread adds the rules to
+ * its own copy of the solver. The rules are then appended in thread
+ * order. This is deterministic, solver_unifyrules sorts the rules
+ * anyway, so the result does not depend on the number of threads.
+ * Solvables whose rules may modify the pool are done by the calling
+ * thread.
+ */
+
+void
+solver_addpkgrulesforsolvables(Solver *solv, Queue *q, Map *m)
+{
+  Pool *pool = solv->pool;
+  struct pkgrules_threads pt;
+  Queue level, serial, workq;
+  Solver *tsolv;
+  int i, t, nthreads;
+  Id p;
+
+  if (!pkgrules_threadsafe(solv))
+    {
+      for (i = 0; i < q->count; i++)
+	if (!MAPTST(m, q->elements[i]))
+	  solver_addpkgrulesforsolvable(solv, pool->solvables + q->elements[i], m);
+      return;
+    }
+  memset(&pt, 0, sizeof(pt));
+  pt.m = m;
+  pt.tsolvs = solv_calloc(solv->nthreads, sizeof(Solver));
+  pt.tworkqs = solv_calloc(solv->nthreads, sizeof(Queue));
+  for (t = 0; t < solv->nthreads; t++)
+    {
+      tsolv = pt.tsolvs + t;
+      *tsolv = *solv;
+      tsolv->rules = solv_calloc_block(1, sizeof(Rule), RULES_BLOCK);
+      tsolv->nrules = 1;
+      tsolv->lastpkgrule = 0;
+      queue_init(pt.tworkqs + t);
+    }
+  queue_init(&level);
+  queue_init(&serial);
+  queue_init_clone(&workq, q);
+  for (;;)
+    {
+      /* the next level: the referenced solvables that do not have rules yet */
+      queue_empty(&level);
+      queue_empty(&serial);
+      for (i = 0; i < workq.count; i++)
+	{
+	  p = workq.elements[i];
+	  if (MAPTST(m, p))
+	    continue;
+	  MAPSET(m, p);
+	  if (pkgrules_needserial(solv, pool->solvables + p))
+	    queue_push(&serial, p);
+	  else
+	    queue_push(&level, p);
+	}
+      queue_empty(&workq);
+      if (!level.count && !serial.count)
+	break;
+      if (serial.count)
+	addpkgrules_work(solv, &workq, m, serial.elements, serial.count);
+      nthreads = pool->forcethreads ? level.count : level.count / PKGRULES_THREAD_MIN;
+      if (nthreads > solv->nthreads)
+	nthreads = solv->nthreads;
+      if (nthreads <= 1)
+	{
+	  if (level.count)
+	    addpkgrules_work(solv, &workq, m, level.elements, level.count);
+	  continue;
+	}
+      pt.level = level.elements;
+      pt.nlevel = level.count;
+      pt.nthreads = nthreads;
+      solv_runthreads(nthreads, pkgrules_thread, &pt);
+      /* merge in thread order */
+      for (t = 0; t < nthreads; t++)
+	{
+	  tsolv = pt.tsolvs + t;
+	  if (tsolv->nrules > 1)
+	    {
+	      solv->rules = solv_extend(solv->rules, solv->nrules, tsolv->nrules - 1, sizeof(Rule), RULES_BLOCK);
+	      memcpy(solv->rules + solv->nrules, tsolv->rules + 1, (tsolv->nrules - 1) * sizeof(Rule));
+	      solv->nrules += tsolv->nrules - 1;
+	    }
+	  tsolv->nrules = 1;
+	  tsolv->lastpkgrule = 0;
+	  queue_insertn(&workq, workq.count, pt.tworkqs[t].count, pt.tworkqs[t].elements);
+	  queue_empty(pt.tworkqs + t);
+	}
+      solv->lastpkgrule = 0;
+    }
+  for (t = 0; t < solv->nthreads; t++)
+    {
+      solv_free(pt.tsolvs[t].rules);
+      queue_free(pt.tworkqs + t);
+    }
+  solv_free(pt.tsolvs);
+  solv_free(pt.tworkqs);
+  queue_free(&level);
+  queue_free(&serial);
+  queue_free(&workq);
+}
+
+
 #ifdef ENABLE_LINKED_PKGS
 void
 solver_addpkgrulesforlinked(Solver *solv, Map *m)
@@ -1249,30 +1468,33 @@ solver_addpkgrulesforweak(Solver *solv, Map *m)
  *
  * add package rules for possible updates
  *
- * s: solvable
+ * q: solvables
  * m: map of already visited solvables
  * allow_all: 0 = dont allow downgrades, 1 = allow all candidates
  */
 
 void
-solver_addpkgrulesforupdaters(Solver *solv, Solvable *s, Map *m, int allow_all)
+solver_addpkgrulesforupdaters(Solver *solv, Queue *q, Map *m, int allow_all)
 {
   Pool *pool = solv->pool;
   int i;
     /* queue and buffer for it */
   Queue qs;
   Id qsbuf[64];
+  Queue qu;	/* the solvables and their update candidates */
 
   queue_init_buffer(&qs, qsbuf, sizeof(qsbuf)/sizeof(*qsbuf));
-    /* find update candidates for 's' */
-  policy_findupdatepackages(solv, s, &qs, allow_all);
-    /* add rule for 's' if not already done */
-  if (!MAPTST(m, s - pool->solvables))
-    solver_addpkgrulesforsolvable(solv, s, m);
-    /* foreach update candidate, add rule if not already done */
-  for (i = 0; i < qs.count; i++)
-    if (!MAPTST(m, qs.elements[i]))
-      solver_addpkgrulesforsolvable(solv, pool->solvables + qs.elements[i], m);
+  queue_init(&qu);
+  for (i = 0; i < q->count; i++)
+    {
+	/* find update candidates for 's' */
+      policy_findupdatepackages(solv, pool->solvables + q->elements[i], &qs, allow_all);
+      queue_push(&qu, q->elements[i]);
+      queue_insertn(&qu, qu.count, qs.count, qs.elements);
+    }
+    /* add rules if not already done */
+  solver_addpkgrulesforsolvables(solv, &qu, m);
+  queue_free(&qu);
   queue_free(&qs);
 }
 
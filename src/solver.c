@@ -16,6 +16,9 @@
 #include <unistd.h>
 #include <string.h>
 #include <assert.h>
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+#endif
 
 #include "solver.h"
 #include "solver_private.h"
@@ -30,6 +33,9 @@
 
 #define RULES_BLOCK 63
 
+#define REDUCELEARNT_FIRST	2000	/* learnt rules before the first reduction */
+#define REDUCELEARNT_INC	300	/* grow the interval by this after every reduction */
+
 
 /************************************************************************/
 
@@ -40,6 +46,13 @@
  * of our learnt rules except the ones that were learnt from rules that
  * are now disabled.
  */
+/* true if the learnt rule was deleted by reducelearntrules() */
+static inline int
+learntrule_deleted(Solver *solv, Id rid)
+{
+  return solv->learnt_info.count && rid >= solv->learntrules && !solv->learnt_info.elements[2 * (rid - solv->learntrules)];
+}
+
 static void
 enabledisablelearntrules(Solver *solv)
 {
@@ -51,6 +64,8 @@ enabledisablelearntrules(Solver *solv)
   POOL_DEBUG(SOLV_DEBUG_SOLUTIONS, "enabledisablelearntrules called\n");
   for (i = solv->learntrules, r = solv->rules + i; i < solv->nrules; i++, r++)
     {
+      if (learntrule_deleted(solv, i))
+	continue;	/* stays disabled */
       whyp = solv->learnt_pool.elements + solv->learnt_why.elements[i - solv->learntrules];
       while ((why = *whyp++) != 0)
 	{
@@ -342,6 +357,78 @@ makeruledecisions(Solver *solv, int disablerules)
 /* watches */
 
 
+/*
+ * watch vectors
+ *
+ * Instead of linking the rules through n1/n2, every literal gets a
+ * vector of (rule, blocker) pairs. The blocker is some other literal
+ * of the rule, if it is true the rule does not need to be looked at.
+ * New watches are appended and the vectors are processed from the end,
+ * so that the rules are visited in the same order as with the linked
+ * lists.
+ *
+ * Binary rules never move their watches, they are put into separate
+ * implication vectors of (rule, other literal) pairs. They are
+ * processed before the long rules of a literal.
+ */
+
+/* binary rules, also disabled ones, go to the implications */
+#define WATCHVEC_IMPLICATION(r) ((r)->d == 0 || (r)->d == -1)
+
+static void
+freewatchvecs(Solver *solv)
+{
+  int i;
+
+  if (!solv->watchvecs)
+    return;
+  /* the pool may have grown since the vectors were made */
+  for (i = 0; i < solv->nwatchvecs; i++)
+    {
+      queue_free(solv->watchvecs + i);
+      queue_free(solv->implications + i);
+    }
+  solv->watchvecs = solv_free(solv->watchvecs);
+  solv->implications = solv_free(solv->implications);
+  solv->nwatchvecs = 0;
+}
+
+static void
+makewatchvecs(Solver *solv)
+{
+  Rule *r;
+  int i;
+  int nsolvables = solv->pool->nsolvables;
+  Queue *wv, *iv;
+
+  freewatchvecs(solv);
+  solv->watchvecs = wv = solv_calloc(2 * nsolvables, sizeof(Queue));
+  solv->implications = iv = solv_calloc(2 * nsolvables, sizeof(Queue));
+  solv->nwatchvecs = 2 * nsolvables;
+  for (i = 0; i < 2 * nsolvables; i++)
+    {
+      queue_init(wv + i);
+      queue_init(iv + i);
+    }
+  wv += nsolvables;
+  iv += nsolvables;
+  for (i = 1, r = solv->rules + solv->nrules - 1; i < solv->nrules; i++, r--)
+    {
+      if (!r->w2)		/* assertions do not need watches */
+	continue;
+      if (learntrule_deleted(solv, r - solv->rules))
+	continue;
+      if (WATCHVEC_IMPLICATION(r))
+	{
+	  queue_push2(iv + r->w1, r - solv->rules, r->w2);
+	  queue_push2(iv + r->w2, r - solv->rules, r->w1);
+	  continue;
+	}
+      queue_push2(wv + r->w1, r - solv->rules, r->w2);
+      queue_push2(wv + r->w2, r - solv->rules, r->w1);
+    }
+}
+
 /*-------------------------------------------------------------------
  * makewatches
  *
@@ -355,6 +442,11 @@ makewatches(Solver *solv)
   int i;
   int nsolvables = solv->pool->nsolvables;
 
+  if (solv->watchvectors)
+    {
+      makewatchvecs(solv);
+      return;
+    }
   solv_free(solv->watches);
   /* lower half for removals, upper half for installs */
   solv->watches = solv_calloc(2 * nsolvables, sizeof(Id));
@@ -362,6 +454,8 @@ makewatches(Solver *solv)
     {
       if (!r->w2)		/* assertions do not need watches */
 	continue;
+      if (learntrule_deleted(solv, r - solv->rules))
+	continue;
 
       /* see addwatches_rule(solv, r) */
       r->n1 = solv->watches[nsolvables + r->w1];
@@ -386,6 +480,13 @@ addwatches_rule(Solver *solv, Rule *r)
 {
   int nsolvables = solv->pool->nsolvables;
 
+  if (solv->watchvecs)
+    {
+      Queue *wv = WATCHVEC_IMPLICATION(r) ? solv->implications : solv->watchvecs;
+      queue_push2(wv + nsolvables + r->w1, r - solv->rules, r->w2);
+      queue_push2(wv + nsolvables + r->w2, r - solv->rules, r->w1);
+      return;
+    }
   r->n1 = solv->watches[nsolvables + r->w1];
   solv->watches[nsolvables + r->w1] = r - solv->rules;
 
@@ -420,6 +521,174 @@ addwatches_rule(Solver *solv, Rule *r)
  *          rule = conflict found in this rule
  */
 
+/* rule r is unit, set literal lit to TRUE */
+static inline void
+propagate_unit(Solver *solv, Rule *r, Id lit, int level)
+{
+  Pool *pool = solv->pool;
+
+  IF_POOLDEBUG (SOLV_DEBUG_PROPAGATE)
+    {
+      POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "  unit ");
+      solver_printrule(solv, SOLV_DEBUG_PROPAGATE, r);
+    }
+  if (lit > 0)
+    solv->decisionmap[lit] = level;	/* install! */
+  else
+    solv->decisionmap[-lit] = -level;	/* remove! */
+  queue_push(&solv->decisionq, lit);
+  queue_push(&solv->decisionq_why, r - solv->rules);
+  IF_POOLDEBUG (SOLV_DEBUG_PROPAGATE)
+    {
+      if (lit > 0)
+	POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "    -> decided to install %s\n", pool_solvid2str(pool, lit));
+      else
+	POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "    -> decided to conflict %s\n", pool_solvid2str(pool, -lit));
+    }
+}
+
+static Rule *
+propagate_watchvecs(Solver *solv, int level)
+{
+  Pool *pool = solv->pool;
+  Rule *r;
+  Queue *wq;
+  Id p, pkg, other_watch, blocker;
+  Id *dp, *wp, *keepp, *endp;
+  Id *decisionmap = solv->decisionmap;
+  Queue *watchvecs = solv->watchvecs + pool->nsolvables;   /* place ptr in middle */
+  Queue *implications = solv->implications + pool->nsolvables;
+
+  POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "----- propagate level %d -----\n", level);
+
+  while (solv->propagate_index < solv->decisionq.count)
+    {
+      pkg = -solv->decisionq.elements[solv->propagate_index++];
+      solv->stats_propagations++;
+
+      IF_POOLDEBUG (SOLV_DEBUG_PROPAGATE)
+        {
+	  POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "propagate decision %d:", -pkg);
+	  solver_printruleelement(solv, SOLV_DEBUG_PROPAGATE, 0, -pkg);
+        }
+
+      /* binary rules: the other literal is implied */
+      wq = implications + pkg;
+      solv->stats_binaryvisits += wq->count / 2;
+      for (wp = wq->elements + wq->count; wp > wq->elements;)
+	{
+	  wp -= 2;
+	  other_watch = wp[1];
+	  if (DECISIONMAP_TRUE(other_watch))
+	    continue;
+	  r = solv->rules + wp[0];
+	  if (r->d < 0)
+	    continue;		/* disabled */
+	  if (DECISIONMAP_FALSE(other_watch))
+	    return r;		/* conflict */
+	  propagate_unit(solv, r, other_watch, level);
+	}
+
+      /* go backwards over the pairs, the kept ones are compacted
+       * towards the end of the vector */
+      wq = watchvecs + pkg;
+      endp = keepp = wq->elements + wq->count;
+      solv->stats_longvisits += wq->count / 2;
+      for (wp = endp; wp > wq->elements;)
+	{
+	  wp -= 2;
+	  blocker = wp[1];
+	  if (DECISIONMAP_TRUE(blocker))
+	    {
+	      keepp -= 2;
+	      if (keepp != wp)
+		{
+		  keepp[0] = wp[0];
+		  keepp[1] = blocker;
+		}
+	      continue;
+	    }
+	  r = solv->rules + wp[0];
+	  if (r->d < 0)
+	    {
+	      /* rule is disabled, keep the watch */
+	      keepp -= 2;
+	      if (keepp != wp)
+		{
+		  keepp[0] = wp[0];
+		  keepp[1] = blocker;
+		}
+	      continue;
+	    }
+
+	  IF_POOLDEBUG (SOLV_DEBUG_WATCHES)
+	    {
+	      POOL_DEBUG(SOLV_DEBUG_WATCHES, "  watch triggered ");
+	      solver_printrule(solv, SOLV_DEBUG_WATCHES, r);
+	    }
+
+	  other_watch = pkg == r->w1 ? r->w2 : r->w1;
+	  keepp -= 2;
+	  keepp[0] = wp[0];
+	  keepp[1] = other_watch;
+	  if (DECISIONMAP_TRUE(other_watch))
+	    continue;
+
+          if (r->d)
+	    {
+	      /* not a binary clause, try to move our watch. See propagate() */
+	      if (r->p && r->p != other_watch && !DECISIONMAP_FALSE(r->p))
+		p = r->p;
+	      else
+		{
+		  for (dp = pool->whatprovidesdata + r->d; (p = *dp++) != 0;)
+		    if (p != other_watch && !DECISIONMAP_FALSE(p))
+		      break;
+		}
+	      if (p)
+		{
+		  IF_POOLDEBUG (SOLV_DEBUG_WATCHES)
+		    {
+		      if (p > 0)
+			POOL_DEBUG(SOLV_DEBUG_WATCHES, "    -> move w%d to %s\n", (pkg == r->w1 ? 1 : 2), pool_solvid2str(pool, p));
+		      else
+			POOL_DEBUG(SOLV_DEBUG_WATCHES, "    -> move w%d to !%s\n", (pkg == r->w1 ? 1 : 2), pool_solvid2str(pool, -p));
+		    }
+		  keepp += 2;		/* drop the pair again */
+		  if (pkg == r->w1)
+		    r->w1 = p;
+		  else
+		    r->w2 = p;
+		  /* p is not FALSE, so this is not the vector we work on */
+		  queue_push2(watchvecs + p, r - solv->rules, other_watch);
+		  continue;
+		}
+	    }
+
+	  if (DECISIONMAP_FALSE(other_watch))
+	    {
+	      /* conflict, move the kept pairs down to the unprocessed ones */
+	      if (keepp != wp)
+		memmove(wp, keepp, (endp - keepp) * sizeof(Id));
+	      wq->left += keepp - wp;
+	      wq->count -= keepp - wp;
+	      return r;
+	    }
+	  propagate_unit(solv, r, other_watch, level);
+	}
+      if (keepp != wq->elements)
+	{
+	  memmove(wq->elements, keepp, (endp - keepp) * sizeof(Id));
+	  wq->left += keepp - wq->elements;
+	  wq->count -= keepp - wq->elements;
+	}
+    }
+
+  POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "----- propagate end -----\n");
+
+  return 0;	/* all is well */
+}
+
 static Rule *
 propagate(Solver *solv, int level)
 {
@@ -429,7 +698,11 @@ propagate(Solver *solv, int level)
   Id p, pkg, other_watch;
   Id *dp;
   Id *decisionmap = solv->decisionmap;
-  Id *watches = solv->watches + pool->nsolvables;   /* place ptr in middle */
+  Id *watches;
+
+  if (solv->watchvecs)
+    return propagate_watchvecs(solv, level);
+  watches = solv->watches + pool->nsolvables;   /* place ptr in middle */
 
   POOL_DEBUG(SOLV_DEBUG_PROPAGATE, "----- propagate level %d -----\n", level);
 
@@ -441,6 +714,7 @@ propagate(Solver *solv, int level)
        * negate because our watches trigger if literal goes FALSE
        */
       pkg = -solv->decisionq.elements[solv->propagate_index++];
+      solv->stats_propagations++;
 	
       IF_POOLDEBUG (SOLV_DEBUG_PROPAGATE)
         {
@@ -452,6 +726,10 @@ propagate(Solver *solv, int level)
       for (rp = watches + pkg; *rp; rp = next_rp)
 	{
 	  r = solv->rules + *rp;
+	  if (r->d == 0 || r->d == -1)
+	    solv->stats_binaryvisits++;
+	  else
+	    solv->stats_longvisits++;
 	  if (r->d < 0)
 	    {
 	      /* rule is disabled, goto next */
@@ -661,6 +939,121 @@ watch2onhighest(Solver *solv, Rule *r)
 }
 
 
+/*-------------------------------------------------------------------
+ *
+ * learnt_lbd - the number of different decision levels in a learnt
+ * rule. The asserting literal is at the conflict level, which is not
+ * in q.
+ */
+
+static int
+learnt_lbd(Solver *solv, Queue *q, int level)
+{
+  Map seen;
+  int i, l, lbd = 1;
+
+  map_init(&seen, level + 1);
+  for (i = 0; i < q->count; i++)
+    {
+      l = solv->decisionmap[q->elements[i] > 0 ? q->elements[i] : -q->elements[i]];
+      if (l < 0)
+	l = -l;
+      if (!MAPTST(&seen, l))
+	{
+	  MAPSET(&seen, l);
+	  lbd++;
+	}
+    }
+  map_free(&seen);
+  return lbd;
+}
+
+/*-------------------------------------------------------------------
+ *
+ * reducelearntrules
+ *
+ * delete the half of the learnt rules that looks least useful. Rules
+ * with few decision levels (lbd) and recently used ones are kept, as
+ * well as binary rules, assertions and rules that are the reason of
+ * a decision.
+ * Other rules and problem proofs reference the learnt rules by their
+ * number, so they are not removed from the rule array. They are
+ * disabled for good and lose their watches instead.
+ */
+
+static int
+reducelearnt_sortcmp(const void *ap, const void *bp, void *dp)
+{
+  Solver *solv = dp;
+  const Id *info = solv->learnt_info.elements;
+  Id a = *(const Id *)ap - solv->learntrules;
+  Id b = *(const Id *)bp - solv->learntrules;
+
+  if (info[2 * a] != info[2 * b])
+    return info[2 * b] - info[2 * a];		/* high lbd first */
+  if (info[2 * a + 1] != info[2 * b + 1])
+    return info[2 * a + 1] - info[2 * b + 1];	/* least recently used first */
+  return a - b;
+}
+
+/* the number of learnt rules until the next reduction. The value of
+ * SOLVER_FLAG_REDUCE_LEARNT can set the first interval, the following
+ * ones grow in proportion. */
+static inline int
+reducelearnt_interval(Solver *solv)
+{
+  int first = solv->reducelearnt > 1 ? solv->reducelearnt : REDUCELEARNT_FIRST;
+  return first + (int)((long long)first * REDUCELEARNT_INC / REDUCELEARNT_FIRST) * solv->stats_reductions;
+}
+
+static void
+reducelearntrules(Solver *solv)
+{
+  Pool *pool = solv->pool;
+  Queue cand;
+  Map locked;
+  Rule *r;
+  Id *info = solv->learnt_info.elements;
+  int i, ndel;
+
+  map_init(&locked, solv->nrules - solv->learntrules);
+  for (i = 0; i < solv->decisionq_why.count; i++)
+    {
+      Id why = solv->decisionq_why.elements[i];
+      if (why >= solv->learntrules)
+	MAPSET(&locked, why - solv->learntrules);
+    }
+  queue_init(&cand);
+  for (i = solv->learntrules, r = solv->rules + i; i < solv->nrules; i++, r++)
+    {
+      if (!info[2 * (i - solv->learntrules)])
+	continue;		/* already deleted */
+      if (!r->w2 || !r->d || r->d == -1)
+	continue;		/* assertion or binary rule */
+      if (info[2 * (i - solv->learntrules)] <= 2)
+	continue;		/* glue rule */
+      if (MAPTST(&locked, i - solv->learntrules))
+	continue;
+      queue_push(&cand, i);
+    }
+  map_free(&locked);
+  solv_sort(cand.elements, cand.count, sizeof(Id), reducelearnt_sortcmp, solv);
+  ndel = cand.count / 2;
+  for (i = 0; i < ndel; i++)
+    {
+      r = solv->rules + cand.elements[i];
+      if (r->d >= 0)
+	solver_disablerule(solv, r);
+      info[2 * (cand.elements[i] - solv->learntrules)] = 0;
+    }
+  queue_free(&cand);
+  solv->stats_learntdeleted += ndel;
+  solv->stats_reductions++;
+  POOL_DEBUG(SOLV_DEBUG_ANALYZE, "reducelearntrules: deleted %d of %d learnt rules\n", ndel, solv->nrules - solv->learntrules);
+  /* rebuild the watches without the deleted rules */
+  makewatches(solv);
+}
+
 /*-------------------------------------------------------------------
  *
  * analyze
@@ -678,7 +1071,7 @@ analyze(Solver *solv, int level, Rule *c, Rule **lrp)
   Map seen;		/* global? */
   Id p = 0, pp, v, vv, why;
   int l, i, idx;
-  int num = 0, l1num = 0;
+  int num = 0, l1num = 0, lbd = 0;
   int learnt_why = solv->learnt_pool.count;
   Id *decisionmap = solv->decisionmap;
 
@@ -692,6 +1085,8 @@ analyze(Solver *solv, int level, Rule *c, Rule **lrp)
       IF_POOLDEBUG (SOLV_DEBUG_ANALYZE)
 	solver_printruleclass(solv, SOLV_DEBUG_ANALYZE, c);
       queue_push(&solv->learnt_pool, c - solv->rules);
+      if (solv->reducelearnt && c - solv->rules >= solv->learntrules)
+	solv->learnt_info.elements[2 * (c - solv->rules - solv->learntrules) + 1] = solv->stats_learned;
       FOR_RULELITERALS(v, pp, c)
 	{
 	  if (DECISIONMAP_TRUE(v))	/* the one true literal */
@@ -766,6 +1161,8 @@ l1retry:
   /* push end marker on learnt reasons stack */
   queue_push(&solv->learnt_pool, 0);
   solv->stats_learned++;
+  if (solv->reducelearnt)
+    lbd = learnt_lbd(solv, &q, level);
 
   POOL_DEBUG(SOLV_DEBUG_ANALYZE, "reverting decisions (level %d -> %d)\n", level, rlevel);
   level = rlevel;
@@ -784,6 +1181,8 @@ l1retry:
     }
   assert(solv->learnt_why.count == (r - solv->rules) - solv->learntrules);
   queue_push(&solv->learnt_why, learnt_why);
+  if (solv->reducelearnt)
+    queue_push2(&solv->learnt_info, lbd, solv->stats_learned);
   if (r->w2)
     {
       /* needs watches */
@@ -1061,6 +1460,82 @@ analyze_unsolvable(Solver *solv, Rule *cr, int disablerules)
 }
 
 
+/*
+ * portfolio solving
+ *
+ * solver_solve can run additional strategies, i.e. sets of solver
+ * flags, next to the configured one. Every strategy gets the portfolio
+ * conflict budget. The result is the one of the first strategy in the
+ * list that finishes within the budget, so it does not depend on the
+ * number of threads or the timing. A strategy is cancelled once a
+ * strategy before it has finished.
+ */
+struct s_Portfolio {
+  Solver **solvs;
+  Queue *jobs;			/* the job for every strategy */
+  int *results;			/* the solve result, -1 if aborted */
+  int best;			/* the first strategy that finished so far */
+#ifdef ENABLE_THREADS
+  pthread_mutex_t lock;
+#endif
+};
+
+static int
+portfolio_getbest(struct s_Portfolio *pf)
+{
+  int best;
+#ifdef ENABLE_THREADS
+  pthread_mutex_lock(&pf->lock);
+#endif
+  best = pf->best;
+#ifdef ENABLE_THREADS
+  pthread_mutex_unlock(&pf->lock);
+#endif
+  return best;
+}
+
+static void
+portfolio_setbest(struct s_Portfolio *pf, int idx)
+{
+#ifdef ENABLE_THREADS
+  pthread_mutex_lock(&pf->lock);
+#endif
+  if (idx < pf->best)
+    pf->best = idx;
+#ifdef ENABLE_THREADS
+  pthread_mutex_unlock(&pf->lock);
+#endif
+}
+
+
+/*-------------------------------------------------------------------
+ *
+ * budget_exhausted
+ *
+ * check if the solver ran out of its budget. Sets solv->aborted
+ * to the exhausted budget. Only checked while solver_solve runs.
+ */
+
+static int
+budget_exhausted(Solver *solv)
+{
+  Pool *pool = solv->pool;
+
+  if (solv->aborted || !solv->budgetactive)
+    return solv->aborted;
+  if (solv->budget_conflicts && solv->stats_learned + solv->stats_unsolvable >= solv->budget_conflicts)
+    solv->aborted = SOLVER_BUDGET_CONFLICTS;
+  else if (solv->budget_decisions && solv->stats_decisions >= solv->budget_decisions)
+    solv->aborted = SOLVER_BUDGET_DECISIONS;
+  else if (solv->budget_time && solv_timems(solv->budgetstart) >= (unsigned int)solv->budget_time)
+    solv->aborted = SOLVER_BUDGET_TIME;
+  else if (solv->portfolioidx && (solv->stats_decisions & 63) == 0 && portfolio_getbest(solv->portfolio) < solv->portfolioidx)
+    solv->aborted = SOLVER_BUDGET_PORTFOLIO;
+  if (solv->aborted)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "solver budget exhausted, aborting\n");
+  return solv->aborted;
+}
+
 /*-------------------------------------------------------------------
  *
  * setpropagatelearn
@@ -1073,7 +1548,8 @@ analyze_unsolvable(Solver *solv, Rule *cr, int disablerules)
  * rule to learnt rule set, make decision from learnt
  * rule (always unit) and re-propagate.
  *
- * returns the new solver level or -1 if unsolvable
+ * returns the new solver level or -1 if unsolvable or if the
+ * budget is exhausted
  *
  */
 
@@ -1083,8 +1559,11 @@ setpropagatelearn(Solver *solv, int level, Id decision, int disablerules, Id rul
   Pool *pool = solv->pool;
   Rule *r, *lr;
 
+  if (budget_exhausted(solv))
+    return -1;
   if (decision)
     {
+      solv->stats_decisions++;
       level++;
       if (decision > 0)
         solv->decisionmap[decision] = level;
@@ -1102,6 +1581,8 @@ setpropagatelearn(Solver *solv, int level, Id decision, int disablerules, Id rul
 	break;
       if (level == 1)
 	return analyze_unsolvable(solv, r, disablerules);
+      if (budget_exhausted(solv))
+	return -1;
       POOL_DEBUG(SOLV_DEBUG_ANALYZE, "conflict with rule #%d\n", (int)(r - solv->rules));
       level = analyze(solv, level, r, &lr);
       /* the new rule is unit by design */
@@ -1116,6 +1597,11 @@ setpropagatelearn(Solver *solv, int level, Id decision, int disablerules, Id rul
 	  POOL_DEBUG(SOLV_DEBUG_ANALYZE, "new rule: ");
 	  solver_printrule(solv, SOLV_DEBUG_ANALYZE, lr);
 	}
+      if (solv->reducelearnt && solv->stats_learned >= solv->nextreducelearnt)
+	{
+	  reducelearntrules(solv);
+	  solv->nextreducelearnt = solv->stats_learned + reducelearnt_interval(solv);
+	}
     }
   return level;
 }
@@ -1270,6 +1756,7 @@ createbranch(Solver *solv, int level, Queue *dq, Id p, Id data)
       for (i = 0; i < dq->count; i++)
 	POOL_DEBUG (SOLV_DEBUG_POLICY, "  - %s\n", pool_solvid2str(pool, dq->elements[i]));
     }
+  solv->stats_branches++;
   queue_push(&solv->branches, -dq->elements[0]);
   for (i = 1; i < dq->count; i++)
     queue_push(&solv->branches, dq->elements[i]);
@@ -1418,6 +1905,8 @@ solver_create(Pool *pool)
   solv->dup_allowvendorchange = 1;
 
   solv->keepexplicitobsoletes = pool->noobsoletesmultiversion ? 0 : 1;
+  solv->nthreads = pool->forcethreads ? pool->forcethreads : 1;
+  solv->budget_portfolio = 1000;
 
   queue_init(&solv->ruletojob);
   queue_init(&solv->decisionq);
@@ -1426,6 +1915,8 @@ solver_create(Pool *pool)
   queue_init(&solv->problems);
   queue_init(&solv->orphaned);
   queue_init(&solv->learnt_why);
+  queue_init(&solv->learnt_info);
+  queue_init(&solv->portfolioq);
   queue_init(&solv->learnt_pool);
   queue_init(&solv->branches);
   queue_init(&solv->weakruleq);
@@ -1482,6 +1973,8 @@ solver_free(Solver *solv)
   queue_free(&solv->decisionq_why);
   queue_free(&solv->decisionq_reason);
   queue_free(&solv->learnt_why);
+  queue_free(&solv->learnt_info);
+  queue_free(&solv->portfolioq);
   queue_free(&solv->learnt_pool);
   queue_free(&solv->problems);
   queue_free(&solv->solutions);
@@ -1520,6 +2013,7 @@ solver_free(Solver *solv)
   solv_free(solv->decisionmap);
   solv_free(solv->rules);
   solv_free(solv->watches);
+  freewatchvecs(solv);
   solv_free(solv->obsoletes);
   solv_free(solv->obsoletes_data);
   solv_free(solv->specialupdaters);
@@ -1528,6 +2022,8 @@ solver_free(Solver *solv)
   solv_free(solv->yumobsrules_info);
   solv_free(solv->recommendsrules_info);
   solv_free(solv->instbuddy);
+  if (solv->havewhatprovidesoverlay)
+    pool_whatprovides_overlay_end(solv->pool, solv->promoteproviders);
   solv_free(solv);
 }
 
@@ -1578,6 +2074,16 @@ solver_get_flag(Solver *solv, int flag)
     return solv->focus_installed;
   case SOLVER_FLAG_FOCUS_NEW:
     return solv->focus_new;
+  case SOLVER_FLAG_LOCAL_PROVIDERS:
+    return solv->localproviders;
+  case SOLVER_FLAG_PROMOTE_PROVIDERS:
+    return solv->promoteproviders;
+  case SOLVER_FLAG_WATCH_VECTORS:
+    return solv->watchvectors;
+  case SOLVER_FLAG_REDUCE_LEARNT:
+    return solv->reducelearnt;
+  case SOLVER_FLAG_KEEP_LEARNT:
+    return solv->keeplearnt;
   case SOLVER_FLAG_FOCUS_BEST:
     return solv->focus_best;
   case SOLVER_FLAG_YUM_OBSOLETES:
@@ -1669,6 +2175,21 @@ solver_set_flag(Solver *solv, int flag, int value)
   case SOLVER_FLAG_FOCUS_NEW:
     solv->focus_new = value;
     break;
+  case SOLVER_FLAG_LOCAL_PROVIDERS:
+    solv->localproviders = value;
+    break;
+  case SOLVER_FLAG_PROMOTE_PROVIDERS:
+    solv->promoteproviders = value;
+    break;
+  case SOLVER_FLAG_WATCH_VECTORS:
+    solv->watchvectors = value;
+    break;
+  case SOLVER_FLAG_REDUCE_LEARNT:
+    solv->reducelearnt = value;
+    break;
+  case SOLVER_FLAG_KEEP_LEARNT:
+    solv->keeplearnt = value;
+    break;
   case SOLVER_FLAG_FOCUS_BEST:
     solv->focus_best = value;
     break;
@@ -2881,6 +3402,12 @@ solver_run_sat(Solver *solv, int disablerules, int doweak)
   minimizationsteps = 0;
   for (;;)
     {
+      if (solv->aborted)
+	{
+	  level = -1;
+	  break;
+	}
+
       /*
        * initial propagation of the assertions
        */
@@ -3529,6 +4056,155 @@ deduceq2addedmap(Solver *solv, Map *addedmap)
     }
 }
 
+/*-------------------------------------------------------------------
+ *
+ * keep learnt rules for the next solver run
+ *
+ * a learnt rule whose proof only consists of pkg rules and other such
+ * learnt rules is true for every job, as the pkg rules are kept when
+ * the solver is reused. The pkg rules get resorted when new rules are
+ * added for the next job, so we save the rule contents of the proof
+ * and look up the new rule ids after the pkg rules are unified.
+ *
+ * kq gets: p, w2, d, lbd, proof..., 0 for every kept learnt rule
+ * proof elements are pkg rule numbers in pq and negated kept rule
+ * numbers for learnt rules, both starting with 1.
+ * pq gets: p, w2, d for every pkg rule used in a proof.
+ */
+
+static int
+savelearntrules(Solver *solv, Queue *kq, Queue *pq)
+{
+  Id *pkgidx, *keptidx;
+  Id rid, d, why;
+  Rule *r, *pr;
+  int i, start, nkept = 0;
+
+  pkgidx = solv_calloc(solv->pkgrules_end, sizeof(Id));
+  keptidx = solv_calloc(solv->nrules - solv->learntrules, sizeof(Id));
+  for (i = solv->learntrules, r = solv->rules + i; i < solv->nrules; i++, r++)
+    {
+      if (!r->p || learntrule_deleted(solv, i))
+	continue;
+      start = kq->count;
+      d = r->d < 0 ? -r->d - 1 : r->d;
+      queue_push2(kq, r->p, d ? 0 : r->w2);
+      queue_push2(kq, d, solv->learnt_info.count ? solv->learnt_info.elements[2 * (i - solv->learntrules)] : 0);
+      for (why = solv->learnt_why.elements[i - solv->learntrules]; (rid = solv->learnt_pool.elements[why]) != 0; why++)
+	{
+	  if (rid > 0 && rid < solv->pkgrules_end)
+	    {
+	      if (!pkgidx[rid])
+		{
+		  pr = solv->rules + rid;
+		  pkgidx[rid] = pq->count / 3 + 1;
+		  d = pr->d < 0 ? -pr->d - 1 : pr->d;
+		  queue_push2(pq, pr->p, d ? 0 : pr->w2);
+		  queue_push(pq, d);
+		}
+	      queue_push(kq, pkgidx[rid]);
+	    }
+	  else if (rid >= solv->learntrules && rid < i && keptidx[rid - solv->learntrules])
+	    queue_push(kq, -keptidx[rid - solv->learntrules]);
+	  else
+	    break;		/* depends on the job, can't keep it */
+	}
+      if (rid)
+	{
+	  queue_truncate(kq, start);
+	  continue;
+	}
+      queue_push(kq, 0);
+      keptidx[i - solv->learntrules] = ++nkept;
+    }
+  solv_free(pkgidx);
+  solv_free(keptidx);
+  return nkept;
+}
+
+/* find a pkg rule by its content. the pkg rules are sorted by unifyrules */
+static Id
+findpkgrule(Solver *solv, Id p, Id w2, Id d)
+{
+  Rule key, r;
+  int lo = 1, hi = solv->pkgrules_end, mid, c;
+
+  memset(&key, 0, sizeof(key));
+  key.p = p;
+  key.w2 = w2;
+  key.d = d;
+  while (lo < hi)
+    {
+      mid = lo + (hi - lo) / 2;
+      r = solv->rules[mid];
+      if (r.d < 0)
+	r.d = -r.d - 1;
+      c = solver_rulecmp(solv, &r, &key);
+      if (!c)
+	return mid;
+      if (c < 0)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return 0;
+}
+
+static int
+restorelearntrules(Solver *solv, Queue *kq, Queue *pq)
+{
+  Pool *pool = solv->pool;
+  Id *pkgmap, *keptmap, *kp, *kpend, *proof;
+  Id p, w2, d, lbd;
+  Rule *r;
+  int i, n = 0, nrestored = 0;
+
+  pkgmap = solv_calloc(pq->count / 3 + 1, sizeof(Id));
+  for (i = 0; i < pq->count; i += 3)
+    pkgmap[i / 3 + 1] = findpkgrule(solv, pq->elements[i], pq->elements[i + 1], pq->elements[i + 2]);
+  keptmap = solv_calloc(kq->count / 5 + 1, sizeof(Id));
+  for (kp = kq->elements, kpend = kp + kq->count; kp < kpend; kp++)
+    {
+      p = *kp++;
+      w2 = *kp++;
+      d = *kp++;
+      lbd = *kp++;
+      proof = kp;
+      for (; *kp; kp++)
+	if (!(*kp > 0 ? pkgmap[*kp] : keptmap[-*kp]))
+	  break;
+      n++;
+      if (*kp)
+	{
+	  while (*kp)
+	    kp++;
+	  continue;	/* pkg rule is gone */
+	}
+      r = solver_addrule(solv, p, d ? 0 : w2, d);
+      keptmap[n] = r - solv->rules;
+      queue_push(&solv->learnt_why, solv->learnt_pool.count);
+      for (kp = proof; *kp; kp++)
+	queue_push(&solv->learnt_pool, *kp > 0 ? pkgmap[*kp] : keptmap[-*kp]);
+      queue_push(&solv->learnt_pool, 0);
+      if (solv->reducelearnt)
+	{
+	  if (!lbd)
+	    {
+	      /* no lbd known, use the number of literals */
+	      lbd = w2 ? 2 : 1;
+	      if (d)
+		for (i = d; pool->whatprovidesdata[i]; i++)
+		  lbd++;
+	    }
+	  queue_push2(&solv->learnt_info, lbd, 0);
+	}
+      nrestored++;
+    }
+  solv_free(pkgmap);
+  solv_free(keptmap);
+  return nrestored;
+}
+
 #ifdef ENABLE_COMPLEX_DEPS
 static int
 add_complex_jobrules(Solver *solv, Id dep, int flags, int jobidx, int weak)
@@ -3635,14 +4311,46 @@ setup_favormap(Solver *solv)
     }
 }
 
+/* update the memory high water marks of the solve statistics */
+static void
+update_memory_stats(Solver *solv)
+{
+  SolverStats *stats = &solv->stats;
+  int i, nsolvables = solv->pool->nsolvables;
+  size_t rules, watches = 0, learnt, decisions;
+
+  rules = solv->nrules * sizeof(Rule);
+  if (solv->watchvecs)
+    {
+      for (i = 0; i < solv->nwatchvecs; i++)
+	watches += (solv->watchvecs[i].count + solv->implications[i].count) * sizeof(Id);
+      watches += 2 * solv->nwatchvecs * sizeof(Queue);
+    }
+  else if (solv->watches)
+    watches = 2 * nsolvables * sizeof(Id);
+  learnt = (solv->learnt_pool.count + solv->learnt_why.count + solv->learnt_info.count) * sizeof(Id);
+  decisions = nsolvables * sizeof(Id);
+  decisions += (solv->decisionq.count + solv->decisionq_why.count + solv->decisionq_reason.count + solv->branches.count) * sizeof(Id);
+  if (rules > stats->mem_rules)
+    stats->mem_rules = rules;
+  if (watches > stats->mem_watches)
+    stats->mem_watches = watches;
+  if (learnt > stats->mem_learnt)
+    stats->mem_learnt = learnt;
+  if (decisions > stats->mem_decisions)
+    stats->mem_decisions = decisions;
+  if (rules + watches + learnt + decisions > stats->mem_total)
+    stats->mem_total = rules + watches + learnt + decisions;
+}
+
 /*
  *
  * solve job queue
  *
  */
 
-int
-solver_solve(Solver *solv, Queue *job)
+static int
+solver_solve_job(Solver *solv, Queue *job)
 {
   Pool *pool = solv->pool;
   Repo *installed = solv->installed;
@@ -3655,12 +4363,14 @@ solver_solve(Solver *solv, Queue *job)
   Solvable *s, *name_s;
   Rule *r;
   int now, solve_start;
+  unsigned int unifytime = 0;
   int needduprules = 0;
   int hasbestinstalljob = 0;
   int hasfavorjob = 0;
   int haslockjob = 0;
   int hasblacklistjob = 0;
   int hasexcludefromweakjob = 0;
+  Queue keptlearnt, keptpkgrules;
 
   solve_start = solv_timems(0);
 
@@ -3677,6 +4387,13 @@ solver_solve(Solver *solv, Queue *job)
   if (!pool->whatprovides)
     pool_createwhatprovides(pool);
 
+  /* keep our provider data local if requested */
+  if (solv->localproviders && !solv->havewhatprovidesoverlay)
+    {
+      pool_whatprovides_overlay_begin(pool);
+      solv->havewhatprovidesoverlay = 1;
+    }
+
   /* create obsolete index */
   policy_create_obsolete_index(solv);
 
@@ -3688,6 +4405,12 @@ solver_solve(Solver *solv, Queue *job)
     queue_insertn(&solv->job, 0, pool->pooljobs.count, pool->pooljobs.elements);
   job = &solv->job;
 
+  /* save the learnt rules we can use for this job */
+  queue_init(&keptlearnt);
+  queue_init(&keptpkgrules);
+  if (solv->keeplearnt && solv->learntrules && solv->pkgrules_end)
+    savelearntrules(solv, &keptlearnt, &keptpkgrules);
+
   /* free old stuff in case we re-run a solver */
   queuep_free(&solv->update_targets);
   queuep_free(&solv->cleandeps_updatepkgs);
@@ -3719,6 +4442,7 @@ solver_solve(Solver *solv, Queue *job)
   solv->favormap = solv_free(solv->favormap);
   queue_empty(&solv->weakruleq);
   solv->watches = solv_free(solv->watches);
+  freewatchvecs(solv);
   queue_empty(&solv->ruletojob);
   if (solv->decisionq.count)
     memset(solv->decisionmap, 0, pool->nsolvables * sizeof(Id));
@@ -3726,6 +4450,7 @@ solver_solve(Solver *solv, Queue *job)
   queue_empty(&solv->decisionq_why);
   queue_empty(&solv->decisionq_reason);
   queue_empty(&solv->learnt_why);
+  queue_empty(&solv->learnt_info);
   queue_empty(&solv->learnt_pool);
   queue_empty(&solv->branches);
   solv->propagate_index = 0;
@@ -3733,6 +4458,10 @@ solver_solve(Solver *solv, Queue *job)
   queue_empty(&solv->solutions);
   queue_empty(&solv->orphaned);
   solv->stats_learned = solv->stats_unsolvable = 0;
+  solv->stats_propagations = solv->stats_binaryvisits = solv->stats_longvisits = 0;
+  solv->stats_reductions = solv->stats_learntdeleted = 0;
+  solv->nextreducelearnt = reducelearnt_interval(solv);
+  solv->stats_branches = 0;
   if (solv->recommends_index)
     {
       map_empty(&solv->recommendsmap);
@@ -3896,13 +4625,14 @@ solver_solve(Solver *solv, Queue *job)
       if (solv->update_targets)
 	transform_update_targets(solv);
 
-      oldnrules = solv->nrules;
+      queue_empty(&q);
       FOR_REPO_SOLVABLES(installed, p, s)
-	solver_addpkgrulesforsolvable(solv, s, &addedmap);
+	queue_push(&q, p);
+      oldnrules = solv->nrules;
+      solver_addpkgrulesforsolvables(solv, &q, &addedmap);
       POOL_DEBUG(SOLV_DEBUG_STATS, "added %d pkg rules for installed solvables\n", solv->nrules - oldnrules);
       oldnrules = solv->nrules;
-      FOR_REPO_SOLVABLES(installed, p, s)
-	solver_addpkgrulesforupdaters(solv, s, &addedmap, 1);
+      solver_addpkgrulesforupdaters(solv, &q, &addedmap, 1);
       POOL_DEBUG(SOLV_DEBUG_STATS, "added %d pkg rules for updaters of installed solvables\n", solv->nrules - oldnrules);
     }
 
@@ -3912,6 +4642,7 @@ solver_solve(Solver *solv, Queue *job)
    */
 
   oldnrules = solv->nrules;
+  queue_empty(&q);
   for (i = 0; i < job->count; i += 2)
     {
       how = job->elements[i];
@@ -3924,7 +4655,7 @@ solver_solve(Solver *solv, Queue *job)
 	  FOR_JOB_SELECT(p, pp, select, what)
 	    {
 	      MAPSET(&installcandidatemap, p);
-	      solver_addpkgrulesforsolvable(solv, pool->solvables + p, &addedmap);
+	      queue_push(&q, p);
 	    }
 	  break;
 	case SOLVER_DISTUPGRADE:
@@ -3936,6 +4667,7 @@ solver_solve(Solver *solv, Queue *job)
 	  break;
 	}
     }
+  solver_addpkgrulesforsolvables(solv, &q, &addedmap);
   POOL_DEBUG(SOLV_DEBUG_STATS, "added %d pkg rules for packages involved in a job\n", solv->nrules - oldnrules);
 
 
@@ -3974,7 +4706,12 @@ solver_solve(Solver *solv, Queue *job)
     }
 
   if (solv->nrules > initialnrules)
-    solver_unifyrules(solv);			/* remove duplicate pkg rules */
+    {
+      unifytime = solv_timems(0);
+      solver_unifyrules(solv);			/* remove duplicate pkg rules */
+      unifytime = solv_timems(unifytime);
+      solv->stats.time_unify += unifytime;
+    }
   solv->pkgrules_end = solv->nrules;		/* mark end of pkg rules */
   solv->lastpkgrule = 0;
 
@@ -3983,6 +4720,9 @@ solver_solve(Solver *solv, Queue *job)
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "pkg rule memory used: %d K\n", solv->nrules * (int)sizeof(Rule) / 1024);
   POOL_DEBUG(SOLV_DEBUG_STATS, "pkg rule creation took %d ms\n", solv_timems(now));
+  solv->stats.time_pkgrules += solv_timems(now) - unifytime;
+
+  now = solv_timems(0);
 
   /* create dup maps if needed. We need the maps early to create our
    * update rules */
@@ -4381,7 +5121,9 @@ solver_solve(Solver *solv, Queue *job)
    solv->recommendsrules_end - solv->recommendsrules,
    solv->strictrepopriorules_end - solv->strictrepopriorules);
   POOL_DEBUG(SOLV_DEBUG_STATS, "overall rule memory used: %d K\n", solv->nrules * (int)sizeof(Rule) / 1024);
+  solv->stats.time_rules += solv_timems(now);
 
+  now = solv_timems(0);
   /* create weak map */
   if (solv->weakruleq.count || solv->recommendsruleq)
     {
@@ -4414,6 +5156,15 @@ solver_solve(Solver *solv, Queue *job)
   /* all new rules are learnt after this point */
   solv->learntrules = solv->nrules;
 
+  /* add back the learnt rules of the last run */
+  if (keptlearnt.count)
+    {
+      int nkept = restorelearntrules(solv, &keptlearnt, &keptpkgrules);
+      POOL_DEBUG(SOLV_DEBUG_STATS, "kept %d learnt rules from the last run\n", nkept);
+    }
+  queue_free(&keptlearnt);
+  queue_free(&keptpkgrules);
+
   /* create watches chains */
   makewatches(solv);
 
@@ -4430,6 +5181,9 @@ solver_solve(Solver *solv, Queue *job)
   if (solv->process_orphans && solv->orphaned.count && solv->break_orphans)
     solver_breakorphans(solv);
 
+  solv->stats.time_weakrules += solv_timems(now);
+  update_memory_stats(solv);
+
   /*
    * ********************************************
    * solve!
@@ -4439,23 +5193,367 @@ solver_solve(Solver *solv, Queue *job)
   now = solv_timems(0);
   solver_run_sat(solv, 1, solv->dontinstallrecommended ? 0 : 1);
   POOL_DEBUG(SOLV_DEBUG_STATS, "solver took %d ms\n", solv_timems(now));
+  solv->stats.time_sat += solv_timems(now);
+  update_memory_stats(solv);
+
+  solv->budgetactive = 0;
+
+  if (solv->aborted)
+    {
+      /* the decisions are incomplete and the problems are not meaningful */
+      queue_empty(&solv->problems);
+      POOL_DEBUG(SOLV_DEBUG_STATS, "solver aborted: %d learned rules, %d unsolvable, %d decisions\n", solv->stats_learned, solv->stats_unsolvable, solv->stats_decisions);
+      POOL_DEBUG(SOLV_DEBUG_STATS, "solver_solve took %d ms\n", solv_timems(solve_start));
+      return -1;
+    }
 
   /*
    * prepare solution queue if there were problems
    */
+  now = solv_timems(0);
   solver_prepare_solutions(solv);
+  solv->stats.time_problems += solv_timems(now);
 
   POOL_DEBUG(SOLV_DEBUG_STATS, "final solver statistics: %d problems, %d learned rules, %d unsolvable\n", solv->problems.count / 2, solv->stats_learned, solv->stats_unsolvable);
+  POOL_DEBUG(SOLV_DEBUG_STATS, "propagation statistics: %u propagated decisions, %u binary rule visits, %u long rule visits\n", solv->stats_propagations, solv->stats_binaryvisits, solv->stats_longvisits);
+  if (solv->stats_reductions)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "learnt rule reduction: %d reductions, %d deleted learnt rules\n", solv->stats_reductions, solv->stats_learntdeleted);
+  if (pool->evrcmpcache)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "evr compare cache: %u hits, %u misses\n", pool->evrcmpcachehits, pool->evrcmpcachemisses);
   POOL_DEBUG(SOLV_DEBUG_STATS, "solver_solve took %d ms\n", solv_timems(solve_start));
 
   /* return number of problems */
   return solv->problems.count ? solv->problems.count / 2 : 0;
 }
 
+/* add the statistics of a solver pass to the solve statistics */
+static void
+add_pass_stats(Solver *solv)
+{
+  SolverStats *stats = &solv->stats;
+
+  stats->runs++;
+  stats->propagations += solv->stats_propagations;
+  stats->binaryvisits += solv->stats_binaryvisits;
+  stats->longvisits += solv->stats_longvisits;
+  stats->branches += solv->stats_branches;
+  stats->conflicts += solv->stats_learned + solv->stats_unsolvable;
+  stats->learnt += solv->stats_learned;
+  stats->unsolvable += solv->stats_unsolvable;
+  stats->reductions += solv->stats_reductions;
+  stats->learntdeleted += solv->stats_learntdeleted;
+}
+
+/*
+ * one solver pass over the job. A portfolio solves again with the
+ * flags of the winning strategy, so there may be two passes.
+ */
+static int
+solver_solve_pass(Solver *solv, Queue *job)
+{
+  int ret;
+
+  solv->budgetactive = 1;
+  solv->aborted = 0;
+  solv->stats_decisions = 0;
+  if (solv->localproviders)
+    pool_whatprovides_overlay_enter(solv->pool);
+  ret = solver_solve_job(solv, job);
+  add_pass_stats(solv);
+  if (solv->localproviders)
+    pool_whatprovides_overlay_leave(solv->pool);
+  solv->stats.decisions += solv->stats_decisions;
+  return ret;
+}
+
+/* apply the flags of the strategy at position pos of the portfolio
+ * queue, returns the position of the next strategy. The old values
+ * are pushed to savedq if it is not zero. */
+static int
+portfolio_setflags(Solver *solv, Queue *q, int pos, Queue *savedq)
+{
+  int old;
+  for (; pos < q->count && q->elements[pos]; pos += 2)
+    {
+      old = solver_set_flag(solv, q->elements[pos], pos + 1 < q->count ? q->elements[pos + 1] : 1);
+      if (savedq)
+	queue_push2(savedq, q->elements[pos], old);
+    }
+  return pos + 1;
+}
+
+/* copy a job to the pool of a strategy. The provider lists of
+ * SOLVER_SOLVABLE_ONE_OF jobs may be private to our snapshot. */
+static void
+portfolio_copyjob(Pool *pool, Pool *spool, Queue *job, Queue *sjob)
+{
+  int i, n;
+  Id *wp;
+
+  queue_init_clone(sjob, job);
+  if (spool == pool)
+    return;
+  for (i = 0; i < sjob->count; i += 2)
+    if ((sjob->elements[i] & SOLVER_SELECTMASK) == SOLVER_SOLVABLE_ONE_OF)
+      {
+	wp = pool->whatprovidesdata + sjob->elements[i + 1];
+	for (n = 0; wp[n]; n++)
+	  ;
+	sjob->elements[i + 1] = pool_ids2whatprovides(spool, wp, n);
+      }
+}
+
+static void
+portfolio_thread(void *data, int idx)
+{
+  struct s_Portfolio *pf = data;
+  Solver *solv = pf->solvs[idx];
+
+  if (portfolio_getbest(pf) < idx)
+    {
+      pf->results[idx] = -1;
+      return;
+    }
+  pf->results[idx] = solver_solve_pass(solv, pf->jobs + idx);
+  if (solv->aborted)
+    pf->results[idx] = -1;
+  else
+    portfolio_setbest(pf, idx);
+}
+
+/*
+ * run the configured strategy and the portfolio strategies with the
+ * portfolio budget. The strategies run in parallel if the pool is a
+ * snapshot and we may use threads, every other strategy then uses its
+ * own snapshot of the frozen pool. Otherwise they run one after the
+ * other, which gives the same result.
+ * If the configured strategy did not win, we switch to the flags of
+ * the winner and solve again without the portfolio budget.
+ */
+static int
+solver_solve_portfolio(Solver *solv, Queue *job)
+{
+  Pool *pool = solv->pool;
+  Pool *spool;
+  Solver *s;
+  struct s_Portfolio pf;
+  int i, n, pos, flag, v, ret, budget_conflicts;
+  int threaded = 0;
+
+  for (n = 1, pos = 0; pos < solv->portfolioq.count; n++)
+    {
+      while (pos < solv->portfolioq.count && solv->portfolioq.elements[pos])
+	pos += 2;
+      pos++;
+    }
+  memset(&pf, 0, sizeof(pf));
+  pf.solvs = solv_calloc(n, sizeof(Solver *));
+  pf.jobs = solv_calloc(n, sizeof(Queue));
+  pf.results = solv_calloc(n, sizeof(int));
+  pf.best = n;
+#ifdef ENABLE_THREADS
+  pthread_mutex_init(&pf.lock, 0);
+  threaded = pool->snapshotof && solv->nthreads > 1;
+#endif
+
+  budget_conflicts = solv->budget_conflicts;
+  if (!budget_conflicts || budget_conflicts > solv->budget_portfolio)
+    solv->budget_conflicts = solv->budget_portfolio;
+  pf.solvs[0] = solv;
+  queue_init_clone(pf.jobs, job);
+  for (i = 1, pos = 0; i < n; i++)
+    {
+      spool = threaded ? pool_create_snapshot(pool->snapshotof) : pool;
+      if (spool != pool)
+	{
+	  queue_free(&spool->pooljobs);
+	  portfolio_copyjob(pool, spool, &pool->pooljobs, &spool->pooljobs);
+	}
+      s = solver_create(spool);
+      for (flag = 1; flag <= SOLVER_FLAG_KEEP_LEARNT; flag++)
+	if ((v = solver_get_flag(solv, flag)) >= 0)
+	  solver_set_flag(s, flag, v);
+      pos = portfolio_setflags(s, &solv->portfolioq, pos, 0);
+      s->budgetstart = solv->budgetstart;
+      s->budget_time = solv->budget_time;
+      s->budget_conflicts = solv->budget_conflicts;
+      s->budget_decisions = solv->budget_decisions;
+      s->portfolio = &pf;
+      s->portfolioidx = i;
+      pf.solvs[i] = s;
+      portfolio_copyjob(pool, spool, job, pf.jobs + i);
+    }
+  solv->portfolio = &pf;
+  POOL_DEBUG(SOLV_DEBUG_STATS, "portfolio: %d strategies with %d conflicts each%s\n", n, solv->budget_conflicts, threaded ? ", running in parallel" : "");
+  if (threaded)
+    solv_runthreads(n, portfolio_thread, &pf);
+  else
+    for (i = 0; i < n; i++)
+      portfolio_thread(&pf, i);
+  solv->portfolio = 0;
+  solv->budget_conflicts = budget_conflicts;
+
+  /* free the strategies, their whatprovides overlays must end
+   * before we solve again */
+  for (i = 1; i < n; i++)
+    {
+      spool = pf.solvs[i]->pool;
+      solver_free(pf.solvs[i]);
+      if (spool != pool)
+	pool_free(spool);
+      queue_free(pf.jobs + i);
+    }
+
+  /* pick the first strategy that finished */
+  for (i = 0; i < n; i++)
+    if (pf.results[i] >= 0)
+      break;
+  ret = pf.results[0];
+  if (!i)
+    POOL_DEBUG(SOLV_DEBUG_STATS, "portfolio: the configured strategy won\n");
+  else if (i < n)
+    {
+      Queue savedq;
+
+      POOL_DEBUG(SOLV_DEBUG_STATS, "portfolio: strategy %d won, switching to it\n", i);
+      for (pos = 0; --i > 0; pos++)
+	while (pos < solv->portfolioq.count && solv->portfolioq.elements[pos])
+	  pos += 2;
+      queue_init(&savedq);
+      portfolio_setflags(solv, &solv->portfolioq, pos, &savedq);
+      ret = solver_solve_pass(solv, job);
+      /* restore the configured flags */
+      while (savedq.count)
+	{
+	  v = queue_pop(&savedq);
+	  solver_set_flag(solv, queue_pop(&savedq), v);
+	}
+      queue_free(&savedq);
+    }
+  else if (solv->aborted == SOLVER_BUDGET_CONFLICTS && (!budget_conflicts || budget_conflicts > solv->budget_portfolio))
+    {
+      POOL_DEBUG(SOLV_DEBUG_STATS, "portfolio: no strategy finished, solving without the portfolio budget\n");
+      ret = solver_solve_pass(solv, job);
+    }
+  else
+    POOL_DEBUG(SOLV_DEBUG_STATS, "portfolio: no strategy finished within the budget\n");
+
+  queue_free(pf.jobs);
+#ifdef ENABLE_THREADS
+  pthread_mutex_destroy(&pf.lock);
+#endif
+  solv_free(pf.solvs);
+  solv_free(pf.jobs);
+  solv_free(pf.results);
+  return ret;
+}
+
+int
+solver_solve(Solver *solv, Queue *job)
+{
+  unsigned int start = solv_timems(0);
+  int ret;
+
+  memset(&solv->stats, 0, sizeof(solv->stats));
+  solv->budgetstart = start;	/* the time budget is for the whole call */
+  if (solv->portfolioq.count && solv->budget_portfolio > 0)
+    ret = solver_solve_portfolio(solv, job);
+  else
+    ret = solver_solve_pass(solv, job);
+  solv->stats.time_total = solv_timems(start);
+  return ret;
+}
+
+int
+solver_set_budget(Solver *solv, int budget, int value)
+{
+  int old = solver_get_budget(solv, budget);
+  switch (budget)
+  {
+  case SOLVER_BUDGET_TIME:
+    solv->budget_time = value;
+    break;
+  case SOLVER_BUDGET_CONFLICTS:
+    solv->budget_conflicts = value;
+    break;
+  case SOLVER_BUDGET_DECISIONS:
+    solv->budget_decisions = value;
+    break;
+  case SOLVER_BUDGET_PORTFOLIO:
+    solv->budget_portfolio = value;
+    break;
+  default:
+    break;
+  }
+  return old;
+}
+
+int
+solver_get_budget(Solver *solv, int budget)
+{
+  switch (budget)
+  {
+  case SOLVER_BUDGET_TIME:
+    return solv->budget_time;
+  case SOLVER_BUDGET_CONFLICTS:
+    return solv->budget_conflicts;
+  case SOLVER_BUDGET_DECISIONS:
+    return solv->budget_decisions;
+  case SOLVER_BUDGET_PORTFOLIO:
+    return solv->budget_portfolio;
+  default:
+    break;
+  }
+  return -1;
+}
+
+/* returns the exhausted budget if the last solver_solve was aborted */
+int
+solver_get_aborted(Solver *solv)
+{
+  return solv->aborted;
+}
+
+/* set the number of worker threads, returns the old number */
+int
+solver_set_nthreads(Solver *solv, int nthreads)
+{
+  int old = solv->nthreads;
+  solv->nthreads = nthreads > 1 ? nthreads : 1;
+  return old;
+}
+
+int
+solver_get_nthreads(Solver *solv)
+{
+  return solv->nthreads;
+}
+
+/* set the additional strategies for solver_solve. Every strategy is
+ * a list of flag/value pairs terminated by a zero */
+void
+solver_set_portfolio(Solver *solv, Queue *strategies)
+{
+  queue_free(&solv->portfolioq);
+  if (strategies)
+    queue_init_clone(&solv->portfolioq, strategies);
+  else
+    queue_init(&solv->portfolioq);
+}
+
 Transaction *
 solver_create_transaction(Solver *solv)
 {
-  return transaction_create_decisionq(solv->pool, &solv->decisionq, &solv->multiversion);
+  unsigned int now = solv_timems(0);
+  Transaction *trans = transaction_create_decisionq(solv->pool, &solv->decisionq, &solv->multiversion);
+  solv->stats.time_transaction += solv_timems(now);
+  return trans;
+}
+
+void
+solver_get_stats(Solver *solv, SolverStats *stats)
+{
+  *stats = solv->stats;
 }
 
 void solver_get_orphaned(Solver *solv, Queue *orphanedq)
@@ -26,6 +26,39 @@
 extern "C" {
 #endif
 
+/* statistics of the last solver_solve() call, see solver_get_stats() */
+typedef struct s_SolverStats {
+  /* phase timings in ms */
+  unsigned int time_pkgrules;		/* pkg rule creation without unification */
+  unsigned int time_unify;		/* removal of duplicate pkg rules */
+  unsigned int time_rules;		/* creation of all other rules */
+  unsigned int time_weakrules;		/* weak rule map, watches and policy rule setup */
+  unsigned int time_sat;		/* the sat loop */
+  unsigned int time_problems;		/* problem analysis and solution creation */
+  unsigned int time_transaction;	/* solver_create_transaction() */
+  unsigned int time_total;		/* the complete solver_solve() call */
+
+  /* counts, summed over all solver runs */
+  unsigned int runs;			/* solver runs, a portfolio may solve again */
+  unsigned int propagations;		/* propagated decisions */
+  unsigned int binaryvisits;		/* binary rules looked at in propagate */
+  unsigned int longvisits;		/* long rules looked at in propagate */
+  unsigned int decisions;		/* free decisions */
+  unsigned int branches;		/* decisions with alternatives */
+  unsigned int conflicts;		/* analyzed conflicts */
+  unsigned int learnt;			/* learnt rules */
+  unsigned int unsolvable;		/* conflicts that lead to a problem */
+  unsigned int reductions;		/* learnt rule reductions */
+  unsigned int learntdeleted;		/* learnt rules deleted by the reductions */
+
+  /* memory high water marks in bytes */
+  size_t mem_rules;			/* the rules */
+  size_t mem_watches;			/* watch lists or watch vectors */
+  size_t mem_learnt;			/* learnt rule proofs and info */
+  size_t mem_decisions;			/* decision map and queues, branches */
+  size_t mem_total;			/* sum of the above */
+} SolverStats;
+
 struct s_Solver {
   Pool *pool;				/* back pointer to pool */
   Queue job;				/* copy of the job we're solving */
@@ -113,6 +146,13 @@ struct s_Solver {
 					 * middle-solvable : decision to conflict, offset point to linked-list of rules
 					 * middle+solvable : decision to install: offset point to linked-list of rules
 					 */
+  Queue *watchvecs;			/* used instead of watches with SOLVER_FLAG_WATCH_VECTORS:
+					 * (rule, blocker) pairs for every literal, addressed from the middle
+					 */
+  Queue *implications;			/* binary rules with SOLVER_FLAG_WATCH_VECTORS:
+					 * (rule, other literal) pairs for every literal
+					 */
+  int nwatchvecs;			/* number of allocated watchvecs and implications */
 
   Queue ruletojob;                      /* index into job queue: jobs for which a rule exits */
 
@@ -129,6 +169,7 @@ struct s_Solver {
   /* learnt rule history */
   Queue learnt_why;
   Queue learnt_pool;
+  Queue learnt_info;			/* (lbd, last use) for every learnt rule, lbd 0: deleted */
 
   Queue branches;
   int propagate_index;                  /* index into decisionq for non-propagated decisions */
@@ -140,6 +181,14 @@ struct s_Solver {
 
   int stats_learned;			/* statistic */
   int stats_unsolvable;			/* statistic */
+  unsigned int stats_propagations;	/* statistic: propagated decisions */
+  unsigned int stats_binaryvisits;	/* statistic: binary rules looked at in propagate */
+  unsigned int stats_longvisits;	/* statistic: long rules looked at in propagate */
+  int stats_decisions;			/* statistic: free decisions */
+  int stats_reductions;			/* statistic: learnt rule reductions */
+  int stats_learntdeleted;		/* statistic: deleted learnt rules */
+  int stats_branches;			/* statistic: created branches */
+  SolverStats stats;			/* statistics of the last solver_solve call */
 
   Map recommendsmap;			/* recommended packages from decisionmap */
   Map suggestsmap;			/* suggested packages from decisionmap */
@@ -222,6 +271,26 @@ struct s_Solver {
   int do_extra_reordering;		/* reorder for future installed packages */
 
   Queue *recommendsruleq;		/* pkg rules comming from recommends */
+
+  int localproviders;			/* true: drop the provider data added by the solver when it is freed */
+  int promoteproviders;			/* true: keep the lazily computed providers when dropping */
+  int havewhatprovidesoverlay;		/* we started a whatprovides overlay */
+  int watchvectors;			/* use per literal watch vectors instead of linked lists */
+  int reducelearnt;			/* periodically delete learnt rules, > 1: first interval */
+  int nextreducelearnt;			/* reduce when stats_learned reaches this */
+  int keeplearnt;			/* keep learnt rules deduced from pkg rules for the next solve */
+  int nthreads;				/* worker threads for the pkg rule creation */
+  Queue portfolioq;			/* additional strategies: flag/value pairs, 0 terminated */
+  struct s_Portfolio *portfolio;	/* the portfolio we are running in */
+  int portfolioidx;			/* our strategy in the portfolio */
+
+  int budget_time;			/* abort solver_solve after this many ms */
+  int budget_conflicts;			/* abort after this many conflicts */
+  int budget_decisions;			/* abort after this many decisions */
+  int budget_portfolio;			/* conflicts for every strategy of the portfolio */
+  int budgetactive;			/* check the budget, set while solver_solve runs */
+  unsigned int budgetstart;		/* solv_timems() at the start of solver_solve */
+  int aborted;				/* the exhausted budget if solver_solve was aborted */
 #endif	/* LIBSOLV_INTERNAL */
 };
 
@@ -339,6 +408,16 @@ typedef struct s_Solver Solver;
 #define SOLVER_FLAG_ONLY_NAMESPACE_RECOMMENDED	27
 #define SOLVER_FLAG_STRICT_REPO_PRIORITY	28
 #define SOLVER_FLAG_FOCUS_NEW			29
+#define SOLVER_FLAG_LOCAL_PROVIDERS		30
+#define SOLVER_FLAG_PROMOTE_PROVIDERS		31
+#define SOLVER_FLAG_WATCH_VECTORS		32
+#define SOLVER_FLAG_REDUCE_LEARNT		33
+#define SOLVER_FLAG_KEEP_LEARNT			34
+
+#define SOLVER_BUDGET_TIME			1	/* wall clock milliseconds */
+#define SOLVER_BUDGET_CONFLICTS			2
+#define SOLVER_BUDGET_DECISIONS			3
+#define SOLVER_BUDGET_PORTFOLIO			4	/* conflicts per portfolio strategy */
 
 #define GET_USERINSTALLED_NAMES			(1 << 0)	/* package names instead of ids */
 #define GET_USERINSTALLED_INVERTED		(1 << 1)	/* autoinstalled */
@@ -364,6 +443,13 @@ extern int  solver_solve(Solver *solv, Queue *job);
 extern Transaction *solver_create_transaction(Solver *solv);
 extern int solver_set_flag(Solver *solv, int flag, int value);
 extern int solver_get_flag(Solver *solv, int flag);
+extern int solver_set_budget(Solver *solv, int budget, int value);
+extern int solver_get_budget(Solver *solv, int budget);
+extern int solver_get_aborted(Solver *solv);
+extern int solver_set_nthreads(Solver *solv, int nthreads);
+extern int solver_get_nthreads(Solver *solv);
+extern void solver_set_portfolio(Solver *solv, Queue *strategies);
+extern void solver_get_stats(Solver *solv, SolverStats *stats);
 
 extern int  solver_get_decisionlevel(Solver *solv, Id p);
 extern void solver_get_decisionqueue(Solver *solv, Queue *decisionq);
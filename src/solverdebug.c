@@ -169,6 +169,21 @@ solver_printwatches(Solver *solv, int type)
   int counter;
 
   POOL_DEBUG(type, "Watches: \n");
+  if (solv->watchvecs)
+    {
+      Queue *wq;
+      int i;
+      for (counter = -(pool->nsolvables - 1); counter < pool->nsolvables; counter++)
+	{
+	  wq = solv->watchvecs + counter + pool->nsolvables;
+	  for (i = wq->count - 2; i >= 0; i -= 2)
+	    POOL_DEBUG(type, "    solvable [%d] -- rule [%d] blocker [%d]\n", counter, wq->elements[i], wq->elements[i + 1]);
+	  wq = solv->implications + counter + pool->nsolvables;
+	  for (i = wq->count - 2; i >= 0; i -= 2)
+	    POOL_DEBUG(type, "    solvable [%d] -- binary rule [%d] implies [%d]\n", counter, wq->elements[i], wq->elements[i + 1]);
+	}
+      return;
+    }
   for (counter = -(pool->nsolvables - 1); counter < pool->nsolvables; counter++)
     POOL_DEBUG(type, "    solvable [%d] -- rule [%d]\n", counter, solv->watches[counter + pool->nsolvables]);
 }
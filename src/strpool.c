@@ -12,6 +12,20 @@
 #define STRING_BLOCK      2047
 #define STRINGSPACE_BLOCK 65535
 
+#ifdef ENABLE_FAST_STRINGHASH
+/* The hash table is followed by a second table containing the
+ * complete hash value of every entry. Probing compares those before
+ * looking at the strings, and growing the table does not need to
+ * rehash the strings. */
+#define STRINGPOOL_HASHTAGS 1
+#define stringpool_hash(str) strhash_words(str)
+#define stringpool_nhash(str, len) strnhash_words(str, len)
+#else
+#define STRINGPOOL_HASHTAGS 0
+#define stringpool_hash(str) strhash(str)
+#define stringpool_nhash(str, len) strnhash(str, len)
+#endif
+
 void
 stringpool_init(Stringpool *ss, const char *strs[])
 {
@@ -78,6 +92,11 @@ stringpool_resize_hash(Stringpool *ss, int numnew)
   Hashval h, hh, hashmask;
   Hashtable hashtbl;
   int i;
+#if STRINGPOOL_HASHTAGS
+  Hashtable oldhashtbl = ss->stringhashtbl;
+  Hashval oldhashmask = ss->stringhashmask, hv;
+  Id id;
+#endif
 
   if (numnew <= 0)
     return;
@@ -87,6 +106,37 @@ stringpool_resize_hash(Stringpool *ss, int numnew)
 
   /* realloc hash table */
   ss->stringhashmask = hashmask;
+#if STRINGPOOL_HASHTAGS
+  ss->stringhashtbl = hashtbl = (Hashtable)solv_calloc(2 * (hashmask + 1), sizeof(Id));
+  if (oldhashtbl)
+    {
+      /* move the entries over, the tags contain the hash values */
+      for (i = 0; i <= (int)oldhashmask; i++)
+	{
+	  if (!(id = oldhashtbl[i]))
+	    continue;
+	  hv = (Hashval)oldhashtbl[oldhashmask + 1 + i];
+	  h = hv & hashmask;
+	  hh = HASHCHAIN_START;
+	  while (hashtbl[h] != 0)
+	    h = HASHCHAIN_NEXT(h, hh, hashmask);
+	  hashtbl[h] = id;
+	  hashtbl[hashmask + 1 + h] = (Id)hv;
+	}
+      solv_free(oldhashtbl);
+      return;
+    }
+  for (i = 1; i < ss->nstrings; i++)
+    {
+      hv = stringpool_hash(ss->stringspace + ss->strings[i]);
+      h = hv & hashmask;
+      hh = HASHCHAIN_START;
+      while (hashtbl[h] != 0)
+	h = HASHCHAIN_NEXT(h, hh, hashmask);
+      hashtbl[h] = i;
+      hashtbl[hashmask + 1 + h] = (Id)hv;
+    }
+#else
   solv_free(ss->stringhashtbl);
   ss->stringhashtbl = hashtbl = (Hashtable)solv_calloc(hashmask + 1, sizeof(Id));
   
@@ -99,12 +149,13 @@ stringpool_resize_hash(Stringpool *ss, int numnew)
 	h = HASHCHAIN_NEXT(h, hh, hashmask);
       hashtbl[h] = i;
     }
+#endif
 }
 
 Id
 stringpool_strn2id(Stringpool *ss, const char *str, unsigned int len, int create)
 {
-  Hashval h, hh, hashmask;
+  Hashval h, hh, hashmask, hv;
   Id id;
   Hashtable hashtbl;
 
@@ -130,10 +181,18 @@ stringpool_strn2id(Stringpool *ss, const char *str, unsigned int len, int create
   hashtbl = ss->stringhashtbl;
 
   /* compute hash and check for match */
-  h = strnhash(str, len) & hashmask;
+  hv = stringpool_nhash(str, len);
+  h = hv & hashmask;
   hh = HASHCHAIN_START;
   while ((id = hashtbl[h]) != 0)
     {
+#if STRINGPOOL_HASHTAGS
+      if (hashtbl[hashmask + 1 + h] != (Id)hv)
+	{
+	  h = HASHCHAIN_NEXT(h, hh, hashmask);
+	  continue;
+	}
+#endif
       if(!memcmp(ss->stringspace + ss->strings[id], str, len)
          && ss->stringspace[ss->strings[id] + len] == 0)
 	break;
@@ -145,6 +204,9 @@ stringpool_strn2id(Stringpool *ss, const char *str, unsigned int len, int create
   /* generate next id and save in table */
   id = ss->nstrings++;
   hashtbl[h] = id;
+#if STRINGPOOL_HASHTAGS
+  hashtbl[hashmask + 1 + h] = (Id)hv;
+#endif
 
   ss->strings = solv_extend(ss->strings, id, 1, sizeof(Offset), STRING_BLOCK);
   ss->strings[id] = ss->sstrings;	/* we will append to the end */
@@ -190,7 +252,7 @@ stringpool_integrate(Stringpool *ss, int numid, Offset sizeid, Id *idmap)
   Id id;
   int i, l;
   char *strsp, *sp;
-  Hashval hashmask, h, hh;
+  Hashval hashmask, h, hh, hv;
   Hashtable hashtbl;
 
   stringpool_resize_hash(ss, numid);
@@ -221,25 +283,34 @@ stringpool_integrate(Stringpool *ss, int numid, Offset sizeid, Id *idmap)
 	  continue;
 	}
 
+      /* length == offset to next string */
+      l = strlen(sp) + 1;
+
       /* find hash slot */
-      h = strhash(sp) & hashmask;
+      hv = stringpool_nhash(sp, l - 1);
+      h = hv & hashmask;
       hh = HASHCHAIN_START;
       for (;;)
 	{
 	  id = hashtbl[h];
 	  if (!id)
 	    break;
+#if STRINGPOOL_HASHTAGS
+	  if (hashtbl[hashmask + 1 + h] == (Id)hv && !strcmp(ss->stringspace + ss->strings[id], sp))
+#else
 	  if (!strcmp(ss->stringspace + ss->strings[id], sp))
+#endif
 	    break;			/* already in pool */
 	  h = HASHCHAIN_NEXT(h, hh, hashmask);
 	}
 
-      /* length == offset to next string */
-      l = strlen(sp) + 1;
       if (!id)				/* end of hash chain -> new string */
 	{
 	  id = ss->nstrings++;
 	  hashtbl[h] = id;
+#if STRINGPOOL_HASHTAGS
+	  hashtbl[hashmask + 1 + h] = (Id)hv;
+#endif
 	  str[id] = ss->sstrings;	/* save offset */
 	  if (sp != ss->stringspace + ss->sstrings)
 	    memmove(ss->stringspace + ss->sstrings, sp, l);
@@ -19,6 +19,10 @@
   #include <sys/time.h>
 #endif
 
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+#endif
+
 #include "util.h"
 
 void
@@ -440,3 +444,64 @@ solv_replacebadutf8(const char *buf, int replchar)
   return r;
 }
 
+
+#ifdef ENABLE_THREADS
+
+struct solv_thread {
+  void (*run)(void *, int);
+  void *data;
+  int idx;
+};
+
+static void *
+solv_thread_start(void *arg)
+{
+  struct solv_thread *t = arg;
+  t->run(t->data, t->idx);
+  return 0;
+}
+
+#endif
+
+/*
+ * call run(data, idx) for all idx in [0, nthreads) and wait for all
+ * calls to finish. The calls are done in parallel worker threads if
+ * libsolv was built with thread support, otherwise (or if a thread
+ * cannot be created) they are done one after the other.
+ */
+void
+solv_runthreads(int nthreads, void (*run)(void *data, int idx), void *data)
+{
+  int i;
+#ifdef ENABLE_THREADS
+  pthread_t *tids;
+  struct solv_thread *ts;
+
+  if (nthreads > 1)
+    {
+      tids = solv_calloc(nthreads, sizeof(*tids));
+      ts = solv_calloc(nthreads, sizeof(*ts));
+      for (i = 1; i < nthreads; i++)
+	{
+	  ts[i].run = run;
+	  ts[i].data = data;
+	  ts[i].idx = i;
+	  if (pthread_create(tids + i, 0, solv_thread_start, ts + i) != 0)
+	    ts[i].run = 0;	/* do it ourself */
+	}
+      run(data, 0);
+      for (i = 1; i < nthreads; i++)
+	{
+	  if (ts[i].run)
+	    pthread_join(tids[i], 0);
+	  else
+	    run(data, i);
+	}
+      solv_free(ts);
+      solv_free(tids);
+      return;
+    }
+#endif
+  for (i = 0; i < nthreads; i++)
+    run(data, i);
+}
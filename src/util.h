@@ -43,6 +43,7 @@ extern char *solv_bin2hex(const unsigned char *buf, int l, char *str);
 extern size_t solv_validutf8(const char *buf);
 extern char *solv_latin1toutf8(const char *buf);
 extern char *solv_replacebadutf8(const char *buf, int replchar);
+extern void solv_runthreads(int nthreads, void (*run)(void *data, int idx), void *data);
 
 
 static inline void *solv_extend(void *buf, size_t len, size_t nmemb, size_t size, size_t block)
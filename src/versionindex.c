@@ -0,0 +1,218 @@
+/*
+ * versionindex.c
+ *
+ * Per name index of the versioned provides, sorted by evr.
+ *
+ * Looking up the providers of a simple version relation like
+ * "foo >= 1.2" means comparing the evr of every provides of every
+ * package providing foo. With POOL_FLAG_VERSIONINDEX the "foo = evr"
+ * provides of the providers of a name get sorted by epoch and version
+ * once, so that a relation is resolved by two binary searches. Only
+ * the entries that compare equal in epoch and version need a real
+ * match, as their release decides. Providers that provide the name
+ * in some other way (unversioned, with a range, ...) are not indexed
+ * and get checked the old way by pool_addrelproviders. The index is
+ * not used with POOL_FLAG_PROMOTEEPOCH.
+ *
+ * The index of a name is built on the first lookup and remembers the
+ * provider list it was made from, so that it gets rebuilt if the
+ * providers of the name change.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "evr.h"
+#include "util.h"
+
+#define VERSIONINDEX_BLOCK	4095
+
+/* don't bother to index names with less providers */
+#define VERSIONINDEX_MINPROVIDERS	8
+
+static int
+versionindex_sortcmp(const void *ap, const void *bp, void *dp)
+{
+  Pool *pool = dp;
+  const Id *a = ap, *b = bp;
+  int r;
+
+  if (a[0] != b[0])
+    {
+      r = pool_evrcmp(pool, a[0], b[0], EVRCMP_COMPARE_EVONLY);
+      if (r)
+	return r;
+    }
+  return a[1] - b[1];
+}
+
+/*
+ * index layout in versionindexdata:
+ *   whatprovides offset of the name the index was built from
+ *   number of entries
+ *   entries: (evr, solvable) pairs sorted by epoch/version
+ *   zero terminated list of the providers that are not indexed
+ */
+static Offset
+versionindex_build(Pool *pool, Id name, Id wp)
+{
+  Queue q, fallbackq;
+  Id p, *pp, pid, *pidp;
+  Reldep *prd;
+  Solvable *s;
+  Offset off;
+  int start, n;
+
+  queue_init(&q);
+  queue_init(&fallbackq);
+  for (pp = pool->whatprovidesdata + wp; (p = *pp++) != 0; )
+    {
+      s = pool->solvables + p;
+      if (!s->provides || s->arch == ARCH_SRC || s->arch == ARCH_NOSRC)
+	{
+	  queue_push(&fallbackq, p);
+	  continue;
+	}
+      start = q.count;
+      pidp = s->repo->idarraydata + s->provides;
+      while ((pid = *pidp++) != 0)
+	{
+	  if (!ISRELDEP(pid))
+	    {
+	      if (pid == name)
+		break;		/* unversioned provides */
+	      continue;
+	    }
+	  prd = GETRELDEP(pool, pid);
+	  if (prd->name != name)
+	    continue;
+	  if (prd->flags != REL_EQ || ISRELDEP(prd->evr))
+	    break;		/* not a simple version */
+	  queue_push2(&q, prd->evr, p);
+	}
+      if (pid || q.count == start)
+	{
+	  queue_truncate(&q, start);
+	  queue_push(&fallbackq, p);
+	}
+    }
+  n = q.count / 2;
+  solv_sort(q.elements, n, 2 * sizeof(Id), versionindex_sortcmp, pool);
+
+  if (!pool->versionindexdata)
+    {
+      pool->versionindexdata = solv_extend_resize(0, 1, sizeof(Id), VERSIONINDEX_BLOCK);
+      pool->versionindexdataoff = 1;	/* offset 0 means no index */
+    }
+  off = pool->versionindexdataoff;
+  pool->versionindexdata = solv_extend(pool->versionindexdata, off, 2 + q.count + fallbackq.count + 1, sizeof(Id), VERSIONINDEX_BLOCK);
+  pp = pool->versionindexdata + off;
+  *pp++ = wp;
+  *pp++ = n;
+  if (q.count)
+    memcpy(pp, q.elements, q.count * sizeof(Id));
+  pp += q.count;
+  if (fallbackq.count)
+    memcpy(pp, fallbackq.elements, fallbackq.count * sizeof(Id));
+  pp += fallbackq.count;
+  *pp++ = 0;
+  pool->versionindexdataoff = pp - pool->versionindexdata;
+  queue_free(&q);
+  queue_free(&fallbackq);
+
+  if (name >= pool->nversionindex)
+    {
+      pool->versionindex = solv_realloc2(pool->versionindex, pool->ss.nstrings, sizeof(Offset));
+      memset(pool->versionindex + pool->nversionindex, 0, (pool->ss.nstrings - pool->nversionindex) * sizeof(Offset));
+      pool->nversionindex = pool->ss.nstrings;
+    }
+  pool->versionindex[name] = off;
+  return off;
+}
+
+/*
+ * pool_versionindex_addproviders()
+ *
+ * called by pool_addrelproviders for the simple relation
+ * "name flags evr". Adds the indexed providers that match to plist
+ * and returns the zero terminated list of providers that still need
+ * to be checked. Returns 0 if there is no index for the name, the
+ * caller then has to check all providers.
+ * Note that plist is not sorted and may contain duplicates.
+ */
+Id *
+pool_versionindex_addproviders(Pool *pool, Id name, int flags, Id evr, Queue *plist)
+{
+  Id wp, *ep, *pp;
+  Offset off;
+  int i, n, lo, hi, m;
+
+  if (!pool->versionindexenabled || ISRELDEP(name) || ISRELDEP(evr) || !flags || flags >= 8)
+    return 0;
+  if (pool->promoteepoch)
+    return 0;		/* epoch promotion is not symmetric, so there is no order */
+  wp = pool_whatprovides(pool, name);
+  off = name < pool->nversionindex ? pool->versionindex[name] : 0;
+  if (!off || pool->versionindexdata[off] != wp)
+    {
+      if (pool->frozen)
+	return 0;		/* the data of a frozen pool is read-only */
+      for (pp = pool->whatprovidesdata + wp, i = 0; *pp; pp++)
+	i++;
+      if (i < VERSIONINDEX_MINPROVIDERS)
+	return 0;
+      off = versionindex_build(pool, name, wp);
+    }
+  n = pool->versionindexdata[off + 1];
+  ep = pool->versionindexdata + off + 2;
+  if (flags == (REL_LT | REL_EQ | REL_GT))
+    {
+      for (i = 0; i < n; i++)
+	queue_push(plist, ep[2 * i + 1]);
+      return ep + 2 * n;
+    }
+  /* find the entries with the same epoch and version */
+  lo = 0;
+  hi = n;
+  while (lo < hi)
+    {
+      m = (lo + hi) / 2;
+      if (pool_evrcmp(pool, ep[2 * m], evr, EVRCMP_COMPARE_EVONLY) < 0)
+	lo = m + 1;
+      else
+	hi = m;
+    }
+  hi = n;
+  for (i = lo; i < hi; )
+    {
+      m = (i + hi) / 2;
+      if (pool_evrcmp(pool, ep[2 * m], evr, EVRCMP_COMPARE_EVONLY) <= 0)
+	i = m + 1;
+      else
+	hi = m;
+    }
+  if ((flags & REL_LT) != 0)
+    for (i = 0; i < lo; i++)
+      queue_push(plist, ep[2 * i + 1]);
+  for (i = lo; i < hi; i++)
+    if (pool_intersect_evrs(pool, REL_EQ, ep[2 * i], flags, evr))
+      queue_push(plist, ep[2 * i + 1]);
+  if ((flags & REL_GT) != 0)
+    for (i = hi; i < n; i++)
+      queue_push(plist, ep[2 * i + 1]);
+  return ep + 2 * n;
+}
+
+void
+pool_freeversionindex(Pool *pool)
+{
+  if (pool->frozen)
+    return;	/* the index of a frozen pool is shared */
+  pool->versionindex = solv_free(pool->versionindex);
+  pool->nversionindex = 0;
+  pool->versionindexdata = solv_free(pool->versionindexdata);
+  pool->versionindexdataoff = 0;
+}
@@ -0,0 +1,24 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Pkg: B 1 1 noarch
+#>=Req: C
+#>=Pkg: C 1 1 noarch
+#>=Pkg: C 2 1 noarch
+system i686 rpm system
+
+solverbudget decisions 1
+job install name B
+job update all packages
+result transaction,problems <inline>
+#>aborted decisions
+
+nextjob
+solverbudget decisions 10
+job install name B
+job update all packages
+result transaction,problems <inline>
+#>install B-1-1.noarch@available
+#>install C-2-1.noarch@available
+#>upgrade A-1-1.noarch@system A-2-1.noarch@available
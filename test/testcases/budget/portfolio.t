@@ -0,0 +1,54 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+repo available 0 testtags <inline>
+#>=Pkg: B 1 1 noarch
+#>=Con: A
+system i686 rpm system
+
+solverbudget portfolio 1
+solverportfolio allowuninstall
+job install name B
+result transaction,problems <inline>
+#>erase A-1-1.noarch@system
+#>install B-1-1.noarch@available
+
+nextjob
+solverportfolio allowuninstall
+job install name B
+result transaction,problems <inline>
+#>problem b7ba8293 info package B-1-1.noarch conflicts with A provided by A-1-1.noarch
+#>problem b7ba8293 solution f229cf9d deljob install name B
+#>problem b7ba8293 solution f4ebe250 erase A-1-1.noarch@system
+
+# the configured flags are restored after switching to the winner,
+# so the reused solver needs the portfolio again
+nextjob
+solverbudget portfolio 1
+solverportfolio allowuninstall
+job install name B
+result transaction,problems,stats <inline>
+#>erase A-1-1.noarch@system
+#>install B-1-1.noarch@available
+#>stats conflicts 2 learnt 0 unsolvable 2
+#>stats runs 2 decisions 0 branches 0
+#>stats reductions 0 deleted 0
+nextjob reusesolver
+job install name B
+result transaction,problems,stats <inline>
+#>erase A-1-1.noarch@system
+#>install B-1-1.noarch@available
+#>stats conflicts 2 learnt 0 unsolvable 2
+#>stats runs 2 decisions 0 branches 0
+#>stats reductions 0 deleted 0
+
+# no second try if the portfolio budget is not below the conflict budget
+nextjob
+solverbudget conflicts 1
+solverbudget portfolio 1
+solverportfolio allowdowngrade
+job install name B
+result transaction,problems,stats <inline>
+#>aborted conflicts
+#>stats conflicts 1 learnt 0 unsolvable 1
+#>stats runs 1 decisions 0 branches 0
+#>stats reductions 0 deleted 0
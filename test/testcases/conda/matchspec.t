@@ -0,0 +1,161 @@
+repo system 0 testtags <inline>
+#>=Pkg: python 2.7.18 0 x86_64
+#>=Pkg: python 3.8.10 0 x86_64
+#>=Flv: h1234_0_cpython
+#>=Pkg: python 3.9.7 0 x86_64
+#>=Flv: h5678_1_cpython
+#>=Pkg: python 3.10.2 0 x86_64
+#>=Flv: h9abc_0_pypy
+#>=Pkg: pytest 7.1.2 0 x86_64
+#>=Pkg: pytest 6.2.5 0 x86_64
+#>=Pkg: PyYAML 6.0 0 x86_64
+#>=Pkg: numpy 1.21.5 0 x86_64
+#>=Flv: py39h1_0
+#>=Pkg: numpy 1.24.0 0 x86_64
+#>=Flv: py310h2_0
+#>=Pkg: numpy 1.24.0rc1 0 x86_64
+#>=Pkg: scipy 1.9.0 0 x86_64
+#>=Pkg: openssl 1.1.1q 0 x86_64
+#>=Pkg: openssl 3.0.5 0 x86_64
+system x86_64 conda system
+
+
+job erase provides python <CONDA> >=3.9
+result transaction,problems <inline>
+#>erase python-3.10.2-0-h9abc_0_pypy.x86_64@system
+#>erase python-3.9.7-0-h5678_1_cpython.x86_64@system
+
+nextjob
+job erase provides py* <CONDA> >=3
+result transaction,problems <inline>
+#>erase PyYAML-6.0-0.x86_64@system
+#>erase pytest-6.2.5-0.x86_64@system
+#>erase pytest-7.1.2-0.x86_64@system
+#>erase python-3.10.2-0-h9abc_0_pypy.x86_64@system
+#>erase python-3.8.10-0-h1234_0_cpython.x86_64@system
+#>erase python-3.9.7-0-h5678_1_cpython.x86_64@system
+
+nextjob
+job erase provides py* <CONDA> *
+result transaction,problems <inline>
+#>erase PyYAML-6.0-0.x86_64@system
+#>erase pytest-6.2.5-0.x86_64@system
+#>erase pytest-7.1.2-0.x86_64@system
+#>erase python-2.7.18-0.x86_64@system
+#>erase python-3.10.2-0-h9abc_0_pypy.x86_64@system
+#>erase python-3.8.10-0-h1234_0_cpython.x86_64@system
+#>erase python-3.9.7-0-h5678_1_cpython.x86_64@system
+
+nextjob
+job erase provides PY* <CONDA> >=6
+result transaction,problems <inline>
+#>erase PyYAML-6.0-0.x86_64@system
+#>erase pytest-6.2.5-0.x86_64@system
+#>erase pytest-7.1.2-0.x86_64@system
+
+nextjob
+job erase provides ^(py|num).*$ <CONDA> >=1.21,<7
+result transaction,problems <inline>
+#>erase PyYAML-6.0-0.x86_64@system
+#>erase numpy-1.21.5-0-py39h1_0.x86_64@system
+#>erase numpy-1.24.0-0-py310h2_0.x86_64@system
+#>erase numpy-1.24.0rc1-0.x86_64@system
+#>erase pytest-6.2.5-0.x86_64@system
+#>erase python-2.7.18-0.x86_64@system
+#>erase python-3.10.2-0-h9abc_0_pypy.x86_64@system
+#>erase python-3.8.10-0-h1234_0_cpython.x86_64@system
+#>erase python-3.9.7-0-h5678_1_cpython.x86_64@system
+
+nextjob
+job erase provides ^py[a-z]+$ <CONDA> *
+result transaction,problems <inline>
+#>erase PyYAML-6.0-0.x86_64@system
+#>erase pytest-6.2.5-0.x86_64@system
+#>erase pytest-7.1.2-0.x86_64@system
+#>erase python-2.7.18-0.x86_64@system
+#>erase python-3.10.2-0-h9abc_0_pypy.x86_64@system
+#>erase python-3.8.10-0-h1234_0_cpython.x86_64@system
+#>erase python-3.9.7-0-h5678_1_cpython.x86_64@system
+
+nextjob
+job erase provides numpy <CONDA> 1.24.*
+result transaction,problems <inline>
+#>erase numpy-1.24.0-0-py310h2_0.x86_64@system
+#>erase numpy-1.24.0rc1-0.x86_64@system
+
+nextjob
+job erase provides numpy <CONDA> 1.24.0rc1|1.21.5
+result transaction,problems <inline>
+#>erase numpy-1.21.5-0-py39h1_0.x86_64@system
+#>erase numpy-1.24.0rc1-0.x86_64@system
+
+nextjob
+job erase provides python <CONDA> 3.* *cpython
+result transaction,problems <inline>
+
+nextjob
+job erase provides python <CONDA> >=3 ^h9.*$
+result transaction,problems <inline>
+
+nextjob
+job erase provides python <CONDA> * h1234_0_cpython
+result transaction,problems <inline>
+
+nextjob
+job erase provides openssl <CONDA> ~=1.1.0
+result transaction,problems <inline>
+#>erase openssl-1.1.1q-0.x86_64@system
+
+nextjob
+job erase provides openssl <CONDA> !=1.1.*
+result transaction,problems <inline>
+#>erase openssl-3.0.5-0.x86_64@system
+
+nextjob
+job erase provides python <CONDA> (>=3.8,<3.10)|2.7.*
+result transaction,problems <inline>
+#>erase python-3.8.10-0-h1234_0_cpython.x86_64@system
+#>erase python-3.9.7-0-h5678_1_cpython.x86_64@system
+
+nextjob
+job erase provides numpy <CONDA> ^1\.2.*$
+result transaction,problems <inline>
+#>erase numpy-1.21.5-0-py39h1_0.x86_64@system
+#>erase numpy-1.24.0-0-py310h2_0.x86_64@system
+#>erase numpy-1.24.0rc1-0.x86_64@system
+
+nextjob
+job erase provides python <CONDA> 3.*.7
+result transaction,problems <inline>
+
+nextjob
+job erase provides python <CONDA> >=3.9,(
+result transaction,problems <inline>
+
+nextjob
+job erase provides *y* <CONDA> >=1
+result transaction,problems <inline>
+#>erase PyYAML-6.0-0.x86_64@system
+#>erase numpy-1.21.5-0-py39h1_0.x86_64@system
+#>erase numpy-1.24.0-0-py310h2_0.x86_64@system
+#>erase numpy-1.24.0rc1-0.x86_64@system
+#>erase pytest-6.2.5-0.x86_64@system
+#>erase pytest-7.1.2-0.x86_64@system
+#>erase python-2.7.18-0.x86_64@system
+#>erase python-3.10.2-0-h9abc_0_pypy.x86_64@system
+#>erase python-3.8.10-0-h1234_0_cpython.x86_64@system
+#>erase python-3.9.7-0-h5678_1_cpython.x86_64@system
+#>erase scipy-1.9.0-0.x86_64@system
+
+nextjob
+job erase provides openssl <CONDA> 3.0.5-0@
+result transaction,problems <inline>
+
+nextjob
+job erase provides num?y <CONDA> *
+result transaction,problems <inline>
+
+nextjob
+job erase provides sci* <CONDA> >1.8|<0.1
+result transaction,problems <inline>
+#>erase scipy-1.9.0-0.x86_64@system
@@ -0,0 +1,22 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1.0 1 noarch
+#>=Pkg: B 1.0 1 noarch
+repo available 0 testtags <inline>
+#>=Pkg: A 1.0 2 noarch
+#>=Pkg: A 1.10 1 noarch
+#>=Pkg: A 1.9 1 noarch
+#>=Req: B >= 1:1.0
+#>=Pkg: B 1.0 2 noarch
+#>=Pkg: B 1:0.5 1 noarch
+#>=Pkg: C 2.0~beta 1 noarch
+#>=Pkg: C 2.0 1 noarch
+#>=Req: A > 1.9
+system i686 rpm system
+poolflags evrcmpcache
+
+job update all packages
+job install name C
+result transaction,problems <inline>
+#>install C-2.0-1.noarch@available
+#>upgrade A-1.0-1.noarch@system A-1.10-1.noarch@available
+#>upgrade B-1.0-1.noarch@system B-1:0.5-1.noarch@available
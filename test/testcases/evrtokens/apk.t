@@ -0,0 +1,122 @@
+repo system 0 empty
+system i686 apk system
+poolflags evrtokens
+
+evrcmp 0 1
+evrcmp 1 0
+evrcmp 1 1.0
+evrcmp 1.0 1
+evrcmp 1.0 1.0.1
+evrcmp 1.0.1 1.0
+evrcmp 1.0.1 1.01
+evrcmp 1.01 1.0.1
+evrcmp 1.01 1.0a
+evrcmp 1.0a 1.01
+evrcmp 1.0a 1.0b
+evrcmp 1.0b 1.0a
+evrcmp 1.0b 1.0_alpha
+evrcmp 1.0_alpha 1.0b
+evrcmp 1.0_alpha 1.0_alpha1
+evrcmp 1.0_alpha1 1.0_alpha
+evrcmp 1.0_alpha1 1.0_beta
+evrcmp 1.0_beta 1.0_alpha1
+evrcmp 1.0_beta 1.0_pre1
+evrcmp 1.0_pre1 1.0_beta
+evrcmp 1.0_pre1 1.0_rc1
+evrcmp 1.0_rc1 1.0_pre1
+evrcmp 1.0_rc1 1.0_p1
+evrcmp 1.0_p1 1.0_rc1
+evrcmp 1.0_p1 1.0_git20200101
+evrcmp 1.0_git20200101 1.0_p1
+evrcmp 1.0_git20200101 1.0-r0
+evrcmp 1.0-r0 1.0_git20200101
+evrcmp 1.0-r0 1.0-r1
+evrcmp 1.0-r1 1.0-r0
+evrcmp 1.0-r1 1.0_rc1-r2
+evrcmp 1.0_rc1-r2 1.0-r1
+evrcmp 1.0_rc1-r2 2.0
+evrcmp 2.0 1.0_rc1-r2
+evrcmp 2.0 1.10
+evrcmp 1.10 2.0
+evrcmp 1.10 1.2.3_cvs
+evrcmp 1.2.3_cvs 1.10
+evrcmp 1.2.3_cvs 1.0_svn
+evrcmp 1.0_svn 1.2.3_cvs
+evrcmp 1.0_svn 1.0_hg1
+evrcmp 1.0_hg1 1.0_svn
+evrcmp 0 0
+evrcmp 1.0.1 1.0.1
+evrcmp 1.0b 1.0b
+evrcmp 1.0_beta 1.0_beta
+evrcmp 1.0_p1 1.0_p1
+evrcmp 1.0-r1 1.0-r1
+evrcmp 1.10 1.10
+evrcmp 1.0_hg1 1.0_hg1
+
+evrcmp 1.0 1.0-r3 compare
+evrcmp 1.0 1.0-r3 matchrelease
+evrcmp 1.0 1.0-r3 match
+evrcmp 1.0 1.0-r3 compareevonly
+evrcmp 1.0-r3 1.0 compare
+evrcmp 1.0-r3 1.0 matchrelease
+evrcmp 1.0-r3 1.0 match
+evrcmp 1.0-r3 1.0 compareevonly
+result jobs <inline>
+#>job noop provides 0 < 1
+#>job noop provides 0 = 0
+#>job noop provides 1 < 1.0
+#>job noop provides 1 > 0
+#>job noop provides 1.0 < 1.0-r3
+#>job noop provides 1.0 < 1.0-r3
+#>job noop provides 1.0 < 1.0-r3
+#>job noop provides 1.0 < 1.0-r3
+#>job noop provides 1.0 < 1.0.1
+#>job noop provides 1.0 > 1
+#>job noop provides 1.0-r0 < 1.0-r1
+#>job noop provides 1.0-r0 < 1.0_git20200101
+#>job noop provides 1.0-r1 = 1.0-r1
+#>job noop provides 1.0-r1 > 1.0-r0
+#>job noop provides 1.0-r1 > 1.0_rc1-r2
+#>job noop provides 1.0-r3 > 1.0
+#>job noop provides 1.0-r3 > 1.0
+#>job noop provides 1.0-r3 > 1.0
+#>job noop provides 1.0-r3 > 1.0
+#>job noop provides 1.0.1 < 1.01
+#>job noop provides 1.0.1 = 1.0.1
+#>job noop provides 1.0.1 > 1.0
+#>job noop provides 1.01 > 1.0.1
+#>job noop provides 1.01 > 1.0a
+#>job noop provides 1.0_alpha < 1.0_alpha1
+#>job noop provides 1.0_alpha < 1.0b
+#>job noop provides 1.0_alpha1 < 1.0_beta
+#>job noop provides 1.0_alpha1 > 1.0_alpha
+#>job noop provides 1.0_beta < 1.0_pre1
+#>job noop provides 1.0_beta = 1.0_beta
+#>job noop provides 1.0_beta > 1.0_alpha1
+#>job noop provides 1.0_git20200101 < 1.0_p1
+#>job noop provides 1.0_git20200101 > 1.0-r0
+#>job noop provides 1.0_hg1 = 1.0_hg1
+#>job noop provides 1.0_hg1 > 1.0_svn
+#>job noop provides 1.0_p1 = 1.0_p1
+#>job noop provides 1.0_p1 > 1.0_git20200101
+#>job noop provides 1.0_p1 > 1.0_rc1
+#>job noop provides 1.0_pre1 < 1.0_rc1
+#>job noop provides 1.0_pre1 > 1.0_beta
+#>job noop provides 1.0_rc1 < 1.0_p1
+#>job noop provides 1.0_rc1 > 1.0_pre1
+#>job noop provides 1.0_rc1-r2 < 1.0-r1
+#>job noop provides 1.0_rc1-r2 < 2.0
+#>job noop provides 1.0_svn < 1.0_hg1
+#>job noop provides 1.0_svn < 1.2.3_cvs
+#>job noop provides 1.0a < 1.01
+#>job noop provides 1.0a < 1.0b
+#>job noop provides 1.0b = 1.0b
+#>job noop provides 1.0b > 1.0_alpha
+#>job noop provides 1.0b > 1.0a
+#>job noop provides 1.10 < 2.0
+#>job noop provides 1.10 = 1.10
+#>job noop provides 1.10 > 1.2.3_cvs
+#>job noop provides 1.2.3_cvs < 1.10
+#>job noop provides 1.2.3_cvs > 1.0_svn
+#>job noop provides 2.0 > 1.0_rc1-r2
+#>job noop provides 2.0 > 1.10
@@ -0,0 +1,122 @@
+repo system 0 empty
+system i686 conda system
+poolflags evrtokens
+
+evrcmp 0 1
+evrcmp 1 0
+evrcmp 1 1.0
+evrcmp 1.0 1
+evrcmp 1.0 1.0.0
+evrcmp 1.0.0 1.0
+evrcmp 1.0.0 1.0.1
+evrcmp 1.0.1 1.0.0
+evrcmp 1.0.1 1.01
+evrcmp 1.01 1.0.1
+evrcmp 1.01 1.0a
+evrcmp 1.0a 1.01
+evrcmp 1.0a 1.0a1
+evrcmp 1.0a1 1.0a
+evrcmp 1.0a1 1.0b1
+evrcmp 1.0b1 1.0a1
+evrcmp 1.0b1 1.0rc1
+evrcmp 1.0rc1 1.0b1
+evrcmp 1.0rc1 1.0dev
+evrcmp 1.0dev 1.0rc1
+evrcmp 1.0dev 1.0.dev1
+evrcmp 1.0.dev1 1.0dev
+evrcmp 1.0.dev1 1.0post1
+evrcmp 1.0post1 1.0.dev1
+evrcmp 1.0post1 1.0_1
+evrcmp 1.0_1 1.0post1
+evrcmp 1.0_1 1!1.0
+evrcmp 1!1.0 1.0_1
+evrcmp 1!1.0 1.0+local
+evrcmp 1.0+local 1!1.0
+evrcmp 1.0+local 1.0+local.1
+evrcmp 1.0+local.1 1.0+local
+evrcmp 1.0+local.1 2.0
+evrcmp 2.0 1.0+local.1
+evrcmp 2.0 1.10
+evrcmp 1.10 2.0
+evrcmp 1.10 1.1.1
+evrcmp 1.1.1 1.10
+evrcmp 1.1.1 1.0.*
+evrcmp 1.0.* 1.1.1
+evrcmp 1.0.* 1.0*
+evrcmp 1.0* 1.0.*
+evrcmp 0 0
+evrcmp 1.0.0 1.0.0
+evrcmp 1.0a 1.0a
+evrcmp 1.0rc1 1.0rc1
+evrcmp 1.0post1 1.0post1
+evrcmp 1.0+local 1.0+local
+evrcmp 1.10 1.10
+evrcmp 1.0* 1.0*
+
+evrcmp 1.0 1.0.0 compare
+evrcmp 1.0 1.0.0 matchrelease
+evrcmp 1.0 1.0.0 match
+evrcmp 1.0 1.0.0 compareevonly
+evrcmp 1.0.* 1.0.1 compare
+evrcmp 1.0.* 1.0.1 matchrelease
+evrcmp 1.0.* 1.0.1 match
+evrcmp 1.0.* 1.0.1 compareevonly
+result jobs <inline>
+#>job noop provides 0 < 1
+#>job noop provides 0 = 0
+#>job noop provides 1 = 1.0
+#>job noop provides 1 > 0
+#>job noop provides 1!1.0 > 1.0+local
+#>job noop provides 1!1.0 > 1.0_1
+#>job noop provides 1.0 = 1
+#>job noop provides 1.0 = 1.0.0
+#>job noop provides 1.0 = 1.0.0
+#>job noop provides 1.0 = 1.0.0
+#>job noop provides 1.0 = 1.0.0
+#>job noop provides 1.0 = 1.0.0
+#>job noop provides 1.0* < 1.0.*
+#>job noop provides 1.0* = 1.0*
+#>job noop provides 1.0+local < 1!1.0
+#>job noop provides 1.0+local < 1.0+local.1
+#>job noop provides 1.0+local = 1.0+local
+#>job noop provides 1.0+local.1 < 2.0
+#>job noop provides 1.0+local.1 > 1.0+local
+#>job noop provides 1.0.* < 1.0.1
+#>job noop provides 1.0.* < 1.0.1
+#>job noop provides 1.0.* < 1.0.1
+#>job noop provides 1.0.* < 1.0.1
+#>job noop provides 1.0.* < 1.1.1
+#>job noop provides 1.0.* > 1.0*
+#>job noop provides 1.0.0 < 1.0.1
+#>job noop provides 1.0.0 = 1.0
+#>job noop provides 1.0.0 = 1.0.0
+#>job noop provides 1.0.1 < 1.01
+#>job noop provides 1.0.1 > 1.0.0
+#>job noop provides 1.0.dev1 < 1.0post1
+#>job noop provides 1.0.dev1 > 1.0dev
+#>job noop provides 1.01 > 1.0.1
+#>job noop provides 1.01 > 1.0a
+#>job noop provides 1.0_1 < 1!1.0
+#>job noop provides 1.0_1 < 1.0post1
+#>job noop provides 1.0a < 1.01
+#>job noop provides 1.0a < 1.0a1
+#>job noop provides 1.0a = 1.0a
+#>job noop provides 1.0a1 < 1.0b1
+#>job noop provides 1.0a1 > 1.0a
+#>job noop provides 1.0b1 < 1.0rc1
+#>job noop provides 1.0b1 > 1.0a1
+#>job noop provides 1.0dev < 1.0.dev1
+#>job noop provides 1.0dev < 1.0rc1
+#>job noop provides 1.0post1 = 1.0post1
+#>job noop provides 1.0post1 > 1.0.dev1
+#>job noop provides 1.0post1 > 1.0_1
+#>job noop provides 1.0rc1 = 1.0rc1
+#>job noop provides 1.0rc1 > 1.0b1
+#>job noop provides 1.0rc1 > 1.0dev
+#>job noop provides 1.1.1 < 1.10
+#>job noop provides 1.1.1 > 1.0.*
+#>job noop provides 1.10 < 2.0
+#>job noop provides 1.10 = 1.10
+#>job noop provides 1.10 > 1.1.1
+#>job noop provides 2.0 > 1.0+local.1
+#>job noop provides 2.0 > 1.10
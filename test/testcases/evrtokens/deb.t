@@ -0,0 +1,142 @@
+repo system 0 empty
+system i686 deb system
+poolflags evrtokens
+
+evrcmp 0 1
+evrcmp 1 0
+evrcmp 1 1.0
+evrcmp 1.0 1
+evrcmp 1.0 1.0.1
+evrcmp 1.0.1 1.0
+evrcmp 1.0.1 1.01
+evrcmp 1.01 1.0.1
+evrcmp 1.01 1.0a
+evrcmp 1.0a 1.01
+evrcmp 1.0a 1.0~rc1
+evrcmp 1.0~rc1 1.0a
+evrcmp 1.0~rc1 1.0~~
+evrcmp 1.0~~ 1.0~rc1
+evrcmp 1.0~~ 1.0~
+evrcmp 1.0~ 1.0~~
+evrcmp 1.0~ 1.0+b1
+evrcmp 1.0+b1 1.0~
+evrcmp 1.0+b1 1.0-1
+evrcmp 1.0-1 1.0+b1
+evrcmp 1.0-1 1.0-1ubuntu1
+evrcmp 1.0-1ubuntu1 1.0-1
+evrcmp 1.0-1ubuntu1 1.0-1~bpo1
+evrcmp 1.0-1~bpo1 1.0-1ubuntu1
+evrcmp 1.0-1~bpo1 1:0.5
+evrcmp 1:0.5 1.0-1~bpo1
+evrcmp 1:0.5 0:1.0
+evrcmp 0:1.0 1:0.5
+evrcmp 0:1.0 2.0.beta
+evrcmp 2.0.beta 0:1.0
+evrcmp 2.0.beta 1.a
+evrcmp 1.a 2.0.beta
+evrcmp 1.a 1.A
+evrcmp 1.A 1.a
+evrcmp 1.A 1.0.0.0
+evrcmp 1.0.0.0 1.A
+evrcmp 1.0.0.0 10
+evrcmp 10 1.0.0.0
+evrcmp 10 9.9
+evrcmp 9.9 10
+evrcmp 9.9 1.0:1
+evrcmp 1.0:1 9.9
+evrcmp 1.0:1 1.0-1-1
+evrcmp 1.0-1-1 1.0:1
+evrcmp 0 0
+evrcmp 1.0.1 1.0.1
+evrcmp 1.0~rc1 1.0~rc1
+evrcmp 1.0+b1 1.0+b1
+evrcmp 1.0-1~bpo1 1.0-1~bpo1
+evrcmp 2.0.beta 2.0.beta
+evrcmp 1.0.0.0 1.0.0.0
+evrcmp 1.0:1 1.0:1
+
+evrcmp 1:1.0 1:1.0-5 compare
+evrcmp 1:1.0 1:1.0-5 matchrelease
+evrcmp 1:1.0 1:1.0-5 match
+evrcmp 1:1.0 1:1.0-5 compareevonly
+evrcmp 1.0-5 1.0 compare
+evrcmp 1.0-5 1.0 matchrelease
+evrcmp 1.0-5 1.0 match
+evrcmp 1.0-5 1.0 compareevonly
+evrcmp 1.0 1.0-5 compare
+evrcmp 1.0 1.0-5 matchrelease
+evrcmp 1.0 1.0-5 match
+evrcmp 1.0 1.0-5 compareevonly
+evrcmp 1.0-1 1.0-1+b1 compare
+evrcmp 1.0-1 1.0-1+b1 matchrelease
+evrcmp 1.0-1 1.0-1+b1 match
+evrcmp 1.0-1 1.0-1+b1 compareevonly
+result jobs <inline>
+#>job noop provides 0 < 1
+#>job noop provides 0 = 0
+#>job noop provides 0:1.0 < 1:0.5
+#>job noop provides 0:1.0 < 2.0.beta
+#>job noop provides 1 < 1.0
+#>job noop provides 1 > 0
+#>job noop provides 1.0 < 1.0-5
+#>job noop provides 1.0 < 1.0-5
+#>job noop provides 1.0 < 1.0.1
+#>job noop provides 1.0 = 1.0-5
+#>job noop provides 1.0 = 1.0-5
+#>job noop provides 1.0 > 1
+#>job noop provides 1.0+b1 = 1.0+b1
+#>job noop provides 1.0+b1 > 1.0-1
+#>job noop provides 1.0+b1 > 1.0~
+#>job noop provides 1.0-1 < 1.0+b1
+#>job noop provides 1.0-1 < 1.0-1+b1
+#>job noop provides 1.0-1 < 1.0-1+b1
+#>job noop provides 1.0-1 < 1.0-1+b1
+#>job noop provides 1.0-1 < 1.0-1ubuntu1
+#>job noop provides 1.0-1 = 1.0-1+b1
+#>job noop provides 1.0-1-1 < 1.0:1
+#>job noop provides 1.0-1ubuntu1 > 1.0-1
+#>job noop provides 1.0-1ubuntu1 > 1.0-1~bpo1
+#>job noop provides 1.0-1~bpo1 < 1.0-1ubuntu1
+#>job noop provides 1.0-1~bpo1 < 1:0.5
+#>job noop provides 1.0-1~bpo1 = 1.0-1~bpo1
+#>job noop provides 1.0-5 = 1.0
+#>job noop provides 1.0-5 = 1.0
+#>job noop provides 1.0-5 > 1.0
+#>job noop provides 1.0-5 > 1.0
+#>job noop provides 1.0.0.0 < 1.A
+#>job noop provides 1.0.0.0 < 10
+#>job noop provides 1.0.0.0 = 1.0.0.0
+#>job noop provides 1.0.1 < 1.01
+#>job noop provides 1.0.1 = 1.0.1
+#>job noop provides 1.0.1 > 1.0
+#>job noop provides 1.01 > 1.0.1
+#>job noop provides 1.01 > 1.0a
+#>job noop provides 1.0:1 < 9.9
+#>job noop provides 1.0:1 = 1.0:1
+#>job noop provides 1.0:1 > 1.0-1-1
+#>job noop provides 1.0a < 1.01
+#>job noop provides 1.0a > 1.0~rc1
+#>job noop provides 1.0~ < 1.0+b1
+#>job noop provides 1.0~ > 1.0~~
+#>job noop provides 1.0~rc1 < 1.0a
+#>job noop provides 1.0~rc1 = 1.0~rc1
+#>job noop provides 1.0~rc1 > 1.0~~
+#>job noop provides 1.0~~ < 1.0~
+#>job noop provides 1.0~~ < 1.0~rc1
+#>job noop provides 1.A < 1.a
+#>job noop provides 1.A > 1.0.0.0
+#>job noop provides 1.a < 2.0.beta
+#>job noop provides 1.a > 1.A
+#>job noop provides 10 > 1.0.0.0
+#>job noop provides 10 > 9.9
+#>job noop provides 1:0.5 > 0:1.0
+#>job noop provides 1:0.5 > 1.0-1~bpo1
+#>job noop provides 1:1.0 < 1:1.0-5
+#>job noop provides 1:1.0 < 1:1.0-5
+#>job noop provides 1:1.0 = 1:1.0-5
+#>job noop provides 1:1.0 = 1:1.0-5
+#>job noop provides 2.0.beta = 2.0.beta
+#>job noop provides 2.0.beta > 0:1.0
+#>job noop provides 2.0.beta > 1.a
+#>job noop provides 9.9 < 10
+#>job noop provides 9.9 > 1.0:1
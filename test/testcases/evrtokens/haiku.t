@@ -0,0 +1,102 @@
+repo system 0 empty
+system i686 haiku system
+poolflags evrtokens
+
+evrcmp 0 1
+evrcmp 1 0
+evrcmp 1 1.0
+evrcmp 1.0 1
+evrcmp 1.0 1.0.1
+evrcmp 1.0.1 1.0
+evrcmp 1.0.1 1.01
+evrcmp 1.01 1.0.1
+evrcmp 1.01 1.0a
+evrcmp 1.0a 1.01
+evrcmp 1.0a 1.0~beta1
+evrcmp 1.0~beta1 1.0a
+evrcmp 1.0~beta1 1.0~beta2
+evrcmp 1.0~beta2 1.0~beta1
+evrcmp 1.0~beta2 1.0-1
+evrcmp 1.0-1 1.0~beta2
+evrcmp 1.0-1 1.0-2
+evrcmp 1.0-2 1.0-1
+evrcmp 1.0-2 1.0.beta
+evrcmp 1.0.beta 1.0-2
+evrcmp 1.0.beta 1:1.0
+evrcmp 1:1.0 1.0.beta
+evrcmp 1:1.0 r1~alpha4_pm_hrev51
+evrcmp r1~alpha4_pm_hrev51 1:1.0
+evrcmp r1~alpha4_pm_hrev51 r1~beta1_hrev53000
+evrcmp r1~beta1_hrev53000 r1~alpha4_pm_hrev51
+evrcmp r1~beta1_hrev53000 2.0_1
+evrcmp 2.0_1 r1~beta1_hrev53000
+evrcmp 2.0_1 1.a
+evrcmp 1.a 2.0_1
+evrcmp 0 0
+evrcmp 1.0.1 1.0.1
+evrcmp 1.0~beta1 1.0~beta1
+evrcmp 1.0-2 1.0-2
+evrcmp r1~alpha4_pm_hrev51 r1~alpha4_pm_hrev51
+evrcmp 1.a 1.a
+
+evrcmp 1:1.0 1:1.0-5 compare
+evrcmp 1:1.0 1:1.0-5 matchrelease
+evrcmp 1:1.0 1:1.0-5 match
+evrcmp 1:1.0 1:1.0-5 compareevonly
+evrcmp 1.0-5 1.0 compare
+evrcmp 1.0-5 1.0 matchrelease
+evrcmp 1.0-5 1.0 match
+evrcmp 1.0-5 1.0 compareevonly
+evrcmp 1.0 1.0-5 compare
+evrcmp 1.0 1.0-5 matchrelease
+evrcmp 1.0 1.0-5 match
+evrcmp 1.0 1.0-5 compareevonly
+result jobs <inline>
+#>job noop provides 0 < 1
+#>job noop provides 0 = 0
+#>job noop provides 1 < 1.0
+#>job noop provides 1 > 0
+#>job noop provides 1.0 < 1.0-5
+#>job noop provides 1.0 < 1.0-5
+#>job noop provides 1.0 < 1.0.1
+#>job noop provides 1.0 = 1.0-5
+#>job noop provides 1.0 = 1.0-5
+#>job noop provides 1.0 > 1
+#>job noop provides 1.0-1 < 1.0-2
+#>job noop provides 1.0-1 > 1.0~beta2
+#>job noop provides 1.0-2 < 1.0.beta
+#>job noop provides 1.0-2 = 1.0-2
+#>job noop provides 1.0-2 > 1.0-1
+#>job noop provides 1.0-5 = 1.0
+#>job noop provides 1.0-5 = 1.0
+#>job noop provides 1.0-5 > 1.0
+#>job noop provides 1.0-5 > 1.0
+#>job noop provides 1.0.1 < 1.01
+#>job noop provides 1.0.1 = 1.0.1
+#>job noop provides 1.0.1 > 1.0
+#>job noop provides 1.0.beta < 1:1.0
+#>job noop provides 1.0.beta > 1.0-2
+#>job noop provides 1.01 > 1.0.1
+#>job noop provides 1.01 > 1.0a
+#>job noop provides 1.0a < 1.01
+#>job noop provides 1.0a > 1.0~beta1
+#>job noop provides 1.0~beta1 < 1.0a
+#>job noop provides 1.0~beta1 < 1.0~beta2
+#>job noop provides 1.0~beta1 = 1.0~beta1
+#>job noop provides 1.0~beta2 < 1.0-1
+#>job noop provides 1.0~beta2 > 1.0~beta1
+#>job noop provides 1.a < 2.0_1
+#>job noop provides 1.a = 1.a
+#>job noop provides 1:1.0 < 1:1.0-5
+#>job noop provides 1:1.0 < 1:1.0-5
+#>job noop provides 1:1.0 = 1:1.0-5
+#>job noop provides 1:1.0 = 1:1.0-5
+#>job noop provides 1:1.0 > 1.0.beta
+#>job noop provides 1:1.0 > r1~alpha4_pm_hrev51
+#>job noop provides 2.0_1 < r1~beta1_hrev53000
+#>job noop provides 2.0_1 > 1.a
+#>job noop provides r1~alpha4_pm_hrev51 < 1:1.0
+#>job noop provides r1~alpha4_pm_hrev51 < r1~beta1_hrev53000
+#>job noop provides r1~alpha4_pm_hrev51 = r1~alpha4_pm_hrev51
+#>job noop provides r1~beta1_hrev53000 > 2.0_1
+#>job noop provides r1~beta1_hrev53000 > r1~alpha4_pm_hrev51
@@ -0,0 +1,206 @@
+repo system 0 empty
+system i686 rpm system
+poolflags evrtokens
+
+evrcmp 0 1
+evrcmp 1 0
+evrcmp 1 1.0
+evrcmp 1.0 1
+evrcmp 1.0 1.0.1
+evrcmp 1.0.1 1.0
+evrcmp 1.0.1 1.01
+evrcmp 1.01 1.0.1
+evrcmp 1.01 1.00010
+evrcmp 1.00010 1.01
+evrcmp 1.00010 1.a
+evrcmp 1.a 1.00010
+evrcmp 1.a 1.A
+evrcmp 1.A 1.a
+evrcmp 1.A 1.0a
+evrcmp 1.0a 1.A
+evrcmp 1.0a 1.0~rc1
+evrcmp 1.0~rc1 1.0a
+evrcmp 1.0~rc1 1.0~rc1~git1
+evrcmp 1.0~rc1~git1 1.0~rc1
+evrcmp 1.0~rc1~git1 1.0^
+evrcmp 1.0^ 1.0~rc1~git1
+evrcmp 1.0^ 1.0^git1
+evrcmp 1.0^git1 1.0^
+evrcmp 1.0^git1 1.0^git1~pre
+evrcmp 1.0^git1~pre 1.0^git1
+evrcmp 1.0^git1~pre 1.0-1
+evrcmp 1.0-1 1.0^git1~pre
+evrcmp 1.0-1 1.0-2
+evrcmp 1.0-2 1.0-1
+evrcmp 1.0-2 1.0-10
+evrcmp 1.0-10 1.0-2
+evrcmp 1.0-10 1.0-1.el8
+evrcmp 1.0-1.el8 1.0-10
+evrcmp 1.0-1.el8 1:0.5
+evrcmp 1:0.5 1.0-1.el8
+evrcmp 1:0.5 0:1.0
+evrcmp 0:1.0 1:0.5
+evrcmp 0:1.0 1:1.0-1
+evrcmp 1:1.0-1 0:1.0
+evrcmp 1:1.0-1 2.0_beta
+evrcmp 2.0_beta 1:1.0-1
+evrcmp 2.0_beta 2.0+b1
+evrcmp 2.0+b1 2.0_beta
+evrcmp 2.0+b1 abcdefgh
+evrcmp abcdefgh 2.0+b1
+evrcmp abcdefgh abcdefghi
+evrcmp abcdefghi abcdefgh
+evrcmp abcdefghi 20160101
+evrcmp 20160101 abcdefghi
+evrcmp 20160101 123456789
+evrcmp 123456789 20160101
+evrcmp 123456789 1.0..1
+evrcmp 1.0..1 123456789
+evrcmp 1.0..1 v1
+evrcmp v1 1.0..1
+evrcmp v1 1.0a1
+evrcmp 1.0a1 v1
+evrcmp 0 0
+evrcmp 1.0.1 1.0.1
+evrcmp 1.a 1.a
+evrcmp 1.0~rc1 1.0~rc1
+evrcmp 1.0^git1 1.0^git1
+evrcmp 1.0-2 1.0-2
+evrcmp 1:0.5 1:0.5
+evrcmp 2.0_beta 2.0_beta
+evrcmp abcdefghi abcdefghi
+evrcmp 1.0..1 1.0..1
+
+evrcmp 1:1.0 1:1.0-5 compare
+evrcmp 1:1.0 1:1.0-5 matchrelease
+evrcmp 1:1.0 1:1.0-5 match
+evrcmp 1:1.0 1:1.0-5 compareevonly
+evrcmp 1.0-5 1.0 compare
+evrcmp 1.0-5 1.0 matchrelease
+evrcmp 1.0-5 1.0 match
+evrcmp 1.0-5 1.0 compareevonly
+evrcmp 1.0 1.0-5 compare
+evrcmp 1.0 1.0-5 matchrelease
+evrcmp 1.0 1.0-5 match
+evrcmp 1.0 1.0-5 compareevonly
+evrcmp 1:1.0-1 1.0-1 compare
+evrcmp 1:1.0-1 1.0-1 matchrelease
+evrcmp 1:1.0-1 1.0-1 match
+evrcmp 1:1.0-1 1.0-1 compareevonly
+evrcmp 0:1.0-1 1.0-1 compare
+evrcmp 0:1.0-1 1.0-1 matchrelease
+evrcmp 0:1.0-1 1.0-1 match
+evrcmp 0:1.0-1 1.0-1 compareevonly
+evrcmp 1.0~rc1-1 1.0~rc1-2 compare
+evrcmp 1.0~rc1-1 1.0~rc1-2 matchrelease
+evrcmp 1.0~rc1-1 1.0~rc1-2 match
+evrcmp 1.0~rc1-1 1.0~rc1-2 compareevonly
+evrcmp 2.0-1 2.0-1.fc30 compare
+evrcmp 2.0-1 2.0-1.fc30 matchrelease
+evrcmp 2.0-1 2.0-1.fc30 match
+evrcmp 2.0-1 2.0-1.fc30 compareevonly
+evrcmp 1.0^1-3 1.0^1 compare
+evrcmp 1.0^1-3 1.0^1 matchrelease
+evrcmp 1.0^1-3 1.0^1 match
+evrcmp 1.0^1-3 1.0^1 compareevonly
+result jobs <inline>
+#>job noop provides 0 < 1
+#>job noop provides 0 = 0
+#>job noop provides 0:1.0 < 1:0.5
+#>job noop provides 0:1.0 < 1:1.0-1
+#>job noop provides 0:1.0-1 = 1.0-1
+#>job noop provides 0:1.0-1 = 1.0-1
+#>job noop provides 0:1.0-1 = 1.0-1
+#>job noop provides 0:1.0-1 = 1.0-1
+#>job noop provides 1 < 1.0
+#>job noop provides 1 > 0
+#>job noop provides 1.0 < 1.0-5
+#>job noop provides 1.0 < 1.0-5
+#>job noop provides 1.0 < 1.0.1
+#>job noop provides 1.0 = 1.0-5
+#>job noop provides 1.0 = 1.0-5
+#>job noop provides 1.0 > 1
+#>job noop provides 1.0-1 < 1.0-2
+#>job noop provides 1.0-1 < 1.0^git1~pre
+#>job noop provides 1.0-1.el8 < 1.0-10
+#>job noop provides 1.0-1.el8 < 1:0.5
+#>job noop provides 1.0-10 > 1.0-1.el8
+#>job noop provides 1.0-10 > 1.0-2
+#>job noop provides 1.0-2 < 1.0-10
+#>job noop provides 1.0-2 = 1.0-2
+#>job noop provides 1.0-2 > 1.0-1
+#>job noop provides 1.0-5 = 1.0
+#>job noop provides 1.0-5 = 1.0
+#>job noop provides 1.0-5 > 1.0
+#>job noop provides 1.0-5 > 1.0
+#>job noop provides 1.0..1 < 123456789
+#>job noop provides 1.0..1 = 1.0..1
+#>job noop provides 1.0..1 > v1
+#>job noop provides 1.0.1 < 1.01
+#>job noop provides 1.0.1 = 1.0.1
+#>job noop provides 1.0.1 > 1.0
+#>job noop provides 1.00010 > 1.01
+#>job noop provides 1.00010 > 1.a
+#>job noop provides 1.01 < 1.00010
+#>job noop provides 1.01 > 1.0.1
+#>job noop provides 1.0^ < 1.0^git1
+#>job noop provides 1.0^ > 1.0~rc1~git1
+#>job noop provides 1.0^1-3 = 1.0^1
+#>job noop provides 1.0^1-3 = 1.0^1
+#>job noop provides 1.0^1-3 > 1.0^1
+#>job noop provides 1.0^1-3 > 1.0^1
+#>job noop provides 1.0^git1 = 1.0^git1
+#>job noop provides 1.0^git1 > 1.0^
+#>job noop provides 1.0^git1 > 1.0^git1~pre
+#>job noop provides 1.0^git1~pre < 1.0^git1
+#>job noop provides 1.0^git1~pre > 1.0-1
+#>job noop provides 1.0a > 1.0~rc1
+#>job noop provides 1.0a > 1.A
+#>job noop provides 1.0a1 > v1
+#>job noop provides 1.0~rc1 < 1.0a
+#>job noop provides 1.0~rc1 = 1.0~rc1
+#>job noop provides 1.0~rc1 > 1.0~rc1~git1
+#>job noop provides 1.0~rc1-1 < 1.0~rc1-2
+#>job noop provides 1.0~rc1-1 < 1.0~rc1-2
+#>job noop provides 1.0~rc1-1 < 1.0~rc1-2
+#>job noop provides 1.0~rc1-1 = 1.0~rc1-2
+#>job noop provides 1.0~rc1~git1 < 1.0^
+#>job noop provides 1.0~rc1~git1 < 1.0~rc1
+#>job noop provides 1.A < 1.0a
+#>job noop provides 1.A < 1.a
+#>job noop provides 1.a < 1.00010
+#>job noop provides 1.a = 1.a
+#>job noop provides 1.a > 1.A
+#>job noop provides 123456789 > 1.0..1
+#>job noop provides 123456789 > 20160101
+#>job noop provides 1:0.5 = 1:0.5
+#>job noop provides 1:0.5 > 0:1.0
+#>job noop provides 1:0.5 > 1.0-1.el8
+#>job noop provides 1:1.0 < 1:1.0-5
+#>job noop provides 1:1.0 < 1:1.0-5
+#>job noop provides 1:1.0 = 1:1.0-5
+#>job noop provides 1:1.0 = 1:1.0-5
+#>job noop provides 1:1.0-1 > 0:1.0
+#>job noop provides 1:1.0-1 > 1.0-1
+#>job noop provides 1:1.0-1 > 1.0-1
+#>job noop provides 1:1.0-1 > 1.0-1
+#>job noop provides 1:1.0-1 > 1.0-1
+#>job noop provides 1:1.0-1 > 2.0_beta
+#>job noop provides 2.0+b1 < 2.0_beta
+#>job noop provides 2.0+b1 > abcdefgh
+#>job noop provides 2.0-1 < 2.0-1.fc30
+#>job noop provides 2.0-1 < 2.0-1.fc30
+#>job noop provides 2.0-1 < 2.0-1.fc30
+#>job noop provides 2.0-1 = 2.0-1.fc30
+#>job noop provides 2.0_beta < 1:1.0-1
+#>job noop provides 2.0_beta = 2.0_beta
+#>job noop provides 2.0_beta > 2.0+b1
+#>job noop provides 20160101 < 123456789
+#>job noop provides 20160101 > abcdefghi
+#>job noop provides abcdefgh < 2.0+b1
+#>job noop provides abcdefgh < abcdefghi
+#>job noop provides abcdefghi < 20160101
+#>job noop provides abcdefghi = abcdefghi
+#>job noop provides abcdefghi > abcdefgh
+#>job noop provides v1 < 1.0..1
+#>job noop provides v1 < 1.0a1
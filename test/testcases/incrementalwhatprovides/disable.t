@@ -0,0 +1,22 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Pkg: C 1 1 noarch
+#>=Prv: feature = 1
+repo extra 0 testtags <inline>
+#>=Pkg: A 3 1 noarch
+#>=Pkg: C 2 1 noarch
+#>=Prv: feature = 2
+#>=Pkg: D 1 1 noarch
+#>=Prv: feature = 3
+system i686 rpm system
+poolflags incrementalwhatprovides
+
+disablerepo extra
+job update name A
+job install provides feature > 1
+result transaction,problems <inline>
+#>problem c43b1300 info nothing provides requested feature > 1
+#>problem c43b1300 solution 54740f88 deljob install provides feature > 1
+#>upgrade A-1-1.noarch@system A-2-1.noarch@available
@@ -0,0 +1,31 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Pkg: B 1 1 noarch
+#>=Req: /usr/bin/d
+#>=Pkg: C 1 1 noarch
+#>=Prv: feature = 1
+repo extra 0 testtags <inline>
+#>=Pkg: A 3 1 noarch
+#>=Pkg: C 2 1 noarch
+#>=Prv: feature = 2
+#>=Pkg: D 1 1 noarch
+#>=Fls: /usr/bin/d
+system i686 rpm system
+poolflags incrementalwhatprovides
+
+disablerepo extra
+disablerepo available
+enablerepo extra
+enablerepo available
+disablerepo system
+enablerepo system
+job update name A
+job install name B
+job install provides feature > 1
+result transaction,problems <inline>
+#>install B-1-1.noarch@available
+#>install C-2-1.noarch@extra
+#>install D-1-1.noarch@extra
+#>upgrade A-1-1.noarch@system A-3-1.noarch@extra
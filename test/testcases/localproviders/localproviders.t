@@ -0,0 +1,34 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+#>=Req: feature >= 1
+#>=Pkg: C 1 1 noarch
+#>=Prv: feature = 1
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Req: feature >= 2
+#>=Pkg: C 2 1 noarch
+#>=Prv: feature = 2
+#>=Pkg: D 1 1 noarch
+#>=Prv: feature = 3
+#>=Req: feature < 4
+system i686 rpm system
+
+solverflags localproviders
+job update name A
+job install provides feature > 2
+result transaction,problems <inline>
+#>install D-1-1.noarch@available
+#>upgrade A-1-1.noarch@system A-2-1.noarch@available
+nextjob
+
+solverflags localproviders promoteproviders
+job install provides feature > 2
+job update name A
+result transaction,problems <inline>
+#>install D-1-1.noarch@available
+#>upgrade A-1-1.noarch@system A-2-1.noarch@available
+nextjob
+
+job install provides feature > 2
+result transaction,problems <inline>
+#>install D-1-1.noarch@available
@@ -0,0 +1,84 @@
+#
+# learnt rules that only depend on pkg rules are kept when the
+# solver is reused. The second job does not need to learn -B again,
+# the third job reports a problem with the kept rule in the proof.
+#
+repo system 0 testtags <inline>
+repo available 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+#>=Req: X
+#>=Pkg: F 1 1 noarch
+#>=Req: X
+#>=Pkg: B 1 1 noarch
+#>=Prv: X
+#>=Req: D
+#>=Req: E
+#>=Pkg: C 1 1 noarch
+#>=Prv: X
+#>=Pkg: D 1 1 noarch
+#>=Con: E
+#>=Pkg: E 1 1 noarch
+system unset * system
+solverflags keeplearnt
+job install name A
+result transaction,problems,rules <inline>
+#>install A-1-1.noarch@available
+#>install C-1-1.noarch@available
+#>rule job 78018aa4620f94175ee7c64e70577e37  A-1-1.noarch@available
+#>rule learnt ce4e461b385812140905add61a38ecb9 -B-1-1.noarch@available
+#>rule pkg 6eff8b2308d3df8417228b69a65e3e5a  D-1-1.noarch@available
+#>rule pkg 6eff8b2308d3df8417228b69a65e3e5a -B-1-1.noarch@available
+#>rule pkg a66f27e54ea85ce849658d820a6350f5  B-1-1.noarch@available
+#>rule pkg a66f27e54ea85ce849658d820a6350f5  C-1-1.noarch@available
+#>rule pkg a66f27e54ea85ce849658d820a6350f5 -A-1-1.noarch@available
+#>rule pkg aaa3373648a9456d280550d2789749bd -D-1-1.noarch@available
+#>rule pkg aaa3373648a9456d280550d2789749bd -E-1-1.noarch@available
+#>rule pkg e5a2de42ec3abaa8bd3f6a6db1d57a48  E-1-1.noarch@available
+#>rule pkg e5a2de42ec3abaa8bd3f6a6db1d57a48 -B-1-1.noarch@available
+nextjob reusesolver
+job install name F
+result transaction,problems,rules,proof <inline>
+#>install C-1-1.noarch@available
+#>install F-1-1.noarch@available
+#>rule job 32e5dc0f522443810f50c2352257a060  F-1-1.noarch@available
+#>rule learnt ce4e461b385812140905add61a38ecb9 -B-1-1.noarch@available
+#>rule pkg 005397c18e4fba06600438a865208037  B-1-1.noarch@available
+#>rule pkg 005397c18e4fba06600438a865208037  C-1-1.noarch@available
+#>rule pkg 005397c18e4fba06600438a865208037 -F-1-1.noarch@available
+#>rule pkg 6eff8b2308d3df8417228b69a65e3e5a  D-1-1.noarch@available
+#>rule pkg 6eff8b2308d3df8417228b69a65e3e5a -B-1-1.noarch@available
+#>rule pkg a66f27e54ea85ce849658d820a6350f5  B-1-1.noarch@available
+#>rule pkg a66f27e54ea85ce849658d820a6350f5  C-1-1.noarch@available
+#>rule pkg a66f27e54ea85ce849658d820a6350f5 -A-1-1.noarch@available
+#>rule pkg aaa3373648a9456d280550d2789749bd -D-1-1.noarch@available
+#>rule pkg aaa3373648a9456d280550d2789749bd -E-1-1.noarch@available
+#>rule pkg e5a2de42ec3abaa8bd3f6a6db1d57a48  E-1-1.noarch@available
+#>rule pkg e5a2de42ec3abaa8bd3f6a6db1d57a48 -B-1-1.noarch@available
+nextjob reusesolver
+job install name F
+job erase name C
+result transaction,problems,proof <inline>
+#>problem b83eeb57 info package F-1-1.noarch requires X, but none of the providers can be installed
+#>problem b83eeb57 solution 60bfbdf1 deljob install name F
+#>problem b83eeb57 solution c0288f04 deljob erase name C
+#>proof b83eeb57   0 job 32e5dc0f522443810f50c2352257a060
+#>proof b83eeb57   0: -->  F-1-1.noarch@available
+#>proof b83eeb57   1 job c46d4780588300dd61868cbdfc7fa7ac
+#>proof b83eeb57   1: --> -C-1-1.noarch@available
+#>proof b83eeb57   2 learnt ce4e461b385812140905add61a38ecb9
+#>proof b83eeb57   2: --> -B-1-1.noarch@available
+#>proof b83eeb57   3 pkg 005397c18e4fba06600438a865208037
+#>proof b83eeb57   3:      B-1-1.noarch@available
+#>proof b83eeb57   3:      C-1-1.noarch@available
+#>proof b83eeb57   3:     -F-1-1.noarch@available
+#>proof ce4e461b385812140905add61a38ecb9   0 premise
+#>proof ce4e461b385812140905add61a38ecb9   0: -->  B-1-1.noarch@available
+#>proof ce4e461b385812140905add61a38ecb9   1 pkg 6eff8b2308d3df8417228b69a65e3e5a
+#>proof ce4e461b385812140905add61a38ecb9   1:     -B-1-1.noarch@available
+#>proof ce4e461b385812140905add61a38ecb9   1: -->  D-1-1.noarch@available
+#>proof ce4e461b385812140905add61a38ecb9   2 pkg e5a2de42ec3abaa8bd3f6a6db1d57a48
+#>proof ce4e461b385812140905add61a38ecb9   2:     -B-1-1.noarch@available
+#>proof ce4e461b385812140905add61a38ecb9   2: -->  E-1-1.noarch@available
+#>proof ce4e461b385812140905add61a38ecb9   3 pkg aaa3373648a9456d280550d2789749bd
+#>proof ce4e461b385812140905add61a38ecb9   3:     -D-1-1.noarch@available
+#>proof ce4e461b385812140905add61a38ecb9   3:     -E-1-1.noarch@available
@@ -0,0 +1,527 @@
+#
+# a pigeonhole problem that learns enough rules to reduce them with a small
+# interval, the proof of the problem must not refer to deleted rules
+#
+repo available 0 testtags <inline>
+#>=Pkg: P1 1 1 noarch
+#>=Req: seat1
+#>=Pkg: S1_1 1 1 noarch
+#>=Prv: seat1
+#>=Prv: hole1
+#>=Con: hole1
+#>=Pkg: S1_2 1 1 noarch
+#>=Prv: seat1
+#>=Prv: hole2
+#>=Con: hole2
+#>=Pkg: S1_3 1 1 noarch
+#>=Prv: seat1
+#>=Prv: hole3
+#>=Con: hole3
+#>=Pkg: S1_5 1 1 noarch
+#>=Prv: seat1
+#>=Prv: hole5
+#>=Con: hole5
+#>=Pkg: P2 1 1 noarch
+#>=Req: seat2
+#>=Pkg: S2_1 1 1 noarch
+#>=Prv: seat2
+#>=Prv: hole1
+#>=Con: hole1
+#>=Pkg: S2_3 1 1 noarch
+#>=Prv: seat2
+#>=Prv: hole3
+#>=Con: hole3
+#>=Pkg: S2_4 1 1 noarch
+#>=Prv: seat2
+#>=Prv: hole4
+#>=Con: hole4
+#>=Pkg: P3 1 1 noarch
+#>=Req: seat3
+#>=Pkg: S3_1 1 1 noarch
+#>=Prv: seat3
+#>=Prv: hole1
+#>=Con: hole1
+#>=Pkg: S3_3 1 1 noarch
+#>=Prv: seat3
+#>=Prv: hole3
+#>=Con: hole3
+#>=Pkg: P4 1 1 noarch
+#>=Req: seat4
+#>=Pkg: S4_1 1 1 noarch
+#>=Prv: seat4
+#>=Prv: hole1
+#>=Con: hole1
+#>=Pkg: S4_3 1 1 noarch
+#>=Prv: seat4
+#>=Prv: hole3
+#>=Con: hole3
+#>=Pkg: S4_5 1 1 noarch
+#>=Prv: seat4
+#>=Prv: hole5
+#>=Con: hole5
+#>=Pkg: P5 1 1 noarch
+#>=Req: seat5
+#>=Pkg: S5_2 1 1 noarch
+#>=Prv: seat5
+#>=Prv: hole2
+#>=Con: hole2
+#>=Pkg: S5_3 1 1 noarch
+#>=Prv: seat5
+#>=Prv: hole3
+#>=Con: hole3
+#>=Pkg: P6 1 1 noarch
+#>=Req: seat6
+#>=Pkg: S6_1 1 1 noarch
+#>=Prv: seat6
+#>=Prv: hole1
+#>=Con: hole1
+#>=Pkg: S6_2 1 1 noarch
+#>=Prv: seat6
+#>=Prv: hole2
+#>=Con: hole2
+#>=Pkg: S6_3 1 1 noarch
+#>=Prv: seat6
+#>=Prv: hole3
+#>=Con: hole3
+#>=Pkg: S6_4 1 1 noarch
+#>=Prv: seat6
+#>=Prv: hole4
+#>=Con: hole4
+#>=Pkg: S6_5 1 1 noarch
+#>=Prv: seat6
+#>=Prv: hole5
+#>=Con: hole5
+system i686 rpm
+
+solverflags reducelearnt=2
+job install name P1
+job install name P2
+job install name P3
+job install name P4
+job install name P5
+job install name P6
+result transaction,problems,stats,proof <inline>
+#>problem 04112dbe info package P6-1-1.noarch requires seat6, but none of the providers can be installed
+#>problem 04112dbe solution 05aadf97 deljob install name P6
+#>problem 04112dbe solution 1465c3a5 deljob install name P3
+#>problem 04112dbe solution 4e6a49af deljob install name P1
+#>problem 04112dbe solution 683e0afa deljob install name P5
+#>problem 04112dbe solution 9e363307 deljob install name P2
+#>problem 04112dbe solution f03c01bd deljob install name P4
+#>proof 04112dbe   0 job 9f748d291901559854082de9fc17e241
+#>proof 04112dbe   0: -->  P1-1-1.noarch@available
+#>proof 04112dbe   1 job 9d08f6126d202dc1f5bc26094545c28c
+#>proof 04112dbe   1: -->  P2-1-1.noarch@available
+#>proof 04112dbe   2 job 907a289a940beaf6ca7842ab940cfaa6
+#>proof 04112dbe   2: -->  P3-1-1.noarch@available
+#>proof 04112dbe   3 job da32e0142773b3bfea51699610370195
+#>proof 04112dbe   3: -->  P4-1-1.noarch@available
+#>proof 04112dbe   4 job 150604f06457ac5a72635d4a9fc97dde
+#>proof 04112dbe   4: -->  P5-1-1.noarch@available
+#>proof 04112dbe   5 job 300768553afe091f7124f4e45ce8d9bb
+#>proof 04112dbe   5: -->  P6-1-1.noarch@available
+#>proof 04112dbe   6 learnt e406250c76867e458c9e9c93f6818d01
+#>proof 04112dbe   6: --> -S6_1-1-1.noarch@available
+#>proof 04112dbe   7 learnt 1ca51ee4986381e4abc5e19c1d4a143b
+#>proof 04112dbe   7: --> -S5_2-1-1.noarch@available
+#>proof 04112dbe   8 pkg a1662713d268503250734e0cfb73deb4
+#>proof 04112dbe   8:      S5_2-1-1.noarch@available
+#>proof 04112dbe   8:     -P5-1-1.noarch@available
+#>proof 04112dbe   8: -->  S5_3-1-1.noarch@available
+#>proof 04112dbe   9 pkg 37367c37747de77c1a467c634269ec96
+#>proof 04112dbe   9:     -S5_3-1-1.noarch@available
+#>proof 04112dbe   9: --> -S6_3-1-1.noarch@available
+#>proof 04112dbe  10 pkg 65223dae10e67efd3d2a41ec256d1974
+#>proof 04112dbe  10:     -S5_3-1-1.noarch@available
+#>proof 04112dbe  10: --> -S4_3-1-1.noarch@available
+#>proof 04112dbe  11 pkg 1ebaa14ffaf48ac7583d4763a496e56b
+#>proof 04112dbe  11:     -S5_3-1-1.noarch@available
+#>proof 04112dbe  11: --> -S3_3-1-1.noarch@available
+#>proof 04112dbe  12 pkg 214f38538aadc2f37246de431d28b5eb
+#>proof 04112dbe  12:     -S5_3-1-1.noarch@available
+#>proof 04112dbe  12: --> -S2_3-1-1.noarch@available
+#>proof 04112dbe  13 pkg a3917d41ffd78c68c2975a2d2cb298cb
+#>proof 04112dbe  13:     -S5_3-1-1.noarch@available
+#>proof 04112dbe  13: --> -S1_3-1-1.noarch@available
+#>proof 04112dbe  14 pkg c214b917646a3696f0cf9f449317560d
+#>proof 04112dbe  14:      S3_3-1-1.noarch@available
+#>proof 04112dbe  14:     -P3-1-1.noarch@available
+#>proof 04112dbe  14: -->  S3_1-1-1.noarch@available
+#>proof 04112dbe  15 pkg 23f978c3be2b38d30444fbda6079e162
+#>proof 04112dbe  15:     -S3_1-1-1.noarch@available
+#>proof 04112dbe  15: --> -S4_1-1-1.noarch@available
+#>proof 04112dbe  16 pkg 1a6cd801a24c2370503469b53ee5e3d6
+#>proof 04112dbe  16:     -S3_1-1-1.noarch@available
+#>proof 04112dbe  16: --> -S2_1-1-1.noarch@available
+#>proof 04112dbe  17 pkg c7000bba8966200cad460479e33cc9c7
+#>proof 04112dbe  17:     -S3_1-1-1.noarch@available
+#>proof 04112dbe  17: --> -S1_1-1-1.noarch@available
+#>proof 04112dbe  18 pkg 397dd963cdda285b84761646b33445de
+#>proof 04112dbe  18:      S4_1-1-1.noarch@available
+#>proof 04112dbe  18:      S4_3-1-1.noarch@available
+#>proof 04112dbe  18:     -P4-1-1.noarch@available
+#>proof 04112dbe  18: -->  S4_5-1-1.noarch@available
+#>proof 04112dbe  19 pkg 19cf09de4c0ea94c81010152d17b6c9e
+#>proof 04112dbe  19:      S2_1-1-1.noarch@available
+#>proof 04112dbe  19:      S2_3-1-1.noarch@available
+#>proof 04112dbe  19:     -P2-1-1.noarch@available
+#>proof 04112dbe  19: -->  S2_4-1-1.noarch@available
+#>proof 04112dbe  20 pkg 61eab9dab3c1dd0ea743fa5d49b32bee
+#>proof 04112dbe  20:     -S4_5-1-1.noarch@available
+#>proof 04112dbe  20: --> -S6_5-1-1.noarch@available
+#>proof 04112dbe  21 pkg cd018737f6458a197bd297027b6a2df6
+#>proof 04112dbe  21:     -S4_5-1-1.noarch@available
+#>proof 04112dbe  21: --> -S1_5-1-1.noarch@available
+#>proof 04112dbe  22 pkg fc7128107ba16a6e1f0bee2437496cb0
+#>proof 04112dbe  22:     -S2_4-1-1.noarch@available
+#>proof 04112dbe  22: --> -S6_4-1-1.noarch@available
+#>proof 04112dbe  23 pkg e0aacedf5580151de254ebc8e9a4a6be
+#>proof 04112dbe  23:      S1_1-1-1.noarch@available
+#>proof 04112dbe  23:      S1_3-1-1.noarch@available
+#>proof 04112dbe  23:      S1_5-1-1.noarch@available
+#>proof 04112dbe  23:     -P1-1-1.noarch@available
+#>proof 04112dbe  23: -->  S1_2-1-1.noarch@available
+#>proof 04112dbe  24 pkg 62fb118c548506369132cc397c15164b
+#>proof 04112dbe  24:      S6_1-1-1.noarch@available
+#>proof 04112dbe  24:      S6_3-1-1.noarch@available
+#>proof 04112dbe  24:      S6_4-1-1.noarch@available
+#>proof 04112dbe  24:      S6_5-1-1.noarch@available
+#>proof 04112dbe  24:     -P6-1-1.noarch@available
+#>proof 04112dbe  24: -->  S6_2-1-1.noarch@available
+#>proof 04112dbe  25 pkg 5954fa134cd4d5eef3916f1acf94e793
+#>proof 04112dbe  25:     -S1_2-1-1.noarch@available
+#>proof 04112dbe  25:     -S6_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   0 premise
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   0: -->  S5_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   1 job 9f748d291901559854082de9fc17e241
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   1: -->  P1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   2 job 9d08f6126d202dc1f5bc26094545c28c
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   2: -->  P2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   3 job 907a289a940beaf6ca7842ab940cfaa6
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   3: -->  P3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   4 job da32e0142773b3bfea51699610370195
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   4: -->  P4-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   5 job 300768553afe091f7124f4e45ce8d9bb
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   5: -->  P6-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   6 learnt e406250c76867e458c9e9c93f6818d01
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   6: --> -S6_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   7 pkg 8935e5728ef785d4fbfdb0e5fc43cbbf
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   7:     -S5_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   7: --> -S6_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   8 pkg afc364486548827b56766c358cdac6cd
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   8:     -S5_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   8: --> -S1_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   9 learnt 9aac05f315ed9249c94909c845f0479a
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   9:      S1_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   9:      S6_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b   9: --> -S4_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  10 learnt e697355e5b07599e1729a710278a79cd
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  10:      S1_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  10:      S4_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  10:      S6_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  10: --> -S3_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  11 pkg c214b917646a3696f0cf9f449317560d
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  11:      S3_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  11:     -P3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  11: -->  S3_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  12 pkg 036a28413d27f76cadb124da381bdd6d
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  12:     -S3_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  12: --> -S6_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  13 pkg aeab1f7d50f5858f5c24f4ead9c1e933
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  13:     -S3_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  13: --> -S4_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  14 pkg 982b600189cd40fb9a47f91f1d304ced
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  14:     -S3_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  14: --> -S2_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  15 pkg b26656f135526885af650916b1f952e8
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  15:     -S3_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  15: --> -S1_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  16 pkg 397dd963cdda285b84761646b33445de
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  16:      S4_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  16:      S4_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  16:     -P4-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  16: -->  S4_5-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  17 pkg 61eab9dab3c1dd0ea743fa5d49b32bee
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  17:     -S4_5-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  17: --> -S6_5-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  18 pkg cd018737f6458a197bd297027b6a2df6
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  18:     -S4_5-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  18: --> -S1_5-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  19 pkg 62fb118c548506369132cc397c15164b
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  19:      S6_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  19:      S6_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  19:      S6_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  19:      S6_5-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  19:     -P6-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  19: -->  S6_4-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  20 pkg e0aacedf5580151de254ebc8e9a4a6be
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  20:      S1_2-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  20:      S1_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  20:      S1_5-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  20:     -P1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  20: -->  S1_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  21 pkg fc7128107ba16a6e1f0bee2437496cb0
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  21:     -S6_4-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  21: --> -S2_4-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  22 pkg faf5de0e463d3f70ed049b22c1a3336b
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  22:     -S1_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  22: --> -S2_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  23 pkg 19cf09de4c0ea94c81010152d17b6c9e
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  23:      S2_1-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  23:      S2_3-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  23:      S2_4-1-1.noarch@available
+#>proof 1ca51ee4986381e4abc5e19c1d4a143b  23:     -P2-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   0 premise
+#>proof 5b1564812f7a7191269226c07d133543   0: -->  S2_3-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   1 premise
+#>proof 5b1564812f7a7191269226c07d133543   1: --> -S1_1-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   2 premise
+#>proof 5b1564812f7a7191269226c07d133543   2: --> -S1_2-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   3 premise
+#>proof 5b1564812f7a7191269226c07d133543   3: --> -S4_1-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   4 job 9f748d291901559854082de9fc17e241
+#>proof 5b1564812f7a7191269226c07d133543   4: -->  P1-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   5 job da32e0142773b3bfea51699610370195
+#>proof 5b1564812f7a7191269226c07d133543   5: -->  P4-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   6 pkg f36b650738eabaf929a9ab46a2e6191d
+#>proof 5b1564812f7a7191269226c07d133543   6:     -S2_3-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   6: --> -S4_3-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   7 pkg 117108238a99addfc0f32518eba6df7a
+#>proof 5b1564812f7a7191269226c07d133543   7:     -S2_3-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   7: --> -S1_3-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   8 pkg 397dd963cdda285b84761646b33445de
+#>proof 5b1564812f7a7191269226c07d133543   8:      S4_1-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   8:      S4_3-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   8:     -P4-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   8: -->  S4_5-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   9 pkg e0aacedf5580151de254ebc8e9a4a6be
+#>proof 5b1564812f7a7191269226c07d133543   9:      S1_1-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   9:      S1_2-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   9:      S1_3-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   9:     -P1-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543   9: -->  S1_5-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543  10 pkg cd018737f6458a197bd297027b6a2df6
+#>proof 5b1564812f7a7191269226c07d133543  10:     -S1_5-1-1.noarch@available
+#>proof 5b1564812f7a7191269226c07d133543  10:     -S4_5-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   0 premise
+#>proof 9aac05f315ed9249c94909c845f0479a   0: -->  S4_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   1 premise
+#>proof 9aac05f315ed9249c94909c845f0479a   1: --> -S6_2-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   2 premise
+#>proof 9aac05f315ed9249c94909c845f0479a   2: --> -S1_2-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   3 job 9f748d291901559854082de9fc17e241
+#>proof 9aac05f315ed9249c94909c845f0479a   3: -->  P1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   4 job 9d08f6126d202dc1f5bc26094545c28c
+#>proof 9aac05f315ed9249c94909c845f0479a   4: -->  P2-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   5 job 907a289a940beaf6ca7842ab940cfaa6
+#>proof 9aac05f315ed9249c94909c845f0479a   5: -->  P3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   6 job 300768553afe091f7124f4e45ce8d9bb
+#>proof 9aac05f315ed9249c94909c845f0479a   6: -->  P6-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   7 learnt e406250c76867e458c9e9c93f6818d01
+#>proof 9aac05f315ed9249c94909c845f0479a   7: --> -S6_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   8 pkg 23f978c3be2b38d30444fbda6079e162
+#>proof 9aac05f315ed9249c94909c845f0479a   8:     -S4_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   8: --> -S3_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   9 pkg 306d3d4405c0fa4ffcefb6881b75b974
+#>proof 9aac05f315ed9249c94909c845f0479a   9:     -S4_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a   9: --> -S2_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  10 pkg c54200e34a180f52e23883d4b06d60dd
+#>proof 9aac05f315ed9249c94909c845f0479a  10:     -S4_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  10: --> -S1_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  11 pkg c214b917646a3696f0cf9f449317560d
+#>proof 9aac05f315ed9249c94909c845f0479a  11:      S3_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  11:     -P3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  11: -->  S3_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  12 pkg 036a28413d27f76cadb124da381bdd6d
+#>proof 9aac05f315ed9249c94909c845f0479a  12:     -S3_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  12: --> -S6_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  13 pkg 982b600189cd40fb9a47f91f1d304ced
+#>proof 9aac05f315ed9249c94909c845f0479a  13:     -S3_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  13: --> -S2_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  14 pkg b26656f135526885af650916b1f952e8
+#>proof 9aac05f315ed9249c94909c845f0479a  14:     -S3_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  14: --> -S1_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  15 pkg 19cf09de4c0ea94c81010152d17b6c9e
+#>proof 9aac05f315ed9249c94909c845f0479a  15:      S2_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  15:      S2_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  15:     -P2-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  15: -->  S2_4-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  16 pkg e0aacedf5580151de254ebc8e9a4a6be
+#>proof 9aac05f315ed9249c94909c845f0479a  16:      S1_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  16:      S1_2-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  16:      S1_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  16:     -P1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  16: -->  S1_5-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  17 pkg fc7128107ba16a6e1f0bee2437496cb0
+#>proof 9aac05f315ed9249c94909c845f0479a  17:     -S2_4-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  17: --> -S6_4-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  18 pkg 48989d400f5ce6c79c7b43715d048866
+#>proof 9aac05f315ed9249c94909c845f0479a  18:     -S1_5-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  18: --> -S6_5-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  19 pkg 62fb118c548506369132cc397c15164b
+#>proof 9aac05f315ed9249c94909c845f0479a  19:      S6_1-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  19:      S6_2-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  19:      S6_3-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  19:      S6_4-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  19:      S6_5-1-1.noarch@available
+#>proof 9aac05f315ed9249c94909c845f0479a  19:     -P6-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   0 premise
+#>proof e406250c76867e458c9e9c93f6818d01   0: -->  S6_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   1 job 9f748d291901559854082de9fc17e241
+#>proof e406250c76867e458c9e9c93f6818d01   1: -->  P1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   2 job 907a289a940beaf6ca7842ab940cfaa6
+#>proof e406250c76867e458c9e9c93f6818d01   2: -->  P3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   3 job da32e0142773b3bfea51699610370195
+#>proof e406250c76867e458c9e9c93f6818d01   3: -->  P4-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   4 job 150604f06457ac5a72635d4a9fc97dde
+#>proof e406250c76867e458c9e9c93f6818d01   4: -->  P5-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   5 pkg 60bc9f1c107636e2c291c01a0dd382d2
+#>proof e406250c76867e458c9e9c93f6818d01   5:     -S6_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   5: --> -S4_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   6 pkg 2c6699efec71496f43d8b116562434f3
+#>proof e406250c76867e458c9e9c93f6818d01   6:     -S6_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   6: --> -S3_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   7 pkg c1f0739eb888239edd264f2d61440037
+#>proof e406250c76867e458c9e9c93f6818d01   7:     -S6_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   7: --> -S1_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   8 pkg c214b917646a3696f0cf9f449317560d
+#>proof e406250c76867e458c9e9c93f6818d01   8:      S3_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   8:     -P3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   8: -->  S3_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   9 pkg 1ebaa14ffaf48ac7583d4763a496e56b
+#>proof e406250c76867e458c9e9c93f6818d01   9:     -S3_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01   9: --> -S5_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  10 pkg aeab1f7d50f5858f5c24f4ead9c1e933
+#>proof e406250c76867e458c9e9c93f6818d01  10:     -S3_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  10: --> -S4_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  11 pkg b26656f135526885af650916b1f952e8
+#>proof e406250c76867e458c9e9c93f6818d01  11:     -S3_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  11: --> -S1_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  12 pkg a1662713d268503250734e0cfb73deb4
+#>proof e406250c76867e458c9e9c93f6818d01  12:      S5_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  12:     -P5-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  12: -->  S5_2-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  13 pkg 397dd963cdda285b84761646b33445de
+#>proof e406250c76867e458c9e9c93f6818d01  13:      S4_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  13:      S4_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  13:     -P4-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  13: -->  S4_5-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  14 pkg afc364486548827b56766c358cdac6cd
+#>proof e406250c76867e458c9e9c93f6818d01  14:     -S5_2-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  14: --> -S1_2-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  15 pkg cd018737f6458a197bd297027b6a2df6
+#>proof e406250c76867e458c9e9c93f6818d01  15:     -S4_5-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  15: --> -S1_5-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  16 pkg e0aacedf5580151de254ebc8e9a4a6be
+#>proof e406250c76867e458c9e9c93f6818d01  16:      S1_1-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  16:      S1_2-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  16:      S1_3-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  16:      S1_5-1-1.noarch@available
+#>proof e406250c76867e458c9e9c93f6818d01  16:     -P1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   0 premise
+#>proof e697355e5b07599e1729a710278a79cd   0: -->  S3_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   1 premise
+#>proof e697355e5b07599e1729a710278a79cd   1: --> -S4_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   2 premise
+#>proof e697355e5b07599e1729a710278a79cd   2: --> -S6_2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   3 premise
+#>proof e697355e5b07599e1729a710278a79cd   3: --> -S1_2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   4 job 9f748d291901559854082de9fc17e241
+#>proof e697355e5b07599e1729a710278a79cd   4: -->  P1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   5 job 9d08f6126d202dc1f5bc26094545c28c
+#>proof e697355e5b07599e1729a710278a79cd   5: -->  P2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   6 job da32e0142773b3bfea51699610370195
+#>proof e697355e5b07599e1729a710278a79cd   6: -->  P4-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   7 job 300768553afe091f7124f4e45ce8d9bb
+#>proof e697355e5b07599e1729a710278a79cd   7: -->  P6-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   8 learnt e406250c76867e458c9e9c93f6818d01
+#>proof e697355e5b07599e1729a710278a79cd   8: --> -S6_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   9 pkg 1a6cd801a24c2370503469b53ee5e3d6
+#>proof e697355e5b07599e1729a710278a79cd   9:     -S3_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd   9: --> -S2_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  10 pkg c7000bba8966200cad460479e33cc9c7
+#>proof e697355e5b07599e1729a710278a79cd  10:     -S3_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  10: --> -S1_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  11 learnt 5b1564812f7a7191269226c07d133543
+#>proof e697355e5b07599e1729a710278a79cd  11:      S1_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  11:      S1_2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  11:      S4_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  11: --> -S2_3-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  12 pkg 19cf09de4c0ea94c81010152d17b6c9e
+#>proof e697355e5b07599e1729a710278a79cd  12:      S2_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  12:      S2_3-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  12:     -P2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  12: -->  S2_4-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  13 pkg fc7128107ba16a6e1f0bee2437496cb0
+#>proof e697355e5b07599e1729a710278a79cd  13:     -S2_4-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  13: --> -S6_4-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  14 learnt f2178b39169ae72cfdce962a6e63287b
+#>proof e697355e5b07599e1729a710278a79cd  14:      S4_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  14:      S6_2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  14:      S6_4-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  14: --> -S1_3-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  15 pkg e0aacedf5580151de254ebc8e9a4a6be
+#>proof e697355e5b07599e1729a710278a79cd  15:      S1_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  15:      S1_2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  15:      S1_3-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  15:     -P1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  15: -->  S1_5-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  16 pkg 48989d400f5ce6c79c7b43715d048866
+#>proof e697355e5b07599e1729a710278a79cd  16:     -S1_5-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  16: --> -S6_5-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  17 pkg cd018737f6458a197bd297027b6a2df6
+#>proof e697355e5b07599e1729a710278a79cd  17:     -S1_5-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  17: --> -S4_5-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  18 pkg 62fb118c548506369132cc397c15164b
+#>proof e697355e5b07599e1729a710278a79cd  18:      S6_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  18:      S6_2-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  18:      S6_4-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  18:      S6_5-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  18:     -P6-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  18: -->  S6_3-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  19 pkg 397dd963cdda285b84761646b33445de
+#>proof e697355e5b07599e1729a710278a79cd  19:      S4_1-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  19:      S4_5-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  19:     -P4-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  19: -->  S4_3-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  20 pkg 05835f2945587dc75bca89c01181b668
+#>proof e697355e5b07599e1729a710278a79cd  20:     -S4_3-1-1.noarch@available
+#>proof e697355e5b07599e1729a710278a79cd  20:     -S6_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   0 premise
+#>proof f2178b39169ae72cfdce962a6e63287b   0: -->  S1_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   1 premise
+#>proof f2178b39169ae72cfdce962a6e63287b   1: --> -S4_1-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   2 premise
+#>proof f2178b39169ae72cfdce962a6e63287b   2: --> -S6_2-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   3 premise
+#>proof f2178b39169ae72cfdce962a6e63287b   3: --> -S6_4-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   4 job da32e0142773b3bfea51699610370195
+#>proof f2178b39169ae72cfdce962a6e63287b   4: -->  P4-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   5 job 300768553afe091f7124f4e45ce8d9bb
+#>proof f2178b39169ae72cfdce962a6e63287b   5: -->  P6-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   6 learnt e406250c76867e458c9e9c93f6818d01
+#>proof f2178b39169ae72cfdce962a6e63287b   6: --> -S6_1-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   7 pkg cb86f2b9b6670245e0f2ef561fd00b54
+#>proof f2178b39169ae72cfdce962a6e63287b   7:     -S1_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   7: --> -S6_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   8 pkg 74304a9943a99ddc16da72d362aa98fd
+#>proof f2178b39169ae72cfdce962a6e63287b   8:     -S1_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   8: --> -S4_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   9 pkg 62fb118c548506369132cc397c15164b
+#>proof f2178b39169ae72cfdce962a6e63287b   9:      S6_1-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   9:      S6_2-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   9:      S6_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   9:      S6_4-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   9:     -P6-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b   9: -->  S6_5-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b  10 pkg 397dd963cdda285b84761646b33445de
+#>proof f2178b39169ae72cfdce962a6e63287b  10:      S4_1-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b  10:      S4_3-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b  10:     -P4-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b  10: -->  S4_5-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b  11 pkg 61eab9dab3c1dd0ea743fa5d49b32bee
+#>proof f2178b39169ae72cfdce962a6e63287b  11:     -S4_5-1-1.noarch@available
+#>proof f2178b39169ae72cfdce962a6e63287b  11:     -S6_5-1-1.noarch@available
+#>stats conflicts 7 learnt 6 unsolvable 1
+#>stats runs 1 decisions 6 branches 6
+#>stats reductions 3 deleted 1
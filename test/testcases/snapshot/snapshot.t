@@ -0,0 +1,50 @@
+# solve on a snapshot of the frozen pool
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+#>=Req: feature >= 1
+#>=Pkg: C 1 1 noarch
+#>=Prv: feature = 1
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Req: feature >= 2
+#>=Pkg: C 2 1 noarch
+#>=Prv: feature = 2
+#>=Pkg: D 1 1 noarch
+#>=Req: /usr/bin/e
+#>=Pkg: E 1 1 noarch
+#>=Fls: /usr/bin/e
+#>=Pkg: F 1 1 noarch
+#>=Pkg: F 2 1 noarch
+system i686 rpm system
+
+snapshot
+job update name A
+job install name D
+job install oneof F-1-1.noarch@available F-2-1.noarch@available
+result transaction,problems <inline>
+#>install D-1-1.noarch@available
+#>install E-1-1.noarch@available
+#>install F-2-1.noarch@available
+#>upgrade A-1-1.noarch@system A-2-1.noarch@available
+#>upgrade C-1-1.noarch@system C-2-1.noarch@available
+
+# the pool is unfrozen again after the solver is freed
+nextjob
+repo extra 0 testtags <inline>
+#>=Pkg: G 1 1 noarch
+#>=Req: feature >= 2
+snapshot
+job install name G
+result transaction,problems <inline>
+#>install G-1-1.noarch@extra
+#>upgrade C-1-1.noarch@system C-2-1.noarch@available
+
+# a problem and its solutions
+nextjob
+snapshot
+job install name A = 2-1
+job lock name C
+result transaction,problems <inline>
+#>problem c8ed4c9f info package A-2-1.noarch requires feature >= 2, but none of the providers can be installed
+#>problem c8ed4c9f solution 02f4de5a deljob install name A = 2-1
+#>problem c8ed4c9f solution 37190388 deljob lock name C
@@ -0,0 +1,89 @@
+# the pkg rules are created by 4 threads, this needs a frozen pool
+threads 4
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+#>=Req: B
+#>=Pkg: B 1 1 noarch
+#>=Pkg: X 1 1 noarch
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Req: B >= 2
+#>=Req: C
+#>=Pkg: B 2 1 noarch
+#>=Req: D
+#>=Req: E
+#>=Pkg: C 1 1 noarch
+#>=Req: F
+#>=Con: X
+#>=Pkg: C 2 1 noarch
+#>=Req: G
+#>=Pkg: D 1 1 noarch
+#>=Req: H
+#>=Pkg: E 1 1 noarch
+#>=Obs: X
+#>=Pkg: F 1 1 noarch
+#>=Pkg: G 1 1 noarch
+#>=Req: H
+#>=Pkg: H 1 1 noarch
+#>=Pkg: H 2 1 noarch
+#>=Req: I
+#>=Pkg: I 1 1 noarch
+#>=Rec: J
+#>=Pkg: J 1 1 noarch
+system i686 rpm system
+
+snapshot
+job update all packages
+result transaction,problems,rules <inline>
+#>erase X-1-1.noarch@system E-1-1.noarch@available
+#>install C-2-1.noarch@available
+#>install D-1-1.noarch@available
+#>install E-1-1.noarch@available
+#>install G-1-1.noarch@available
+#>install H-2-1.noarch@available
+#>install I-1-1.noarch@available
+#>install J-1-1.noarch@available
+#>rule pkg 02a98bb45569a650e360ee2edba4af86  F-1-1.noarch@available
+#>rule pkg 02a98bb45569a650e360ee2edba4af86 -C-1-1.noarch@available
+#>rule pkg 0c5d4e08e6f83c688416d7e53020f9c2  D-1-1.noarch@available
+#>rule pkg 0c5d4e08e6f83c688416d7e53020f9c2 -B-2-1.noarch@available
+#>rule pkg 11822080446cfc0e099a3ae6d1462843  C-1-1.noarch@available
+#>rule pkg 11822080446cfc0e099a3ae6d1462843  C-2-1.noarch@available
+#>rule pkg 11822080446cfc0e099a3ae6d1462843 -A-2-1.noarch@available
+#>rule pkg 2fd1ab3bb2abc017b749e1c6f6c38798 -B-1-1.noarch@system
+#>rule pkg 2fd1ab3bb2abc017b749e1c6f6c38798 -B-2-1.noarch@available
+#>rule pkg 46794bb06b26f9fb5d1eb0d1d50b840a  B-2-1.noarch@available
+#>rule pkg 46794bb06b26f9fb5d1eb0d1d50b840a -A-2-1.noarch@available
+#>rule pkg 65c490f698878de49b535d3832909fab  E-1-1.noarch@available
+#>rule pkg 65c490f698878de49b535d3832909fab -B-2-1.noarch@available
+#>rule pkg 6a83dce4ebd60f8c746add871ea39e30  H-1-1.noarch@available
+#>rule pkg 6a83dce4ebd60f8c746add871ea39e30  H-2-1.noarch@available
+#>rule pkg 6a83dce4ebd60f8c746add871ea39e30 -D-1-1.noarch@available
+#>rule pkg 77151345aaeddcb11654c413444ab875 -C-1-1.noarch@available
+#>rule pkg 77151345aaeddcb11654c413444ab875 -C-2-1.noarch@available
+#>rule pkg 79599c9619dccbc99efbd52a550147fd -A-1-1.noarch@system
+#>rule pkg 79599c9619dccbc99efbd52a550147fd -A-2-1.noarch@available
+#>rule pkg 82d3dcd980d2786e4a2c9293f200a75b  I-1-1.noarch@available
+#>rule pkg 82d3dcd980d2786e4a2c9293f200a75b -H-2-1.noarch@available
+#>rule pkg 8bbd3299fece2f857d98f1f392510395 -H-1-1.noarch@available
+#>rule pkg 8bbd3299fece2f857d98f1f392510395 -H-2-1.noarch@available
+#>rule pkg 8daac693dbc99687fd98700e7e9f515e  G-1-1.noarch@available
+#>rule pkg 8daac693dbc99687fd98700e7e9f515e -C-2-1.noarch@available
+#>rule pkg b6927efb2839907656802c4158c20098  H-1-1.noarch@available
+#>rule pkg b6927efb2839907656802c4158c20098  H-2-1.noarch@available
+#>rule pkg b6927efb2839907656802c4158c20098 -G-1-1.noarch@available
+#>rule pkg bc8a02731c67c63afec998f2bdb2b934 -E-1-1.noarch@available
+#>rule pkg bc8a02731c67c63afec998f2bdb2b934 -X-1-1.noarch@system
+#>rule pkg f5ecd0e2de267cbbbad753e4716dea9c  B-1-1.noarch@system
+#>rule pkg f5ecd0e2de267cbbbad753e4716dea9c  B-2-1.noarch@available
+#>rule pkg f5ecd0e2de267cbbbad753e4716dea9c -A-1-1.noarch@system
+#>rule pkg f6a326448dae0d68ba9106fb26dc8a77 -C-1-1.noarch@available
+#>rule pkg f6a326448dae0d68ba9106fb26dc8a77 -X-1-1.noarch@system
+#>rule update 2a59056689b685c0668c2ab8c09456d1  E-1-1.noarch@available
+#>rule update 2a59056689b685c0668c2ab8c09456d1  X-1-1.noarch@system
+#>rule update 5a452513aad292861844ca1ff42b17ec  B-1-1.noarch@system
+#>rule update 5a452513aad292861844ca1ff42b17ec  B-2-1.noarch@available
+#>rule update 8a0b6531c7a46f4091753b0b3d611a95  A-1-1.noarch@system
+#>rule update 8a0b6531c7a46f4091753b0b3d611a95  A-2-1.noarch@available
+#>upgrade A-1-1.noarch@system A-2-1.noarch@available
+#>upgrade B-1-1.noarch@system B-2-1.noarch@available
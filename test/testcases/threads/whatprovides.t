@@ -0,0 +1,35 @@
+# the whatprovides index is created by 4 threads, every
+# thread works on a slice of the solvables
+threads 4
+repo system 0 testtags <inline>
+#>=Pkg: A 1 1 noarch
+#>=Prv: feature = 1
+#>=Pkg: B 1 1 noarch
+#>=Req: feature
+repo available 0 testtags <inline>
+#>=Pkg: A 2 1 noarch
+#>=Prv: feature = 2
+#>=Pkg: C 1 1 noarch
+#>=Prv: feature = 3
+#>=Prv: other
+#>=Pkg: D 1 1 noarch
+#>=Req: other
+#>=Pkg: E 1 1 noarch
+#>=Prv: feature = 4
+#>=Prv: feature = 5
+repo extra 0 testtags <inline>
+#>=Pkg: C 2 1 noarch
+#>=Prv: feature = 6
+#>=Prv: other
+#>=Pkg: F 1 1 noarch
+#>=Req: feature > 5
+system i686 rpm system
+
+job install name D
+job install name F
+job update name A
+result transaction,problems <inline>
+#>install C-2-1.noarch@extra
+#>install D-1-1.noarch@available
+#>install F-1-1.noarch@extra
+#>upgrade A-1-1.noarch@system A-2-1.noarch@available
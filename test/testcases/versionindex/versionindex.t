@@ -0,0 +1,69 @@
+repo system 0 testtags <inline>
+#>=Pkg: A 1.0 1 noarch
+repo available 0 testtags <inline>
+#>=Pkg: A 0.9 1 noarch
+#>=Pkg: A 1.0 1 noarch
+#>=Pkg: A 1.0 2 noarch
+#>=Pkg: A 1.1 1 noarch
+#>=Pkg: A 1.2 1 noarch
+#>=Pkg: A 1.10 1 noarch
+#>=Pkg: A 2.0~rc1 1 noarch
+#>=Pkg: A 2.0 1 noarch
+#>=Pkg: A 1:0.5 1 noarch
+#>=Pkg: B 1 1 noarch
+#>=Prv: A = 1.5
+#>=Pkg: C 1 1 noarch
+#>=Prv: A
+#>=Pkg: D 1 1 noarch
+#>=Prv: A >= 3
+#>=Pkg: A 1.2 1 src
+#>=Pkg: AX 0.1 1 noarch
+#>=Pkg: AX 1.0 2 noarch
+#>=Pkg: AX 9 1 noarch
+#>=Pkg: AX 1:0 1 noarch
+system i686 rpm system
+poolflags versionindex
+
+job noop selection A*>=1.1 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-1.1-1.noarch@available A-1.2-1.noarch@available A-1.10-1.noarch@available A-2.0~rc1-1.noarch@available A-2.0-1.noarch@available A-1:0.5-1.noarch@available B-1-1.noarch@available C-1-1.noarch@available D-1-1.noarch@available AX-9-1.noarch@available AX-1:0-1.noarch@available
+
+nextjob
+job noop selection A*<1.1 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-1.0-1.noarch@system A-0.9-1.noarch@available A-1.0-1.noarch@available A-1.0-2.noarch@available C-1-1.noarch@available AX-0.1-1.noarch@available AX-1.0-2.noarch@available
+
+nextjob
+job noop selection A*=1.0 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-1.0-1.noarch@system A-1.0-1.noarch@available A-1.0-2.noarch@available C-1-1.noarch@available AX-1.0-2.noarch@available
+
+nextjob
+job noop selection A*=1.0-2 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-1.0-2.noarch@available C-1-1.noarch@available AX-1.0-2.noarch@available
+
+nextjob
+job noop selection A*<=1.0-1 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-1.0-1.noarch@system A-0.9-1.noarch@available A-1.0-1.noarch@available C-1-1.noarch@available AX-0.1-1.noarch@available
+
+nextjob
+job noop selection A*>1.0-1 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-1.0-2.noarch@available A-1.1-1.noarch@available A-1.2-1.noarch@available A-1.10-1.noarch@available A-2.0~rc1-1.noarch@available A-2.0-1.noarch@available A-1:0.5-1.noarch@available B-1-1.noarch@available C-1-1.noarch@available D-1-1.noarch@available AX-1.0-2.noarch@available AX-9-1.noarch@available AX-1:0-1.noarch@available
+
+nextjob
+job noop selection A*>2 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-2.0~rc1-1.noarch@available A-2.0-1.noarch@available A-1:0.5-1.noarch@available C-1-1.noarch@available D-1-1.noarch@available AX-9-1.noarch@available AX-1:0-1.noarch@available
+
+nextjob
+job noop selection A*<1:0 glob,provides,rel,flat
+result jobs <inline>
+#>job noop oneof A-1.0-1.noarch@system A-0.9-1.noarch@available A-1.0-1.noarch@available A-1.0-2.noarch@available A-1.1-1.noarch@available A-1.2-1.noarch@available A-1.10-1.noarch@available A-2.0~rc1-1.noarch@available A-2.0-1.noarch@available B-1-1.noarch@available C-1-1.noarch@available D-1-1.noarch@available AX-0.1-1.noarch@available AX-1.0-2.noarch@available AX-9-1.noarch@available
+
+nextjob
+job install provides A > 1.2
+result transaction,problems <inline>
+#>upgrade A-1.0-1.noarch@system A-1:0.5-1.noarch@available
@@ -0,0 +1,145 @@
+/*
+ * testoverlay
+ *
+ * checks the whatprovides overlay of solvers with
+ * SOLVER_FLAG_LOCAL_PROVIDERS: the provider data of the solver must
+ * be dropped when it is freed, SOLVER_FLAG_PROMOTE_PROVIDERS must keep
+ * the providers in the pool, and data that somebody else added while
+ * the overlay was active must stay valid.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+#include "util.h"
+
+static int nfailed;
+
+static void
+check(int ok, const char *what)
+{
+  printf("%s: %s\n", ok ? "ok" : "FAILED", what);
+  if (!ok)
+    nfailed++;
+}
+
+static Id
+addpkg(Pool *pool, Repo *repo, const char *name, const char *evr)
+{
+  Id p = repo_add_solvable(repo);
+  Solvable *s = pool->solvables + p;
+  s->name = pool_str2id(pool, name, 1);
+  s->evr = pool_str2id(pool, evr, 1);
+  s->arch = ARCH_NOARCH;
+  s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+  return p;
+}
+
+static Id
+feature(Pool *pool, const char *evr, int flags)
+{
+  return pool_rel2id(pool, pool_str2id(pool, "feature", 1), pool_str2id(pool, evr, 1), flags, 1);
+}
+
+/* check that off is a valid offset with the providers c2 and d */
+static int
+checkproviders(Pool *pool, Id off, Id c2, Id d)
+{
+  Id *wp;
+
+  if (off <= 0 || (Offset)off >= pool->whatprovidesdataoff)
+    return 0;
+  wp = pool->whatprovidesdata + off;
+  return wp[0] == c2 && wp[1] == d && wp[2] == 0;
+}
+
+static Solver *
+solve(Pool *pool, Id a, int localproviders, int promoteproviders)
+{
+  Solver *solv = solver_create(pool);
+  Queue job;
+
+  solver_set_flag(solv, SOLVER_FLAG_LOCAL_PROVIDERS, localproviders);
+  solver_set_flag(solv, SOLVER_FLAG_PROMOTE_PROVIDERS, promoteproviders);
+  queue_init(&job);
+  queue_push2(&job, SOLVER_INSTALL | SOLVER_SOLVABLE, a);
+  if (solver_solve(solv, &job) || solver_get_decisionlevel(solv, a) <= 0)
+    {
+      fprintf(stderr, "testoverlay: could not install A\n");
+      exit(1);
+    }
+  queue_free(&job);
+  return solv;
+}
+
+int
+main()
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "available");
+  Solver *solv, *solv2;
+  Id a, c2, d, dep;
+  Id off, wp;
+  Offset dataoff;
+  Queue q;
+
+  pool_setarch(pool, "noarch");
+  a = addpkg(pool, repo, "A", "1-1");
+  pool->solvables[a].requires = repo_addid_dep(repo, 0, feature(pool, "2", REL_GT | REL_EQ), 0);
+  addpkg(pool, repo, "C", "1-1");
+  pool->solvables[a + 1].provides = repo_addid_dep(repo, pool->solvables[a + 1].provides, feature(pool, "1", REL_EQ), 0);
+  c2 = addpkg(pool, repo, "C", "2-1");
+  pool->solvables[c2].provides = repo_addid_dep(repo, pool->solvables[c2].provides, feature(pool, "2", REL_EQ), 0);
+  d = addpkg(pool, repo, "D", "1-1");
+  pool->solvables[d].provides = repo_addid_dep(repo, pool->solvables[d].provides, feature(pool, "3", REL_EQ), 0);
+  repo_internalize(repo);
+  dep = feature(pool, "2", REL_GT | REL_EQ);
+  pool_createwhatprovides(pool);
+  dataoff = pool->whatprovidesdataoff;
+
+  /* the providers are dropped with the solver */
+  solv = solve(pool, a, 1, 0);
+  check(pool->whatprovidesdataoff > dataoff, "the solver added provider data");
+  solver_free(solv);
+  check(pool->whatprovidesdataoff == dataoff, "the provider data is dropped");
+  check(pool->whatprovides_rel[GETRELID(dep)] == 0, "the dropped providers are not cached");
+
+  /* promoted providers stay */
+  solv = solve(pool, a, 1, 1);
+  solver_free(solv);
+  check(checkproviders(pool, pool->whatprovides_rel[GETRELID(dep)], c2, d), "the promoted providers are cached");
+  pool_createwhatprovides(pool);
+
+  /* a lookup after solving must not return data of the overlay */
+  solv = solve(pool, a, 1, 0);
+  wp = pool_whatprovides(pool, dep);
+  solver_free(solv);
+  check(checkproviders(pool, wp, c2, d), "providers looked up while the solver exists stay valid");
+  pool_createwhatprovides(pool);
+  dataoff = pool->whatprovidesdataoff;
+
+  /* the provider list of a job */
+  solv = solve(pool, a, 1, 0);
+  queue_init(&q);
+  queue_push2(&q, c2, d);
+  off = pool_queuetowhatprovides(pool, &q);
+  queue_free(&q);
+  solver_free(solv);
+  check(checkproviders(pool, off, c2, d), "a job provider list added while the solver exists stays valid");
+  check(pool->whatprovidesdataoff > dataoff, "the provider data is kept");
+  pool_createwhatprovides(pool);
+
+  /* a solver without local providers uses the data */
+  solv = solve(pool, a, 1, 0);
+  solv2 = solve(pool, a, 0, 0);
+  solver_free(solv);
+  check(checkproviders(pool, pool->whatprovides_rel[GETRELID(dep)], c2, d), "the providers of the other solver stay valid");
+  solver_free(solv2);
+
+  pool_free(pool);
+  return nfailed ? 1 : 0;
+}
@@ -0,0 +1,461 @@
+/*
+ * testpaging
+ *
+ * checks the loading of a solv file with paged file lists: the file
+ * lists must be the same as the ones that were written, no matter
+ * how the file is loaded.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+#include "util.h"
+
+#define NPKGS	500
+#define NPKGS_BIG	5000	/* about 80 pages, enough for 4 threads */
+#define NFILES	40
+
+static int nfailed;
+
+static void
+check(int ok, const char *what)
+{
+  printf("%s: %s\n", ok ? "ok" : "FAILED", what);
+  if (!ok)
+    nfailed++;
+}
+
+static void
+genrepo(Pool *pool, int npkgs)
+{
+  Repo *repo = repo_create(pool, "test");
+  Repodata *data = repo_add_repodata(repo, 0);
+  char buf[256];
+  Solvable *s;
+  Id p, did;
+  int i, j;
+
+  for (i = 0; i < npkgs; i++)
+    {
+      p = repo_add_solvable(repo);
+      s = pool->solvables + p;
+      snprintf(buf, sizeof(buf), "pkg%d", i);
+      s->name = pool_str2id(pool, buf, 1);
+      s->evr = pool_str2id(pool, "1.0-1", 1);
+      s->arch = ARCH_NOARCH;
+      s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+      for (j = 0; j < NFILES; j++)
+	{
+	  snprintf(buf, sizeof(buf), "/usr/share/pkg%d/dir%d", i, j % 8);
+	  did = repodata_str2dir(data, buf, 1);
+	  snprintf(buf, sizeof(buf), "file%d_%d", j, (i * 7919 + j * 104729) % 1000);
+	  repodata_add_dirstr(data, p, SOLVABLE_FILELIST, did, buf);
+	}
+    }
+  repo_internalize(repo);
+}
+
+static FILE *
+writerepo(Repo *repo, int flags, const char *trailer)
+{
+  Repowriter *writer;
+  FILE *fp = tmpfile();
+
+  if (!fp)
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  writer = repowriter_create(repo);
+  repowriter_set_flags(writer, flags);
+  repowriter_write(writer, fp);
+  repowriter_free(writer);
+  if (trailer)
+    fputs(trailer, fp);
+  fflush(fp);
+  return fp;
+}
+
+static unsigned int
+addstr(unsigned int sum, const char *str)
+{
+  for (; *str; str++)
+    sum = sum * 31 + (unsigned char)*str;
+  return sum;
+}
+
+/* a checksum of the name and the file list of solvable p. The base
+ * names are unique, the directories are not looked up as this is slow
+ * for many directories */
+static unsigned int
+sumfiles(Pool *pool, Repo *repo, Id p)
+{
+  Dataiterator di;
+  unsigned int sum = addstr(0, pool_id2str(pool, pool->solvables[p].name));
+
+  dataiterator_init(&di, pool, repo, p, SOLVABLE_FILELIST, 0, 0);
+  while (dataiterator_step(&di))
+    sum = addstr(sum * 31, di.kv.str);
+  dataiterator_free(&di);
+  return sum;
+}
+
+/* a checksum of all file lists, looked up package by package */
+static unsigned int
+sumall(Pool *pool, Repo *repo)
+{
+  unsigned int sum = 0;
+  Id p;
+
+  for (p = repo->start; p < repo->end; p++)
+    sum = sum * 31 + sumfiles(pool, repo, p);
+  return sum;
+}
+
+static Pool *
+loadrepo(FILE *fp, int addflags, int cachesize)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "test");
+
+  pool_set_flag(pool, POOL_FLAG_PAGECACHESIZE, cachesize);
+  rewind(fp);
+  if (repo_add_solv(repo, fp, addflags))
+    {
+      fprintf(stderr, "testpaging: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  return pool;
+}
+
+/* load fp with addflags and compare the file lists */
+static void
+checkload(FILE *fp, int addflags, unsigned int ref, const char *what)
+{
+  Pool *pool = loadrepo(fp, addflags, 0);
+
+  check(sumall(pool, pool->repos[1]) == ref, what);
+  pool_free(pool);
+}
+
+/* a checksum of all file lists, visited by one dataiterator. This is
+ * a sequential scan that prefetches the pages */
+static unsigned int
+scanall(Pool *pool, Repo *repo)
+{
+  Dataiterator di;
+  unsigned int sum = 0, psum = 0;
+  Id p = 0;
+
+  dataiterator_init(&di, pool, repo, 0, SOLVABLE_FILELIST, 0, 0);
+  while (dataiterator_step(&di))
+    {
+      if (di.solvid != p)
+	{
+	  if (p)
+	    sum = sum * 31 + psum;
+	  p = di.solvid;
+	  psum = addstr(0, pool_id2str(pool, pool->solvables[p].name));
+	}
+      psum = addstr(psum * 31, di.kv.str);
+    }
+  dataiterator_free(&di);
+  return p ? sum * 31 + psum : sum;
+}
+
+/* look up up to 1500 file lists in a random order, refs are the
+ * checksums of the written file lists */
+static int
+lookupsok(Pool *pool, Repo *repo, unsigned int *refs)
+{
+  int i, n = repo->end - repo->start, ok = 1;
+  Id p;
+
+  for (i = 0; i < 3 * n && i < 1500; i++)
+    {
+      p = repo->start + (int)((i * 7919U) % n);
+      if (sumfiles(pool, repo, p) != refs[p - repo->start])
+	ok = 0;
+    }
+  return ok;
+}
+
+/* random lookups with a page cache of cachesize K */
+static void
+checklookups(FILE *fp, int addflags, int cachesize, unsigned int *refs, const char *what)
+{
+  Pool *pool = loadrepo(fp, addflags, cachesize);
+
+  check(lookupsok(pool, pool->repos[1], refs), what);
+  pool_free(pool);
+}
+
+/* scan the file lists with a small cache, the random lookups after the
+ * scan must not use the prefetched pages of the scan */
+static void
+checkscan(FILE *fp, int addflags, unsigned int ref, unsigned int *refs, const char *what)
+{
+  Pool *pool = loadrepo(fp, addflags, 64);
+  Repo *repo = pool->repos[1];
+  char msg[256];
+
+  snprintf(msg, sizeof(msg), "%s: the scan", what);
+  check(scanall(pool, repo) == ref, msg);
+  snprintf(msg, sizeof(msg), "%s: random lookups after the scan", what);
+  check(lookupsok(pool, repo, refs), msg);
+  snprintf(msg, sizeof(msg), "%s: a second scan", what);
+  check(scanall(pool, repo) == ref, msg);
+  pool_free(pool);
+}
+
+/* pool_addfileprovides walks the file lists to find the required
+ * files. The file of pkg is required by a package of another repo. */
+static void
+checkfileprovides(FILE *fp, int pkg, const char *what)
+{
+  Pool *pool = loadrepo(fp, 0, 64);
+  Repo *repo = repo_create(pool, "job");
+  Id p, pp, dep;
+  char buf[256];
+  int nprovides = 0, ok = 1;
+
+  snprintf(buf, sizeof(buf), "/usr/share/pkg%d/dir%d/file%d_%d", pkg, 3, 3, (pkg * 7919 + 3 * 104729) % 1000);
+  dep = pool_str2id(pool, buf, 1);
+  p = repo_add_solvable(repo);
+  pool->solvables[p].name = pool_str2id(pool, "job", 1);
+  pool->solvables[p].requires = repo_addid_dep(repo, 0, dep, 0);
+  pool_addfileprovides(pool);
+  pool_createwhatprovides(pool);
+  snprintf(buf, sizeof(buf), "pkg%d", pkg);
+  FOR_PROVIDES(p, pp, dep)
+    {
+      nprovides++;
+      if (strcmp(pool_id2str(pool, pool->solvables[p].name), buf) != 0)
+	ok = 0;
+    }
+  check(ok && nprovides == 1, what);
+  pool_free(pool);
+}
+
+/* load all pages with up to nthreads threads after some lookups with
+ * a small cache */
+static void
+checkdisable(FILE *fp, int addflags, int nthreads, unsigned int ref, const char *what)
+{
+  Pool *pool = loadrepo(fp, addflags, 64);
+  Repo *repo = pool->repos[1];
+  Id p;
+
+  for (p = repo->start; p < repo->end; p += 97)
+    sumfiles(pool, repo, p);
+  repo_disable_paging_threaded(repo, nthreads);
+  check(sumall(pool, repo) == ref, what);
+  pool_free(pool);
+}
+
+/* check that the file pointer is behind the solv data after the load */
+static void
+checktrailer(FILE *fp, int addflags, const char *trailer, const char *what)
+{
+  Pool *pool = loadrepo(fp, addflags, 0);
+  char buf[64];
+  size_t l = strlen(trailer);
+
+  check(fread(buf, l, 1, fp) == 1 && !memcmp(buf, trailer, l), what);
+  pool_free(pool);
+}
+
+static long
+filesize(FILE *fp)
+{
+  fseek(fp, 0, SEEK_END);
+  return ftell(fp);
+}
+
+/* copy the first size bytes of the file and overwrite 16 bytes at
+ * offset corrupt if it is not negative. With bufp the copy is a memory
+ * stream that can not be mapped, *bufp must be freed after closing it. */
+static FILE *
+copyrepo(FILE *fp, long size, long corrupt, char **bufp)
+{
+  char *buf = solv_malloc(size);
+  FILE *cfp;
+
+  rewind(fp);
+  if (fread(buf, size, 1, fp) != 1)
+    {
+      perror("fread");
+      exit(1);
+    }
+  if (corrupt >= 0)
+    memset(buf + corrupt, 0xa5, 16);
+  if (bufp)
+    {
+      *bufp = buf;
+      if (!(cfp = fmemopen(buf, size, "r")))
+	{
+	  perror("fmemopen");
+	  exit(1);
+	}
+      return cfp;
+    }
+  if (!(cfp = tmpfile()) || fwrite(buf, size, 1, cfp) != 1 || fflush(cfp))
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  solv_free(buf);
+  return cfp;
+}
+
+/* try to load the file, returns 2 if the load fails, 1 if the file
+ * lists differ from ref */
+static int
+loaddamaged(FILE *fp, int addflags, unsigned int ref)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "test");
+  int ret = 0;
+
+  rewind(fp);
+  if (repo_add_solv(repo, fp, addflags))
+    ret = 2;
+  else if (sumall(pool, repo) != ref)
+    ret = 1;
+  pool_free(pool);
+  return ret;
+}
+
+/* load a truncated or corrupt copy of the file. A stream is read at
+ * once, so the load must fail. A file is paged, a corrupt page may
+ * only show up in the lookups. */
+static void
+checkdamaged(FILE *fp, long size, long corrupt, unsigned int ref, const char *what)
+{
+  FILE *cfp;
+  char *buf, msg[256];
+  int ret;
+
+  cfp = copyrepo(fp, size, corrupt, &buf);
+  snprintf(msg, sizeof(msg), "%s: the stream is rejected", what);
+  check(loaddamaged(cfp, 0, ref) == 2, msg);
+  fclose(cfp);
+  solv_free(buf);
+  cfp = copyrepo(fp, size, corrupt, 0);
+  ret = loaddamaged(cfp, 0, ref);
+  snprintf(msg, sizeof(msg), "%s: the file is %s", what, corrupt < 0 ? "rejected" : "rejected or the lookups fail");
+  check(corrupt < 0 ? ret == 2 : ret != 0, msg);
+  ret = loaddamaged(cfp, SOLV_ADD_MMAP, ref);
+  snprintf(msg, sizeof(msg), "%s: the mapped file is %s", what, corrupt < 0 ? "rejected" : "rejected or the lookups fail");
+  check(corrupt < 0 ? ret == 2 : ret != 0, msg);
+  fclose(cfp);
+}
+
+/* the format version of a solv file */
+static unsigned int
+solvversion(FILE *fp)
+{
+  unsigned char d[8];
+
+  rewind(fp);
+  if (fread(d, 8, 1, fp) != 1)
+    return 0;
+  return d[4] << 24 | d[5] << 16 | d[6] << 8 | d[7];
+}
+
+int
+main()
+{
+  Pool *pool;
+  FILE *fp, *ufp, *lfp, *mfp, *bfp, *bufp, *blfp;
+  char *mbuf;
+  unsigned int ref, bigref, refs[NPKGS], *bigrefs;
+  long size;
+  Id p;
+  const char *trailer = "trailing data";
+
+  pool = pool_create();
+  genrepo(pool, NPKGS);
+  ref = sumall(pool, pool->repos[1]);
+  for (p = pool->repos[1]->start; p < pool->repos[1]->end; p++)
+    refs[p - pool->repos[1]->start] = sumfiles(pool, pool->repos[1], p);
+  fp = writerepo(pool->repos[1], 0, trailer);
+  ufp = writerepo(pool->repos[1], REPOWRITER_NO_PAGE_COMPRESSION, 0);
+  lfp = writerepo(pool->repos[1], REPOWRITER_LZ4_PAGE_COMPRESSION, 0);
+  pool_free(pool);
+
+  /* SOLV_ADD_MMAP */
+  checkload(fp, 0, ref, "the file lists are read with stdio");
+  checkload(fp, SOLV_ADD_MMAP, ref, "the file lists are read from the mapping");
+  checktrailer(fp, 0, trailer, "stdio leaves the file pointer behind the solv data");
+  checktrailer(fp, SOLV_ADD_MMAP, trailer, "the mapping leaves the file pointer behind the solv data");
+  mfp = copyrepo(fp, filesize(fp), -1, &mbuf);
+  checkload(mfp, SOLV_ADD_MMAP, ref, "a file that can not be mapped is read with stdio");
+  fclose(mfp);
+  solv_free(mbuf);
+
+  /* uncompressed pages and the page cache, the cache holds at least
+   * 4 pages of 32K */
+  check(ftell(ufp) > 8 * 32768, "the file lists do not fit into a small cache");
+  checkload(ufp, 0, ref, "uncompressed pages are read with stdio");
+  checkload(ufp, SOLV_ADD_MMAP, ref, "uncompressed pages are used from the mapping");
+  checklookups(fp, 0, 0, refs, "random lookups with the default cache");
+  checklookups(fp, 0, 64, refs, "random lookups with a small cache");
+  checklookups(fp, SOLV_ADD_MMAP, 64, refs, "random lookups with a small cache from the mapping");
+  checklookups(ufp, 0, 64, refs, "random lookups of uncompressed pages with a small cache");
+  checklookups(ufp, SOLV_ADD_MMAP, 64, refs, "random lookups of mapped uncompressed pages");
+
+  /* lz4 pages */
+  check(solvversion(lfp) == SOLV_VERSION_10 && solvversion(fp) < SOLV_VERSION_10, "only files with lz4 pages are SOLV_VERSION_10");
+  checkload(lfp, 0, ref, "lz4 pages are read with stdio");
+  checkload(lfp, SOLV_ADD_MMAP, ref, "lz4 pages are read from the mapping");
+  checklookups(lfp, 0, 64, refs, "random lookups of lz4 pages with a small cache");
+  checklookups(lfp, SOLV_ADD_MMAP, 64, refs, "random lookups of mapped lz4 pages with a small cache");
+
+  /* truncated and corrupt lz4 pages, the pages are at the end */
+  size = filesize(lfp);
+  checkdamaged(lfp, size - 1, -1, ref, "the last page is truncated");
+  checkdamaged(lfp, size * 3 / 4, -1, ref, "a page is truncated");
+  checkdamaged(lfp, size, size - 20, ref, "the last page is corrupt");
+  checkdamaged(lfp, size, size / 2, ref, "a page is corrupt");
+
+  /* load all pages with threads */
+  pool = pool_create();
+  genrepo(pool, NPKGS_BIG);
+  bigref = sumall(pool, pool->repos[1]);
+  bigrefs = solv_calloc(NPKGS_BIG, sizeof(unsigned int));
+  for (p = pool->repos[1]->start; p < pool->repos[1]->end; p++)
+    bigrefs[p - pool->repos[1]->start] = sumfiles(pool, pool->repos[1], p);
+  bfp = writerepo(pool->repos[1], 0, 0);
+  bufp = writerepo(pool->repos[1], REPOWRITER_NO_PAGE_COMPRESSION, 0);
+  blfp = writerepo(pool->repos[1], REPOWRITER_LZ4_PAGE_COMPRESSION, 0);
+  pool_free(pool);
+  checkdisable(fp, 0, 4, ref, "too few pages for threads are loaded without them");
+  checkdisable(bfp, 0, 1, bigref, "all pages are loaded without threads");
+  checkdisable(bfp, 0, 2, bigref, "all pages are loaded with 2 threads");
+  checkdisable(bfp, 0, 4, bigref, "all pages are loaded with 4 threads");
+  checkdisable(blfp, 0, 4, bigref, "all lz4 pages are loaded with 4 threads");
+  checkdisable(bufp, SOLV_ADD_MMAP, 4, bigref, "all mapped uncompressed pages are loaded with 4 threads");
+
+  /* sequential scans prefetch the pages */
+  checkscan(bfp, 0, bigref, bigrefs, "libsolv pages");
+  checkscan(blfp, 0, bigref, bigrefs, "lz4 pages");
+  checkscan(bfp, SOLV_ADD_MMAP, bigref, bigrefs, "mapped libsolv pages");
+  checkscan(bufp, SOLV_ADD_MMAP, bigref, bigrefs, "mapped uncompressed pages");
+  checkfileprovides(bfp, NPKGS_BIG - 1, "the file provides are found in the last page");
+  checkfileprovides(blfp, NPKGS_BIG / 2, "the file provides are found in lz4 pages");
+  solv_free(bigrefs);
+
+  fclose(fp);
+  fclose(ufp);
+  fclose(lfp);
+  fclose(bfp);
+  fclose(bufp);
+  fclose(blfp);
+  return nfailed ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * testrelprovidercache
+ *
+ * checks the stored providers of repo_add_relprovidercache: they must
+ * be used when the repository is loaded into a pool of the same
+ * composition and be ignored once a solvable was changed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+#include "util.h"
+
+static int nfailed;
+
+static void
+check(int ok, const char *what)
+{
+  printf("%s: %s\n", ok ? "ok" : "FAILED", what);
+  if (!ok)
+    nfailed++;
+}
+
+static Id
+feature(Pool *pool, const char *evr, int flags)
+{
+  return pool_rel2id(pool, pool_str2id(pool, "feature", 1), pool_str2id(pool, evr, 1), flags, 1);
+}
+
+static Id
+addpkg(Pool *pool, Repo *repo, const char *name, const char *evr, Id prv, Id req)
+{
+  Id p = repo_add_solvable(repo);
+  Solvable *s = pool->solvables + p;
+  s->name = pool_str2id(pool, name, 1);
+  s->evr = pool_str2id(pool, evr, 1);
+  s->arch = ARCH_NOARCH;
+  s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+  if (prv)
+    s->provides = repo_addid_dep(repo, s->provides, prv, 0);
+  if (req)
+    s->requires = repo_addid_dep(repo, s->requires, req, 0);
+  return p;
+}
+
+/* the dependencies of the test, the cached providers are checked for all of them */
+static void
+deps(Pool *pool, Id *dp)
+{
+  dp[0] = feature(pool, "2", REL_GT | REL_EQ);
+  dp[1] = feature(pool, "3", REL_LT);
+  dp[2] = feature(pool, "0", REL_GT);
+  dp[3] = 0;
+}
+
+/* a string with the providers of dep */
+static const char *
+providers(Pool *pool, Id dep)
+{
+  const char *str = "";
+  Id p, pp;
+
+  FOR_PROVIDES(p, pp, dep)
+    str = pool_tmpappend(pool, str, " ", pool_solvid2str(pool, p));
+  return str;
+}
+
+static Pool *
+loadrepo(FILE *fp)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "test");
+
+  pool_setarch(pool, "noarch");
+  rewind(fp);
+  if (repo_add_solv(repo, fp, 0))
+    {
+      fprintf(stderr, "testrelprovidercache: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  return pool;
+}
+
+int
+main()
+{
+  Pool *pool;
+  Repo *repo;
+  FILE *fp;
+  Id d, dep[4];
+  char *expected[3];
+  int i, allcached;
+
+  /* create a repository with stored providers */
+  pool = pool_create();
+  pool_setarch(pool, "noarch");
+  repo = repo_create(pool, "test");
+  deps(pool, dep);
+  addpkg(pool, repo, "A", "1-1", 0, dep[0]);
+  addpkg(pool, repo, "B", "1-1", 0, dep[2]);
+  addpkg(pool, repo, "C", "1-1", feature(pool, "1", REL_EQ), 0);
+  addpkg(pool, repo, "C", "2-1", feature(pool, "2", REL_EQ), 0);
+  addpkg(pool, repo, "D", "1-1", feature(pool, "3", REL_EQ), dep[1]);
+  repo_internalize(repo);
+  pool_createwhatprovides(pool);
+  for (i = 0; (d = dep[i]) != 0; i++)
+    expected[i] = solv_strdup(providers(pool, d));
+  if (repo_add_relprovidercache(repo, 0))
+    {
+      fprintf(stderr, "testrelprovidercache: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  if (!(fp = tmpfile()))
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  repo_write(repo, fp);
+  fflush(fp);
+  pool_free(pool);
+
+  /* load it into a pool of the same composition */
+  pool = loadrepo(fp);
+  deps(pool, dep);
+  pool_createwhatprovides(pool);
+  for (i = 0, allcached = 1; (d = dep[i]) != 0; i++)
+    if (!pool->whatprovides_rel[GETRELID(d)])
+      allcached = 0;
+  check(allcached, "the stored providers are added with the index");
+  for (i = 0; (d = dep[i]) != 0; i++)
+    check(!strcmp(providers(pool, d), expected[i]), pool_tmpjoin(pool, "the stored providers of ", pool_dep2str(pool, d), " are correct"));
+  pool_free(pool);
+
+  /* change a solvable, the stored providers must be ignored */
+  pool = loadrepo(fp);
+  deps(pool, dep);
+  repo = pool->repos[1];
+  pool->solvables[repo->end - 1].provides = repo_addid_dep(repo, 0, feature(pool, "1", REL_EQ), 0);
+  pool_createwhatprovides(pool);
+  for (i = 0, allcached = 0; (d = dep[i]) != 0; i++)
+    if (pool->whatprovides_rel[GETRELID(d)])
+      allcached = 1;
+  check(!allcached, "the stored providers are ignored after a change");
+  check(!strcmp(providers(pool, dep[0]), " C-2-1.noarch"), "the providers are computed after a change");
+  pool_free(pool);
+
+  fclose(fp);
+  for (i = 0; i < 3; i++)
+    solv_free(expected[i]);
+  return nfailed ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * benchpool.c
+ *
+ * create the package pool of the solver benchmarks: nnames packages
+ * in nversions versions each, with random versioned requires and
+ * conflicts. The pool only depends on the arguments.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "util.h"
+#include "benchpool.h"
+
+static Id
+genrequires(Pool *pool, Id name, Id *evrs, int nversions, int requires)
+{
+  if (requires == BENCHPOOL_REQUIRES_GE)
+    return pool_rel2id(pool, name, evrs[rand() % nversions], REL_GT | REL_EQ, 1);
+  if (requires == BENCHPOOL_REQUIRES_GE_LT)
+    return pool_rel2id(pool, name, evrs[rand() % nversions], rand() % 2 ? REL_GT | REL_EQ : REL_LT, 1);
+  /* name < evr of the first version has no provider */
+  if (rand() % 2)
+    return pool_rel2id(pool, name, evrs[rand() % nversions], REL_GT | REL_EQ, 1);
+  return pool_rel2id(pool, name, evrs[nversions > 1 ? 1 + rand() % (nversions - 1) : 0], REL_LT, 1);
+}
+
+Repo *
+tool_genpool(Pool *pool, int nnames, int nversions, int nrequires, int requires)
+{
+  Repo *repo = repo_create(pool, "bench");
+  char buf[256];
+  Solvable *s;
+  Id p, *names, *evrs;
+  int i, v, j, n;
+
+  names = solv_calloc(nnames, sizeof(Id));
+  evrs = solv_calloc(nversions, sizeof(Id));
+  for (i = 0; i < nnames; i++)
+    {
+      snprintf(buf, sizeof(buf), "pkg%d", i);
+      names[i] = pool_str2id(pool, buf, 1);
+    }
+  for (v = 0; v < nversions; v++)
+    {
+      snprintf(buf, sizeof(buf), "%d.%d-1", v / 10 + 1, v % 10);
+      evrs[v] = pool_str2id(pool, buf, 1);
+    }
+  srand(42);
+  for (i = 0; i < nnames; i++)
+    for (v = 0; v < nversions; v++)
+      {
+	p = repo_add_solvable(repo);
+	s = pool->solvables + p;
+	s->name = names[i];
+	s->evr = evrs[v];
+	s->arch = ARCH_NOARCH;
+	s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+	for (j = 0; j < nrequires; j++)
+	  {
+	    n = rand() % nnames;
+	    if (n == i)
+	      continue;
+	    s->requires = repo_addid_dep(repo, s->requires, genrequires(pool, names[n], evrs, nversions, requires), 0);
+	  }
+	if (rand() % 4 == 0)
+	  {
+	    n = rand() % nnames;
+	    if (n != i)
+	      s->conflicts = repo_addid_dep(repo, s->conflicts, pool_rel2id(pool, names[n], evrs[rand() % nversions], REL_LT, 1), 0);
+	  }
+      }
+  repo_internalize(repo);
+  solv_free(names);
+  solv_free(evrs);
+  return repo;
+}
+
+/* create an installed system with the first version of the first
+ * ninstalled packages of a tool_genpool repo */
+Repo *
+tool_geninstalled(Pool *pool, Repo *repo, int nversions, int ninstalled)
+{
+  Repo *system = repo_create(pool, "system");
+  Solvable *s, *ps;
+  Id p, *dp;
+  int i;
+
+  for (i = 0; i < ninstalled; i++)
+    {
+      p = repo_add_solvable(system);
+      s = pool->solvables + p;
+      ps = pool->solvables + repo->start + i * nversions;
+      s->name = ps->name;
+      s->evr = ps->evr;
+      s->arch = ps->arch;
+      s->provides = repo_addid_dep(system, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+      if (ps->requires)
+	for (dp = repo->idarraydata + ps->requires; *dp; dp++)
+	  s->requires = repo_addid_dep(system, s->requires, *dp, 0);
+    }
+  repo_internalize(system);
+  pool_set_installed(pool, system);
+  return system;
+}
@@ -0,0 +1,21 @@
+/*
+ * benchpool.h
+ *
+ * the generated package pool of the solver benchmarks
+ */
+
+#ifndef BENCHPOOL_H
+#define BENCHPOOL_H
+
+#include "pool.h"
+#include "repo.h"
+
+/* the kind of the versioned requires */
+#define BENCHPOOL_REQUIRES_GE		0	/* name >= evr */
+#define BENCHPOOL_REQUIRES_GE_LT	1	/* name >= evr or name < evr */
+#define BENCHPOOL_REQUIRES_GE_LT_SAT	2	/* like GE_LT, but no unsatisfiable name < evr */
+
+Repo *tool_genpool(Pool *pool, int nnames, int nversions, int nrequires, int requires);
+Repo *tool_geninstalled(Pool *pool, Repo *repo, int nversions, int ninstalled);
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * condamatchbench
+ *
+ * measure how fast conda matchspecs get resolved to the providing
+ * packages. Creates a pool that looks like a conda channel with many
+ * versions and builds of every package and resolves a mix of version
+ * ranges, build strings, name globs and name regexes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "util.h"
+#include "conda.h"
+#include "knownid.h"
+
+static const char **specs;
+static int nspecs;
+
+static void
+addspec(const char *spec)
+{
+  specs = solv_extend(specs, nspecs, 1, sizeof(*specs), 255);
+  specs[nspecs++] = solv_strdup(spec);
+}
+
+static void
+genname(char *buf, size_t len, int i)
+{
+  static const char *prefixes[] = { "py", "lib", "r-", "perl-", "ros-", "jupyter", "font-", "" };
+  snprintf(buf, len, "%s%c%c%d", prefixes[i % 8], 'a' + (i / 8) % 26, 'a' + (i / 208) % 26, i);
+}
+
+static void
+genpool(Pool *pool, int nnames, int nversions)
+{
+  static const char *pys[] = { "py38", "py39", "py310", "py311", "py312" };
+  Repo *repo = repo_create(pool, "channel");
+  char buf[256];
+  Solvable *s;
+  Id p, name;
+  int i, v, b;
+
+  for (i = 0; i < nnames; i++)
+    {
+      genname(buf, sizeof(buf), i);
+      name = pool_str2id(pool, buf, 1);
+      for (v = 0; v < nversions; v++)
+	for (b = 0; b < 3; b++)
+	  {
+	    p = repo_add_solvable(repo);
+	    s = pool->solvables + p;
+	    s->name = name;
+	    snprintf(buf, sizeof(buf), "%d.%d.%d", v / 10, v % 10, b);
+	    s->evr = pool_str2id(pool, buf, 1);
+	    s->arch = ARCH_NOARCH;
+	    s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+	    snprintf(buf, sizeof(buf), "%sh%x_%d", pys[(i + v + b) % 5], (i * 31 + v) & 0xffff, b);
+	    repo_set_str(repo, p, SOLVABLE_BUILDFLAVOR, buf);
+	  }
+    }
+  repo_internalize(repo);
+}
+
+static void
+genspecs(int num, int nnames, int nversions)
+{
+  char name[128], buf[256];
+  int i, v;
+
+  srand(42);
+  for (i = 0; i < num; i++)
+    {
+      genname(name, sizeof(name), rand() % nnames);
+      v = rand() % (nversions ? nversions : 1);
+      switch (rand() % 8)
+	{
+	case 0:
+	  snprintf(buf, sizeof(buf), "%s", name);
+	  break;
+	case 1:
+	  snprintf(buf, sizeof(buf), "%s >=%d.%d,<%d", name, v / 10, v % 10, v / 10 + 1);
+	  break;
+	case 2:
+	  snprintf(buf, sizeof(buf), "%s %d.%d.*", name, v / 10, v % 10);
+	  break;
+	case 3:
+	  snprintf(buf, sizeof(buf), "%s ==%d.%d.1 py3*", name, v / 10, v % 10);
+	  break;
+	case 4:
+	  snprintf(buf, sizeof(buf), "%s >=%d.%d|<0.5 *_2", name, v / 10, v % 10);
+	  break;
+	case 5:
+	  snprintf(buf, sizeof(buf), "%.4s* >=%d.%d", name, v / 10, v % 10);
+	  break;
+	case 6:
+	  snprintf(buf, sizeof(buf), "^%.5s.*$ ~=%d.%d.0", name, v / 10, v % 10);
+	  break;
+	default:
+	  snprintf(buf, sizeof(buf), "%s* %d.%d.2", name, v / 10, v % 10);
+	  break;
+	}
+      addspec(buf);
+    }
+}
+
+static double
+elapsed(clock_t start)
+{
+  return (clock() - start) / (double)CLOCKS_PER_SEC;
+}
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  condamatchbench [-n <names>] [-v <versions>] [-s <specs>] [-r <rounds>] [specs...]\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  Id *ids, p, pp;
+  int c, i, r, nnames = 2000, nversions = 30, nspecsgen = 5000, rounds = 5;
+  unsigned long long nproviders = 0;
+  clock_t start;
+  double secs, parsesecs = 0, resolvesecs = 0;
+
+  while ((c = getopt(argc, argv, "hn:v:s:r:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'n':
+	  nnames = atoi(optarg);
+	  break;
+	case 'v':
+	  nversions = atoi(optarg);
+	  break;
+	case 's':
+	  nspecsgen = atoi(optarg);
+	  break;
+	case 'r':
+	  rounds = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (nnames <= 0 || nversions <= 0 || rounds <= 0)
+    usage(1);
+  for (; optind < argc; optind++)
+    addspec(argv[optind]);
+  if (!nspecs)
+    genspecs(nspecsgen, nnames, nversions);
+  if (!nspecs)
+    usage(1);
+
+  pool = pool_create();
+  pool_setdisttype(pool, DISTTYPE_CONDA);
+  start = clock();
+  genpool(pool, nnames, nversions);
+  printf("%d packages, %d specs, created in %.3f seconds\n", pool->nsolvables - 2, nspecs, elapsed(start));
+
+  ids = solv_calloc(nspecs, sizeof(Id));
+  for (r = 0; r < rounds; r++)
+    {
+      /* start with empty provider lists in every round */
+      pool_createwhatprovides(pool);
+      start = clock();
+      for (i = 0; i < nspecs; i++)
+	ids[i] = pool_conda_matchspec(pool, specs[i]);
+      parsesecs += elapsed(start);
+      start = clock();
+      for (i = 0; i < nspecs; i++)
+	if (ids[i])
+	  FOR_PROVIDES(p, pp, ids[i])
+	    nproviders++;
+      resolvesecs += elapsed(start);
+    }
+  secs = parsesecs + resolvesecs;
+  printf("parse:   %.3f seconds\n", parsesecs);
+  printf("resolve: %.3f seconds, %llu providers\n", resolvesecs, nproviders / rounds);
+  printf("%.0f specs/s\n", secs > 0 ? nspecs * (double)rounds / secs : 0);
+  solv_free(ids);
+  for (i = 0; i < nspecs; i++)
+    solv_free((char *)specs[i]);
+  solv_free(specs);
+  pool_free(pool);
+  return 0;
+}
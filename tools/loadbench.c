@@ -0,0 +1,190 @@
+/*
+ * loadbench
+ *
+ * measure the time needed to load a big solv file. Creates a repository
+ * with dependencies, summaries and file lists, writes it to a temporary
+ * solv file and loads the file into new pools with stdio and with
+ * SOLV_ADD_MMAP. The loaded repositories must be identical.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+#include "util.h"
+
+static void
+genrepo(Pool *pool, int nnames, int nversions, int nrequires, int nfiles)
+{
+  Repo *repo = repo_create(pool, "bench");
+  Repodata *data = repo_add_repodata(repo, 0);
+  char buf[256];
+  Solvable *s;
+  Id p, did, *names, *evrs;
+  int i, v, j, n;
+
+  names = solv_calloc(nnames, sizeof(Id));
+  evrs = solv_calloc(nversions, sizeof(Id));
+  for (i = 0; i < nnames; i++)
+    {
+      snprintf(buf, sizeof(buf), "pkg%d", i);
+      names[i] = pool_str2id(pool, buf, 1);
+    }
+  for (v = 0; v < nversions; v++)
+    {
+      snprintf(buf, sizeof(buf), "%d.%d-1", v / 10 + 1, v % 10);
+      evrs[v] = pool_str2id(pool, buf, 1);
+    }
+  srand(42);
+  for (i = 0; i < nnames; i++)
+    for (v = 0; v < nversions; v++)
+      {
+	p = repo_add_solvable(repo);
+	s = pool->solvables + p;
+	s->name = names[i];
+	s->evr = evrs[v];
+	s->arch = ARCH_NOARCH;
+	s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+	for (j = 0; j < nrequires; j++)
+	  {
+	    n = rand() % nnames;
+	    if (n != i)
+	      s->requires = repo_addid_dep(repo, s->requires, pool_rel2id(pool, names[n], evrs[rand() % nversions], REL_GT | REL_EQ, 1), 0);
+	  }
+	snprintf(buf, sizeof(buf), "the package %d in version %d", i, v);
+	repodata_set_str(data, p, SOLVABLE_SUMMARY, buf);
+	repodata_set_num(data, p, SOLVABLE_INSTALLSIZE, 1000 + rand() % 100000);
+	for (j = 0; j < nfiles; j++)
+	  {
+	    snprintf(buf, sizeof(buf), "/usr/share/pkg%d/dir%d", i, j % 4);
+	    did = repodata_str2dir(data, buf, 1);
+	    snprintf(buf, sizeof(buf), "file%d", j);
+	    repodata_add_dirstr(data, p, SOLVABLE_FILELIST, did, buf);
+	  }
+      }
+  repo_internalize(repo);
+  solv_free(names);
+  solv_free(evrs);
+}
+
+/* load the solv file n times, write the last loaded repo to out */
+static double
+loadall(FILE *fp, int n, int flags, FILE *out)
+{
+  Pool *pool;
+  Repo *repo;
+  clock_t start;
+  double secs = 0;
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      pool = pool_create();
+      repo = repo_create(pool, "bench");
+      rewind(fp);
+      start = clock();
+      if (repo_add_solv(repo, fp, flags))
+	{
+	  fprintf(stderr, "loadbench: %s\n", pool_errstr(pool));
+	  exit(1);
+	}
+      secs += (clock() - start) / (double)CLOCKS_PER_SEC;
+      if (i == n - 1)
+	repo_write(repo, out);
+      pool_free(pool);
+    }
+  return secs;
+}
+
+static int
+samefiles(FILE *fp1, FILE *fp2)
+{
+  int c1, c2;
+
+  rewind(fp1);
+  rewind(fp2);
+  do
+    {
+      c1 = getc(fp1);
+      c2 = getc(fp2);
+    }
+  while (c1 == c2 && c1 != EOF);
+  return c1 == c2;
+}
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  loadbench [-n <names>] [-v <versions>] [-d <requires>] [-f <files>] [-l <loads>]\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  FILE *fp, *out1, *out2;
+  int c, nnames = 20000, nversions = 5, nrequires = 4, nfiles = 10, nloads = 5;
+  double secs1, secs2;
+
+  while ((c = getopt(argc, argv, "hn:v:d:f:l:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'n':
+	  nnames = atoi(optarg);
+	  break;
+	case 'v':
+	  nversions = atoi(optarg);
+	  break;
+	case 'd':
+	  nrequires = atoi(optarg);
+	  break;
+	case 'f':
+	  nfiles = atoi(optarg);
+	  break;
+	case 'l':
+	  nloads = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (nnames <= 1 || nversions <= 0 || nrequires < 0 || nfiles < 0 || nloads <= 0)
+    usage(1);
+
+  pool = pool_create();
+  genrepo(pool, nnames, nversions, nrequires, nfiles);
+  if ((fp = tmpfile()) == 0 || (out1 = tmpfile()) == 0 || (out2 = tmpfile()) == 0)
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  repo_write(pool->repos[1], fp);
+  fflush(fp);
+  printf("%d packages, solv file size %ld K\n", pool->nsolvables - 2, ftell(fp) / 1024);
+  pool_free(pool);
+
+  secs1 = loadall(fp, nloads, 0, out1);
+  secs2 = loadall(fp, nloads, SOLV_ADD_MMAP, out2);
+  printf("stdio: %8.3f ms per load\n", secs1 * 1000 / nloads);
+  printf("mmap:  %8.3f ms per load\n", secs2 * 1000 / nloads);
+  if (!samefiles(out1, out2))
+    printf("loaded repositories DIFFER\n");
+  else
+    printf("loaded repositories are identical\n");
+  fclose(out1);
+  fclose(out2);
+  fclose(fp);
+  return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * pagebench
+ *
+ * measure the file list lookups of a paged repository. Creates a
+ * repository with file lists and writes it once with compressed and
+ * once with uncompressed pages (REPOWRITER_NO_PAGE_COMPRESSION). Then
+ * the file lists of random packages are looked up with the default
+ * page cache, with a bigger page cache (POOL_FLAG_PAGECACHESIZE) and
+ * with the uncompressed pages mapped (SOLV_ADD_MMAP). The lookups with
+ * the default page cache are also done with lz4 compressed pages
+ * (REPOWRITER_LZ4_PAGE_COMPRESSION). The lookups must return the same
+ * data.
+ * Then all file list entries are visited by one dataiterator, this
+ * is a sequential scan that prefetches the pages if libsolv was built
+ * with ENABLE_THREADS. Finally all pages are loaded with
+ * repo_disable_paging and with repo_disable_paging_threaded using
+ * up to -t threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "repo_solv.h"
+#include "repo_write.h"
+#include "util.h"
+
+static void
+genrepo(Pool *pool, int npkgs, int nfiles)
+{
+  Repo *repo = repo_create(pool, "bench");
+  Repodata *data = repo_add_repodata(repo, 0);
+  char buf[256];
+  Solvable *s;
+  Id p, did;
+  int i, j;
+
+  srand(42);
+  for (i = 0; i < npkgs; i++)
+    {
+      p = repo_add_solvable(repo);
+      s = pool->solvables + p;
+      snprintf(buf, sizeof(buf), "pkg%d", i);
+      s->name = pool_str2id(pool, buf, 1);
+      s->evr = pool_str2id(pool, "1.0-1", 1);
+      s->arch = ARCH_NOARCH;
+      s->provides = repo_addid_dep(repo, s->provides, pool_rel2id(pool, s->name, s->evr, REL_EQ, 1), 0);
+      for (j = 0; j < nfiles; j++)
+	{
+	  snprintf(buf, sizeof(buf), "/usr/share/pkg%d/dir%d", i, j % 8);
+	  did = repodata_str2dir(data, buf, 1);
+	  snprintf(buf, sizeof(buf), "file%d_%d", j, rand() % 1000);
+	  repodata_add_dirstr(data, p, SOLVABLE_FILELIST, did, buf);
+	}
+    }
+  repo_internalize(repo);
+}
+
+static FILE *
+writerepo(Repo *repo, int flags)
+{
+  Repowriter *writer;
+  FILE *fp = tmpfile();
+
+  if (!fp)
+    {
+      perror("tmpfile");
+      exit(1);
+    }
+  writer = repowriter_create(repo);
+  repowriter_set_flags(writer, flags);
+  repowriter_write(writer, fp);
+  repowriter_free(writer);
+  fflush(fp);
+  return fp;
+}
+
+/* look up the file lists of random packages, return a checksum of the data */
+static unsigned int
+lookupall(FILE *fp, int addflags, int cachesize, int nlookups, double *secsp)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "bench");
+  Dataiterator di;
+  clock_t start;
+  unsigned int sum = 0;
+  int i;
+
+  pool_set_flag(pool, POOL_FLAG_PAGECACHESIZE, cachesize);
+  rewind(fp);
+  if (repo_add_solv(repo, fp, addflags))
+    {
+      fprintf(stderr, "pagebench: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  srand(4711);
+  start = clock();
+  for (i = 0; i < nlookups; i++)
+    {
+      Id p = repo->start + rand() % (repo->end - repo->start);
+      dataiterator_init(&di, pool, repo, p, SOLVABLE_FILELIST, 0, 0);
+      while (dataiterator_step(&di))
+	sum = sum * 31 + strlen(di.kv.str) + di.kv.id;
+      dataiterator_free(&di);
+    }
+  *secsp = (clock() - start) / (double)CLOCKS_PER_SEC;
+  pool_free(pool);
+  return sum;
+}
+
+/* visit all file list entries, return a checksum */
+static unsigned int
+scanall(FILE *fp, double *secsp)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "bench");
+  Dataiterator di;
+  unsigned int now, sum = 0;
+
+  rewind(fp);
+  if (repo_add_solv(repo, fp, 0))
+    {
+      fprintf(stderr, "pagebench: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  now = solv_timems(0);
+  dataiterator_init(&di, pool, repo, 0, SOLVABLE_FILELIST, 0, 0);
+  while (dataiterator_step(&di))
+    sum = sum * 31 + strlen(di.kv.str) + di.kv.id;
+  dataiterator_free(&di);
+  *secsp = solv_timems(now) / 1000.;
+  pool_free(pool);
+  return sum;
+}
+
+/* load all pages, return a checksum of all file lists */
+static unsigned int
+disableall(FILE *fp, int nthreads, double *secsp)
+{
+  Pool *pool = pool_create();
+  Repo *repo = repo_create(pool, "bench");
+  Dataiterator di;
+  unsigned int now, sum = 0;
+
+  rewind(fp);
+  if (repo_add_solv(repo, fp, 0))
+    {
+      fprintf(stderr, "pagebench: %s\n", pool_errstr(pool));
+      exit(1);
+    }
+  now = solv_timems(0);
+  if (nthreads > 1)
+    repo_disable_paging_threaded(repo, nthreads);
+  else
+    repo_disable_paging(repo);
+  *secsp = solv_timems(now) / 1000.;
+  dataiterator_init(&di, pool, repo, 0, SOLVABLE_FILELIST, 0, 0);
+  while (dataiterator_step(&di))
+    sum = sum * 31 + strlen(di.kv.str) + di.kv.id;
+  dataiterator_free(&di);
+  pool_free(pool);
+  return sum;
+}
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  pagebench [-p <packages>] [-f <files>] [-l <lookups>] [-c <cache size in K>] [-t <max threads>]\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  FILE *cfp, *ufp, *lfp;
+  int c, npkgs = 20000, nfiles = 50, nlookups = 100000, cachesize = 65536, maxthreads = 4, nthreads;
+  unsigned int sum1, sum2, sum3, sum4;
+  double secs1, secs2, secs3, secs4;
+
+  while ((c = getopt(argc, argv, "hp:f:l:c:t:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'p':
+	  npkgs = atoi(optarg);
+	  break;
+	case 'f':
+	  nfiles = atoi(optarg);
+	  break;
+	case 'l':
+	  nlookups = atoi(optarg);
+	  break;
+	case 'c':
+	  cachesize = atoi(optarg);
+	  break;
+	case 't':
+	  maxthreads = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (npkgs <= 0 || nfiles <= 0 || nlookups <= 0 || cachesize < 0 || maxthreads <= 0)
+    usage(1);
+
+  pool = pool_create();
+  genrepo(pool, npkgs, nfiles);
+  cfp = writerepo(pool->repos[1], 0);
+  ufp = writerepo(pool->repos[1], REPOWRITER_NO_PAGE_COMPRESSION);
+  lfp = writerepo(pool->repos[1], REPOWRITER_LZ4_PAGE_COMPRESSION);
+  printf("%d packages with %d files, solv file size %ld K compressed, %ld K uncompressed, %ld K lz4\n", npkgs, nfiles, ftell(cfp) / 1024, ftell(ufp) / 1024, ftell(lfp) / 1024);
+  pool_free(pool);
+
+  sum1 = lookupall(cfp, 0, 0, nlookups, &secs1);
+  sum2 = lookupall(cfp, 0, cachesize, nlookups, &secs2);
+  sum3 = lookupall(ufp, SOLV_ADD_MMAP, 0, nlookups, &secs3);
+  sum4 = lookupall(lfp, 0, 0, nlookups, &secs4);
+  printf("compressed, default cache:  %8.3f us per lookup\n", secs1 * 1000000 / nlookups);
+  printf("compressed, %6d K cache:   %8.3f us per lookup\n", cachesize, secs2 * 1000000 / nlookups);
+  printf("uncompressed, mapped:       %8.3f us per lookup\n", secs3 * 1000000 / nlookups);
+  printf("lz4, default cache:         %8.3f us per lookup\n", secs4 * 1000000 / nlookups);
+  if (sum1 != sum2 || sum1 != sum3 || sum1 != sum4)
+    printf("lookup results DIFFER\n");
+  else
+    printf("lookup results are identical\n");
+
+  sum2 = scanall(cfp, &secs2);
+  sum4 = scanall(lfp, &secs4);
+  printf("file list scan: %8.1f ms compressed, %8.1f ms lz4%s\n", secs2 * 1000, secs4 * 1000, sum2 != sum4 ? ", data DIFFERS" : "");
+
+  for (nthreads = 1; nthreads <= maxthreads; nthreads *= 2)
+    {
+      sum2 = disableall(cfp, nthreads, &secs2);
+      sum4 = disableall(lfp, nthreads, &secs4);
+      if (nthreads == 1)
+	sum1 = sum2;
+      printf("disable paging, %2d threads: %8.1f ms compressed, %8.1f ms lz4%s\n", nthreads, secs2 * 1000, secs4 * 1000,
+	     sum2 != sum1 || sum4 != sum1 ? ", data DIFFERS" : "");
+    }
+  fclose(cfp);
+  fclose(ufp);
+  fclose(lfp);
+  return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * portfoliobench
+ *
+ * measure portfolio solving. Creates a repository with many packages
+ * with versioned requires and conflicts, freezes the pool and solves
+ * a set of install jobs on a snapshot, without a portfolio and with
+ * a portfolio of some differently configured strategies using 1 and
+ * more threads (solver_set_nthreads). The portfolio results must not
+ * depend on the number of threads. The strategies only run in parallel
+ * if libsolv was built with ENABLE_THREADS.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+#include "transaction.h"
+#include "util.h"
+#include "benchpool.h"
+
+/* solve all jobs on a snapshot, put the problem counts and the
+ * transaction steps in res */
+static int
+solveall(Pool *pool, Queue *jobs, Queue *strategies, int budget, int nthreads, Queue *res)
+{
+  Pool *snap = pool_create_snapshot(pool);
+  Solver *solv;
+  Transaction *trans;
+  Queue job;
+  int i, j, now;
+
+  queue_init(&job);
+  queue_empty(res);
+  now = solv_timems(0);
+  for (i = 0; i < jobs->count; i = j + 1)
+    {
+      queue_empty(&job);
+      for (j = i; jobs->elements[j]; j++)
+	queue_push2(&job, SOLVER_INSTALL | SOLVER_SOLVABLE_NAME, jobs->elements[j]);
+      solv = solver_create(snap);
+      solver_set_nthreads(solv, nthreads);
+      if (strategies)
+	{
+	  solver_set_portfolio(solv, strategies);
+	  solver_set_budget(solv, SOLVER_BUDGET_PORTFOLIO, budget);
+	}
+      queue_push(res, solver_solve(solv, &job));
+      trans = solver_create_transaction(solv);
+      queue_insertn(res, res->count, trans->steps.count, trans->steps.elements);
+      transaction_free(trans);
+      solver_free(solv);
+    }
+  now = solv_timems(now);
+  queue_free(&job);
+  pool_free(snap);
+  return now;
+}
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  portfoliobench [-n <names>] [-v <versions>] [-d <requires>] [-j <jobs>] [-p <pkgs per job>] [-b <conflicts>] [-t <threads>]\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  Queue jobs, strategies, ref, res;
+  int c, i, j, ms, nnames = 1000, nversions = 10, nrequires = 4, njobs = 3, npkgs = 5, budget = 100, nthreads = 4;
+
+  while ((c = getopt(argc, argv, "hn:v:d:j:p:b:t:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'n':
+	  nnames = atoi(optarg);
+	  break;
+	case 'v':
+	  nversions = atoi(optarg);
+	  break;
+	case 'd':
+	  nrequires = atoi(optarg);
+	  break;
+	case 'j':
+	  njobs = atoi(optarg);
+	  break;
+	case 'p':
+	  npkgs = atoi(optarg);
+	  break;
+	case 'b':
+	  budget = atoi(optarg);
+	  break;
+	case 't':
+	  nthreads = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (nnames <= 1 || nversions <= 0 || nrequires < 0 || njobs <= 0 || npkgs <= 0 || budget <= 0 || nthreads <= 1)
+    usage(1);
+
+  pool = pool_create();
+  tool_genpool(pool, nnames, nversions, nrequires, BENCHPOOL_REQUIRES_GE_LT);
+  pool_addfileprovides(pool);
+  pool_createwhatprovides(pool);
+  pool_freeze(pool);
+  printf("%d packages, %d jobs with %d packages each\n", pool->nsolvables - 2, njobs, npkgs);
+
+  queue_init(&jobs);
+  srand(4711);
+  for (i = 0; i < njobs; i++)
+    {
+      char buf[64];
+      for (j = 0; j < npkgs; j++)
+	{
+	  snprintf(buf, sizeof(buf), "pkg%d", rand() % nnames);
+	  queue_push(&jobs, pool_str2id(pool, buf, 0));
+	}
+      queue_push(&jobs, 0);
+    }
+
+  /* the strategies next to the default one */
+  queue_init(&strategies);
+  queue_push2(&strategies, SOLVER_FLAG_FOCUS_BEST, 1);
+  queue_push(&strategies, 0);
+  queue_push2(&strategies, SOLVER_FLAG_WATCH_VECTORS, 1);
+  queue_push2(&strategies, SOLVER_FLAG_REDUCE_LEARNT, 1);
+  queue_push(&strategies, 0);
+  queue_push2(&strategies, SOLVER_FLAG_FOCUS_NEW, 1);
+  queue_push(&strategies, 0);
+
+  queue_init(&ref);
+  queue_init(&res);
+  ms = solveall(pool, &jobs, 0, budget, 1, &res);
+  printf("no portfolio:           %6d ms\n", ms);
+  ms = solveall(pool, &jobs, &strategies, budget, 1, &ref);
+  printf("portfolio, 1 thread:    %6d ms\n", ms);
+  ms = solveall(pool, &jobs, &strategies, budget, nthreads, &res);
+  printf("portfolio, %2d threads:  %6d ms\n", nthreads, ms);
+  if (res.count != ref.count || memcmp(res.elements, ref.elements, res.count * sizeof(Id)) != 0)
+    printf("portfolio results DIFFER\n");
+  else
+    printf("portfolio results are identical\n");
+  queue_free(&res);
+  queue_free(&ref);
+  queue_free(&strategies);
+  queue_free(&jobs);
+  pool_free(pool);
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * propagatebench
+ *
+ * compare the linked list watches with the watch vectors used with
+ * SOLVER_FLAG_WATCH_VECTORS. Creates a repository with many packages
+ * with versioned requires and conflicts and solves a set of install
+ * jobs with both watch schemes. The solver results must be identical.
+ * With -l both runs also delete learnt rules (SOLVER_FLAG_REDUCE_LEARNT).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+#include "transaction.h"
+#include "util.h"
+#include "benchpool.h"
+
+static double
+elapsed(clock_t start)
+{
+  return (clock() - start) / (double)CLOCKS_PER_SEC;
+}
+
+/* solve all jobs, put the transaction steps and the problem counts in res */
+static double
+solveall(Pool *pool, Queue *jobs, int watchvectors, int reducelearnt, Queue *res)
+{
+  Solver *solv;
+  Transaction *trans;
+  Queue job;
+  clock_t start;
+  double secs = 0;
+  int i, j;
+
+  queue_init(&job);
+  queue_empty(res);
+  for (i = 0; i < jobs->count; i = j + 1)
+    {
+      queue_empty(&job);
+      for (j = i; jobs->elements[j]; j++)
+	queue_push2(&job, SOLVER_INSTALL | SOLVER_SOLVABLE_NAME, jobs->elements[j]);
+      solv = solver_create(pool);
+      solver_set_flag(solv, SOLVER_FLAG_WATCH_VECTORS, watchvectors);
+      solver_set_flag(solv, SOLVER_FLAG_REDUCE_LEARNT, reducelearnt);
+      start = clock();
+      queue_push(res, solver_solve(solv, &job));
+      secs += elapsed(start);
+      trans = solver_create_transaction(solv);
+      queue_insertn(res, res->count, trans->steps.count, trans->steps.elements);
+      transaction_free(trans);
+      solver_free(solv);
+    }
+  queue_free(&job);
+  return secs;
+}
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  propagatebench [-l] [-n <names>] [-v <versions>] [-d <requires>] [-j <jobs>] [-p <pkgs per job>]\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  Queue jobs, res1, res2;
+  int c, i, j, nnames = 1000, nversions = 10, nrequires = 4, njobs = 3, npkgs = 5, reducelearnt = 0;
+  double secs1, secs2;
+
+  while ((c = getopt(argc, argv, "hln:v:d:j:p:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'l':
+	  reducelearnt = 1;
+	  break;
+	case 'n':
+	  nnames = atoi(optarg);
+	  break;
+	case 'v':
+	  nversions = atoi(optarg);
+	  break;
+	case 'd':
+	  nrequires = atoi(optarg);
+	  break;
+	case 'j':
+	  njobs = atoi(optarg);
+	  break;
+	case 'p':
+	  npkgs = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (nnames <= 1 || nversions <= 0 || nrequires < 0 || njobs <= 0 || npkgs <= 0)
+    usage(1);
+
+  pool = pool_create();
+  tool_genpool(pool, nnames, nversions, nrequires, BENCHPOOL_REQUIRES_GE_LT);
+  pool_addfileprovides(pool);
+  pool_createwhatprovides(pool);
+  printf("%d packages, %d jobs with %d packages each\n", pool->nsolvables - 2, njobs, npkgs);
+
+  queue_init(&jobs);
+  srand(4711);
+  for (i = 0; i < njobs; i++)
+    {
+      char buf[64];
+      for (j = 0; j < npkgs; j++)
+	{
+	  snprintf(buf, sizeof(buf), "pkg%d", rand() % nnames);
+	  queue_push(&jobs, pool_str2id(pool, buf, 1));
+	}
+      queue_push(&jobs, 0);
+    }
+
+  queue_init(&res1);
+  queue_init(&res2);
+  secs1 = solveall(pool, &jobs, 0, reducelearnt, &res1);
+  secs2 = solveall(pool, &jobs, 1, reducelearnt, &res2);
+  printf("linked lists:  %.3f seconds\n", secs1);
+  printf("watch vectors: %.3f seconds\n", secs2);
+  if (res1.count != res2.count || memcmp(res1.elements, res2.elements, res1.count * sizeof(Id)) != 0)
+    printf("results DIFFER\n");
+  else
+    printf("results are identical\n");
+  queue_free(&res1);
+  queue_free(&res2);
+  queue_free(&jobs);
+  pool_free(pool);
+  return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * resolvebench
+ *
+ * measure the per job latency when many similar jobs are solved
+ * against the same pool. Every job is a base set of install jobs
+ * with a few entries replaced by other installs or erases. The jobs
+ * are solved with a new solver for every job, with one reused solver
+ * (this keeps the pkg rules), and with one reused solver that also
+ * keeps the learnt rules (SOLVER_FLAG_KEEP_LEARNT).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+#include "transaction.h"
+#include "util.h"
+#include "benchpool.h"
+
+static double
+elapsed(clock_t start)
+{
+  return (clock() - start) / (double)CLOCKS_PER_SEC;
+}
+
+/* mode 0: new solver for every job, 1: reuse solver, 2: also keep learnt rules */
+static double
+solveall(Pool *pool, Queue *jobs, int mode, Queue *res)
+{
+  Solver *solv = 0;
+  Transaction *trans;
+  Queue job;
+  clock_t start;
+  double secs = 0;
+  int i, j;
+
+  queue_init(&job);
+  queue_empty(res);
+  for (i = 0; i < jobs->count; i = j + 1)
+    {
+      queue_empty(&job);
+      for (j = i; jobs->elements[j]; j += 2)
+	queue_push2(&job, jobs->elements[j], jobs->elements[j + 1]);
+      start = clock();
+      if (!solv)
+	{
+	  solv = solver_create(pool);
+	  solver_set_flag(solv, SOLVER_FLAG_KEEP_LEARNT, mode == 2);
+	}
+      queue_push(res, solver_solve(solv, &job));
+      secs += elapsed(start);
+      trans = solver_create_transaction(solv);
+      queue_push(res, trans->steps.count);
+      queue_insertn(res, res->count, trans->steps.count, trans->steps.elements);
+      transaction_free(trans);
+      if (!mode)
+	{
+	  solver_free(solv);
+	  solv = 0;
+	}
+    }
+  if (solv)
+    solver_free(solv);
+  queue_free(&job);
+  return secs;
+}
+
+/* count the jobs with the same result as in the reference run */
+static int
+countsame(Queue *ref, Queue *res, int *sameproblemsp)
+{
+  int i, j, n, same = 0, sameproblems = 0;
+
+  for (i = j = 0; i < ref->count && j < res->count; i += ref->elements[i + 1] + 2, j += n + 2)
+    {
+      n = res->elements[j + 1];
+      if (ref->elements[i] == res->elements[j])
+	sameproblems++;
+      if (ref->elements[i] == res->elements[j] && n == ref->elements[i + 1] && !memcmp(ref->elements + i + 2, res->elements + j + 2, n * sizeof(Id)))
+	same++;
+    }
+  *sameproblemsp = sameproblems;
+  return same;
+}
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  resolvebench [-n <names>] [-v <versions>] [-d <requires>] [-j <jobs>] [-p <pkgs per job>] [-c <changes per job>]\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  Queue base, jobs, res[3];
+  int c, i, j, k, nnames = 300, nversions = 10, nrequires = 2, njobs = 20, npkgs = 5, nchanges = 1;
+  double secs;
+  static const char *modes[3] = { "new solver", "reused solver", "keep learnt" };
+
+  while ((c = getopt(argc, argv, "hn:v:d:j:p:c:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'n':
+	  nnames = atoi(optarg);
+	  break;
+	case 'v':
+	  nversions = atoi(optarg);
+	  break;
+	case 'd':
+	  nrequires = atoi(optarg);
+	  break;
+	case 'j':
+	  njobs = atoi(optarg);
+	  break;
+	case 'p':
+	  npkgs = atoi(optarg);
+	  break;
+	case 'c':
+	  nchanges = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (nnames <= 1 || nversions <= 0 || nrequires < 0 || njobs <= 0 || npkgs <= 0 || nchanges < 0 || nchanges > npkgs)
+    usage(1);
+
+  pool = pool_create();
+  tool_genpool(pool, nnames, nversions, nrequires, BENCHPOOL_REQUIRES_GE_LT_SAT);
+  pool_addfileprovides(pool);
+  pool_createwhatprovides(pool);
+  printf("%d packages, %d jobs with %d packages each, %d changes per job\n", pool->nsolvables - 2, njobs, npkgs, nchanges);
+
+  /* the base job and its variants */
+  queue_init(&base);
+  queue_init(&jobs);
+  srand(4711);
+  for (i = 0; i < npkgs; i++)
+    {
+      char buf[64];
+      snprintf(buf, sizeof(buf), "pkg%d", rand() % nnames);
+      queue_push2(&base, SOLVER_INSTALL | SOLVER_SOLVABLE_NAME, pool_str2id(pool, buf, 1));
+    }
+  for (i = 0; i < njobs; i++)
+    {
+      k = jobs.count;
+      queue_insertn(&jobs, jobs.count, base.count, base.elements);
+      for (j = 0; j < nchanges; j++)
+	{
+	  char buf[64];
+	  Id *jp = jobs.elements + k + 2 * (rand() % npkgs);
+	  snprintf(buf, sizeof(buf), "pkg%d", rand() % nnames);
+	  jp[0] = (rand() % 4 ? SOLVER_INSTALL : SOLVER_ERASE) | SOLVER_SOLVABLE_NAME;
+	  jp[1] = pool_str2id(pool, buf, 1);
+	}
+      queue_push(&jobs, 0);
+    }
+
+  for (i = 0; i < 3; i++)
+    {
+      queue_init(&res[i]);
+      secs = solveall(pool, &jobs, i, &res[i]);
+      printf("%-14s %8.3f ms per job", modes[i], secs * 1000 / njobs);
+      if (!i)
+	{
+	  int nproblems = 0;
+	  for (j = 0; j < res[0].count; j += res[0].elements[j + 1] + 2)
+	    if (res[0].elements[j])
+	      nproblems++;
+	  printf(", %d jobs with problems", nproblems);
+	}
+      else
+	{
+	  int same, sameproblems;
+	  same = countsame(&res[0], &res[i], &sameproblems);
+	  printf(", same result as a new solver: %d transactions, %d problem counts", same, sameproblems);
+	}
+      printf("\n");
+    }
+  for (i = 0; i < 3; i++)
+    queue_free(&res[i]);
+  queue_free(&jobs);
+  queue_free(&base);
+  pool_free(pool);
+  return 0;
+}
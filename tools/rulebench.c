@@ -0,0 +1,123 @@
+/*
+ * rulebench
+ *
+ * measure the solve time with parallel pkg rule creation. Creates a
+ * big repository and an installed system with some of its packages,
+ * freezes the pool and solves the same install job with 1, 2, 4, ...
+ * worker threads (solver_set_nthreads). The results must be identical.
+ * The rule creation only uses threads if libsolv was built with
+ * ENABLE_THREADS.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "repo.h"
+#include "solver.h"
+#include "transaction.h"
+#include "util.h"
+#include "benchpool.h"
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  rulebench [-n <names>] [-v <versions>] [-d <requires>] [-i <installed names>] [-p <pkgs to install>] [-t <max threads>]\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  Pool *pool;
+  Repo *repo;
+  Solver *solv;
+  Transaction *trans;
+  Queue job, res, ref;
+  int c, i, nthreads, problems, now;
+  int nnames = 50000, nversions = 10, nrequires = 2, ninstalled = 5000, npkgs = 5, maxthreads = 8;
+
+  while ((c = getopt(argc, argv, "hn:v:d:i:p:t:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'n':
+	  nnames = atoi(optarg);
+	  break;
+	case 'v':
+	  nversions = atoi(optarg);
+	  break;
+	case 'd':
+	  nrequires = atoi(optarg);
+	  break;
+	case 'i':
+	  ninstalled = atoi(optarg);
+	  break;
+	case 'p':
+	  npkgs = atoi(optarg);
+	  break;
+	case 't':
+	  maxthreads = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (nnames <= 1 || nversions <= 0 || nrequires < 0 || ninstalled < 0 || ninstalled > nnames || npkgs <= 0 || maxthreads <= 0)
+    usage(1);
+
+  pool = pool_create();
+  repo = tool_genpool(pool, nnames, nversions, nrequires, BENCHPOOL_REQUIRES_GE);
+  tool_geninstalled(pool, repo, nversions, ninstalled);
+  pool_addfileprovides(pool);
+  pool_createwhatprovides(pool);
+  now = solv_timems(0);
+  pool_freeze(pool);
+  printf("%d packages, %d installed, freezing the pool took %d ms\n", pool->nsolvables - 2, ninstalled, solv_timems(now));
+
+  queue_init(&job);
+  srand(4711);
+  for (i = 0; i < npkgs; i++)
+    {
+      char buf[64];
+      snprintf(buf, sizeof(buf), "pkg%d", rand() % nnames);
+      queue_push2(&job, SOLVER_INSTALL | SOLVER_SOLVABLE_NAME, pool_str2id(pool, buf, 0));
+    }
+
+  queue_init(&res);
+  queue_init(&ref);
+  for (nthreads = 1; nthreads <= maxthreads; nthreads *= 2)
+    {
+      solv = solver_create(pool);
+      solver_set_nthreads(solv, nthreads);
+      now = solv_timems(0);
+      problems = solver_solve(solv, &job);
+      printf("%2d threads: %6d ms", nthreads, solv_timems(now));
+      trans = solver_create_transaction(solv);
+      queue_empty(&res);
+      queue_push(&res, problems);
+      queue_insertn(&res, res.count, trans->steps.count, trans->steps.elements);
+      transaction_free(trans);
+      solver_free(solv);
+      if (nthreads == 1)
+	{
+	  queue_insertn(&ref, 0, res.count, res.elements);
+	  printf(", %d problems, %d transaction steps\n", problems, res.count - 1);
+	}
+      else if (res.count != ref.count || memcmp(res.elements, ref.elements, res.count * sizeof(Id)) != 0)
+	printf(", result DIFFERS\n");
+      else
+	printf(", same result\n");
+    }
+  queue_free(&ref);
+  queue_free(&res);
+  queue_free(&job);
+  pool_free(pool);
+  return 0;
+}
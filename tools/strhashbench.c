@@ -0,0 +1,213 @@
+/*
+ * strhashbench
+ *
+ * compare the classic string hash with the word at a time hash
+ * used with ENABLE_FAST_STRINGHASH: hash throughput and the probe
+ * lengths of the string pool hash table. Also measures the speed of
+ * interning the strings into a string pool.
+ *
+ * The strings are read from stdin (one per line) or generated
+ * with the -g option.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pool.h"
+#include "util.h"
+#include "strpool.h"
+
+#ifdef ENABLE_FAST_STRINGHASH
+#define STRINGPOOL_HASH_NAME "word at a time hash with tags"
+#else
+#define STRINGPOOL_HASH_NAME "classic hash"
+#endif
+
+static const char **strs;
+static unsigned int *lens;
+static int nstrs;
+static unsigned long long totallen;
+
+static void
+addstr(const char *str, unsigned int len)
+{
+  char *s;
+  if (!len)
+    return;
+  strs = solv_extend(strs, nstrs, 1, sizeof(*strs), 4095);
+  lens = solv_extend(lens, nstrs, 1, sizeof(*lens), 4095);
+  s = solv_malloc(len + 1);
+  memcpy(s, str, len);
+  s[len] = 0;
+  strs[nstrs] = s;
+  lens[nstrs++] = len;
+  totallen += len;
+}
+
+static void
+readstrs(FILE *fp)
+{
+  char buf[4096];
+  while (fgets(buf, sizeof(buf), fp))
+    {
+      unsigned int l = strlen(buf);
+      if (l && buf[l - 1] == '\n')
+	buf[--l] = 0;
+      addstr(buf, l);
+    }
+}
+
+/* generate something that looks like package dependencies */
+static void
+genstrs(int num)
+{
+  static const char *prefixes[] = { "lib", "perl(", "python3-", "rubygem(", "/usr/lib64/", "pkgconfig(", "font(", "" };
+  static const char *suffixes[] = { "", "-devel", "-libs", ")", ".so.1()(64bit)", "-doc", "(x86-64)", "-common" };
+  char buf[256];
+  int i, l;
+
+  srand(42);
+  for (i = 0; i < num; i++)
+    {
+      l = snprintf(buf, sizeof(buf), "%s%c%c%x%s", prefixes[rand() % 8], 'a' + rand() % 26, 'a' + rand() % 26, rand() % (num + 1), suffixes[rand() % 8]);
+      addstr(buf, l);
+    }
+}
+
+static double
+elapsed(clock_t start)
+{
+  return (clock() - start) / (double)CLOCKS_PER_SEC;
+}
+
+static void
+bench_hash(const char *name, Hashval (*hash)(const char *, unsigned int))
+{
+  clock_t start;
+  Hashval x = 0, h, hh, hashmask;
+  Id *tbl;
+  unsigned long long probes = 0, collisions = 0;
+  unsigned int maxprobe = 0, p;
+  int i, loops;
+  double secs;
+
+  /* throughput */
+  loops = 1;
+  for (;;)
+    {
+      start = clock();
+      for (p = 0; p < (unsigned int)loops; p++)
+	for (i = 0; i < nstrs; i++)
+	  x += hash(strs[i], lens[i]);
+      secs = elapsed(start);
+      if (secs >= 0.5 || loops >= 1 << 20)
+	break;
+      loops *= 2;
+    }
+  printf("%s:\n", name);
+  printf("  throughput: %.1f MB/s, %.1f M hashes/s (%x)\n", totallen * loops / (1024 * 1024 * secs), nstrs * (double)loops / (1000000 * secs), x);
+
+  /* probe lengths of the string pool hash table */
+  hashmask = mkmask(nstrs);
+  tbl = solv_calloc(hashmask + 1, sizeof(Id));
+  for (i = 0; i < nstrs; i++)
+    {
+      h = hash(strs[i], lens[i]) & hashmask;
+      hh = HASHCHAIN_START;
+      p = 1;
+      while (tbl[h])
+	{
+	  h = HASHCHAIN_NEXT(h, hh, hashmask);
+	  p++;
+	}
+      tbl[h] = i + 1;
+      probes += p;
+      collisions += p - 1;
+      if (p > maxprobe)
+	maxprobe = p;
+    }
+  solv_free(tbl);
+  printf("  probes: %.3f average, %u max, %llu string compares on insert without tags\n", (double)probes / nstrs, maxprobe, collisions);
+}
+
+static Hashval
+hash_classic(const char *str, unsigned int len)
+{
+  return strnhash(str, len);
+}
+
+static Hashval
+hash_words(const char *str, unsigned int len)
+{
+  return strnhash_words(str, len);
+}
+
+static void
+bench_intern(void)
+{
+  Stringpool ss;
+  clock_t start;
+  int i;
+  double secs;
+
+  stringpool_init_empty(&ss);
+  start = clock();
+  for (i = 0; i < nstrs; i++)
+    stringpool_strn2id(&ss, strs[i], lens[i], 1);
+  secs = elapsed(start);
+  printf("stringpool (%s):\n", STRINGPOOL_HASH_NAME);
+  printf("  intern: %.3f seconds for %d strings, %d unique\n", secs, nstrs, ss.nstrings - 2);
+  start = clock();
+  for (i = 0; i < nstrs; i++)
+    if (!stringpool_strn2id(&ss, strs[i], lens[i], 0))
+      {
+	fprintf(stderr, "lookup of '%s' failed\n", strs[i]);
+	exit(1);
+      }
+  secs = elapsed(start);
+  printf("  lookup: %.3f seconds\n", secs);
+  stringpool_free(&ss);
+}
+
+static void
+usage(int status)
+{
+  fprintf(stderr, "Usage:\n  strhashbench [-g <num>] < strings\n");
+  exit(status);
+}
+
+int
+main(int argc, char **argv)
+{
+  int c, gen = 0;
+
+  while ((c = getopt(argc, argv, "hg:")) >= 0)
+    {
+      switch (c)
+	{
+	case 'h':
+	  usage(0);
+	  break;
+	case 'g':
+	  gen = atoi(optarg);
+	  break;
+	default:
+	  usage(1);
+	  break;
+	}
+    }
+  if (gen > 0)
+    genstrs(gen);
+  else
+    readstrs(stdin);
+  if (!nstrs)
+    usage(1);
+  printf("%d strings, %llu bytes\n", nstrs, totallen);
+  bench_hash("strnhash", hash_classic);
+  bench_hash("strnhash_words", hash_words);
+  bench_intern();
+  return 0;
+}
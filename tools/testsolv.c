@@ -40,6 +40,19 @@ usage(int ex)
   exit(ex);
 }
 
+/* free the solver and the snapshot it was solving on */
+static void
+free_solver(Pool *pool, Solver *solv)
+{
+  Pool *spool = solv->pool;
+  solver_free(solv);
+  if (spool != pool)
+    {
+      pool_free(spool);
+      pool_unfreeze(pool);
+    }
+}
+
 struct reportsolutiondata {
   int count;
   char *result;
@@ -294,7 +307,7 @@ main(int argc, char **argv)
 	    }
 	  if (reusesolv)
 	    {
-	      solver_free(solv);
+	      free_solver(pool, solv);
 	      solv = reusesolv;
 	      reusesolv = 0;
 	    }
@@ -521,10 +534,10 @@ main(int argc, char **argv)
 	  if ((resultflags & TESTCASE_RESULT_REUSE_SOLVER) != 0 && !feof(fp))
 	    reusesolv = solv;
 	  else
-	    solver_free(solv);
+	    free_solver(pool, solv);
 	}
       if (reusesolv)
-	solver_free(reusesolv);
+	free_solver(pool, reusesolv);
       free_considered(pool);
       pool_free(pool);
       fclose(fp);